@@ -0,0 +1,77 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file userfile2Binary.cc
+ */
+
+#include "BDSBunchBinaryFileFormat.hh"
+#include "BDSException.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[])
+{
+  if (argc < 4 || argc > 6)
+    {
+      std::cout << "usage: userfile2binary <inputFile> <distrFileFormat> <outputFile> [nlinesIgnore] [--float]" << std::endl;
+      std::cout << " <inputFile>       - ASCII (or .gz) file as used for the userfile distribution" << std::endl;
+      std::cout << " <distrFileFormat> - column format string, e.g. \"x[mm]:xp[mrad]:y[mm]:yp[mrad]:E[GeV]\"" << std::endl;
+      std::cout << " <outputFile>      - desired output binary file name" << std::endl;
+      std::cout << " [nlinesIgnore]    - (optional) number of lines to ignore at the start of the file" << std::endl;
+      std::cout << " [--float]         - (optional) store coordinates in single precision" << std::endl;
+      exit(1);
+    }
+
+  std::string inputFileName  = std::string(argv[1]);
+  std::string format         = std::string(argv[2]);
+  std::string outputFileName = std::string(argv[3]);
+  int  nlinesIgnore    = 0;
+  bool singlePrecision = false;
+  for (int i = 4; i < argc; i++)
+    {
+      std::string arg = std::string(argv[i]);
+      if (arg == "--float")
+        {singlePrecision = true;}
+      else
+        {
+          try
+            {nlinesIgnore = std::stoi(arg);}
+          catch (const std::exception&)
+            {
+              std::cout << "optional argument nlinesIgnore isn't an integer" << std::endl;
+              exit(1);
+            }
+        }
+    }
+
+  try
+    {
+      long nParticles = BDS::ConvertUserFileToBinaryBunchFile(inputFileName, format, outputFileName,
+                                                              nlinesIgnore, singlePrecision);
+      std::cout << "Wrote " << nParticles << " particles to " << outputFileName << std::endl;
+    }
+  catch (const BDSException& exception)
+    {
+      std::cerr << exception.what() << std::endl;
+      exit(1);
+    }
+  return 0;
+}
@@ -19,9 +19,13 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSARRAY4D_H
 #define BDSARRAY4D_H
 
+#include "BDSArrayLayoutType.hh"
+#include "BDSArrayStorageType.hh"
 #include "BDSFieldValue.hh"
 #include "BDSFourVector.hh"
 
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
 #include <vector>
 
@@ -43,6 +47,14 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
  * https://isocpp.org/wiki/faq/operator-overloading#matrix-subscript-op
  * 
  * The size cannot be changed after construction.
+ *
+ * Once filled, the values may be converted to a more compact storage type
+ * (see BDSArrayStorageType) to reduce memory usage for large arrays. In this
+ * case, values are decoded on access and can no longer be set.
+ *
+ * The values may also be rearranged into bricks of 4x4x4 points (see BDSArrayLayoutType)
+ * so that the points used for an interpolation are close together in memory. The
+ * bricks are padded at the upper edge of each dimension.
  * 
  * @author Laurie Nevay
  */
@@ -94,6 +106,18 @@ public:
   const BDSFieldValue& operator()(const BDSFourVector<G4int>& pos) const
   {return operator()(pos.x(), pos.y(), pos.z(), pos.t());}
 
+  /// Copy a cube of n x n x n values with the lowest indices (x,y,z) at index t into
+  /// the array out, ordered [x][y][z] as for the local data of the interpolators. Values
+  /// outside the array are the default value. This is much faster than GetConst for each
+  /// point as there's no virtual call or check of each index inside the array. Note, this
+  /// uses the values as stored and not any overridden GetConst in a derived class.
+  void ExtractCube(G4int x,
+                   G4int y,
+                   G4int z,
+                   G4int t,
+                   G4int n,
+                   BDSFieldValue* out) const;
+
   /// Return whether the indices are valid and lie within the array boundaries or not.
   virtual G4bool Outside(G4int x,
 			 G4int y,
@@ -106,6 +130,34 @@ public:
 			   G4int z,
 			   G4int t) const;
 
+  /// Rearrange the values in memory. Must be done before SetStorageType().
+  void SetLayout(BDSArrayLayoutType layoutIn);
+
+  /// Accessor for the layout of the values in memory.
+  inline BDSArrayLayoutType Layout() const {return layout;}
+
+  /// Convert the values to a more compact storage type. Once done, values cannot be set
+  /// and the original values are not kept. The maximum and root mean square absolute
+  /// difference of any component from the original values and the maximum absolute value of
+  /// any component over the points of the array (excluding any padding of the brick layout)
+  /// are returned by reference to report the accuracy. Throws an exception if
+  /// a value cannot be represented at all in the storage type or the array is already
+  /// converted.
+  void SetStorageType(BDSArrayStorageType storageTypeIn,
+                      G4double&           maxError,
+                      G4double&           rmsError,
+                      G4double&           maxValue);
+
+  /// Accessor for the storage type of the values.
+  inline BDSArrayStorageType StorageType() const {return storageType;}
+
+  /// Number of bytes used to store the values of the points of the array. This doesn't
+  /// include the padding of the brick layout - see PaddingMemoryUsage().
+  std::size_t MemoryUsage() const;
+
+  /// Number of bytes used by the padding of the brick layout.
+  std::size_t PaddingMemoryUsage() const;
+
   /// Virtual function is more flexible than plain operator<< for ostreaming as the derived
   /// function may use the base class part of the print out first or in a different way.
   /// The operator<< for ostream uses this function.
@@ -127,8 +179,43 @@ protected:
   BDSFieldValue defaultValue;
   
 private:
+  /// Index in the 1D array of the given indices for the current layout. Assumes
+  /// the indices are valid.
+  inline std::size_t Index(G4int x, G4int y, G4int z, G4int t) const
+  {
+    if (!bricked)
+      {return (std::size_t)t*nZ*nY*nX + (std::size_t)z*nY*nX + (std::size_t)y*nX + (std::size_t)x;}
+    std::size_t brick = (((std::size_t)t*nZBricks + (std::size_t)(z >> brickShiftZ))*nYBricks
+                         + (std::size_t)(y >> brickShiftY))*nXBricks + (std::size_t)(x >> brickShiftX);
+    std::size_t inBrick = (((std::size_t)(z & brickMaskZ) << brickShiftY) + (std::size_t)(y & brickMaskY)) << brickShiftX;
+    return (brick << brickShift) + inBrick + (std::size_t)(x & brickMaskX);
+  }
+
+  /// Decode a converted value at a given index in the 1D array.
+  BDSFieldValue Decode(std::size_t index) const;
+
   /// A 1D array representing all the data.
   std::vector<BDSFieldValue> data;
+
+  /// @{ Converted data - 3 values per point and 3 scale factors per block when quantised.
+  BDSArrayStorageType   storageType;
+  std::vector<uint16_t> compactData;
+  std::vector<G4float>  blockScales;
+  /// @}
+
+  /// Number of consecutive points in the 1D array sharing a scale factor when quantised.
+  static const std::size_t quantisationBlockSize = 64;
+
+  /// The decoded value for converted data so it can be returned by reference.
+  mutable BDSFieldValue returnValue;
+
+  /// @{ Brick layout - bricks are 4 points long in each spatial dimension with more than 1 point.
+  BDSArrayLayoutType layout;
+  G4bool bricked;
+  G4int  brickShiftX, brickShiftY, brickShiftZ, brickShift;
+  G4int  brickMaskX,  brickMaskY,  brickMaskZ;
+  G4int  nXBricks,    nYBricks,    nZBricks;
+  /// @}
 };
 
 #endif
@@ -0,0 +1,48 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSARRAYLAYOUTTYPE_H
+#define BDSARRAYLAYOUTTYPE_H
+
+#include "BDSTypeSafeEnum.hh"
+#include "globals.hh" // geant4 types / globals
+
+/**
+ * @brief Type definition for the order of field map array values in memory.
+ *
+ * linear is x fastest then y, z and t. brick groups the values into bricks of
+ * 4x4x4 points in x, y and z that are each contiguous in memory, so neighbouring
+ * points in any spatial dimension are usually close in memory.
+ *
+ * @author Laurie Nevay
+ */
+
+struct arraylayouttypes_def
+{
+  enum type {linear, brick};
+};
+
+typedef BDSTypeSafeEnum<arraylayouttypes_def,int> BDSArrayLayoutType;
+
+namespace BDS
+{
+  /// Function that gives corresponding enum value for string (case-insensitive).
+  BDSArrayLayoutType DetermineArrayLayoutType(G4String layoutType);
+}
+
+#endif
@@ -0,0 +1,48 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSARRAYSTORAGETYPE_H
+#define BDSARRAYSTORAGETYPE_H
+
+#include "BDSTypeSafeEnum.hh"
+#include "globals.hh" // geant4 types / globals
+
+/**
+ * @brief Type definition for how field map array values are stored in memory.
+ *
+ * full is the precision of BDSFieldValue. half and bfloat16 are 16 bit floating
+ * point numbers. quantised16 is a 16 bit integer per component with a scale factor
+ * per component for each block of values.
+ *
+ * @author Laurie Nevay
+ */
+
+struct arraystoragetypes_def
+{
+  enum type {full, half, bfloat16, quantised16};
+};
+
+typedef BDSTypeSafeEnum<arraystoragetypes_def,int> BDSArrayStorageType;
+
+namespace BDS
+{
+  /// Function that gives corresponding enum value for string (case-insensitive).
+  BDSArrayStorageType DetermineArrayStorageType(G4String storageType);
+}
+
+#endif
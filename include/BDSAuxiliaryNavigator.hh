@@ -27,8 +27,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Transform3D.hh"
 
+class BDSBeamline;
 class BDSStep;
 class G4Step;
+class G4VSolid;
 class G4VPhysicalVolume;
 
 /**
@@ -69,16 +71,25 @@ public:
 
   /// Setup the navigator w.r.t. to a world volume - typically real world.
   static void AttachWorldVolumeToNavigator(G4VPhysicalVolume* worldPVIn)
-  {auxNavigator->SetWorldVolume(worldPVIn); worldPV = worldPVIn;}
+  {auxNavigator->SetWorldVolume(worldPVIn); worldPV = worldPVIn; geometryGeneration++;}
 
   /// Setup the navigator w.r.t. to the read out world / geometry to provide
   /// curvilinear coordinates.
   static void AttachWorldVolumeToNavigatorCL(G4VPhysicalVolume* curvilinearWorldPVIn)
-  {auxNavigatorCL->SetWorldVolume(curvilinearWorldPVIn); curvilinearWorldPV = curvilinearWorldPVIn;}
+  {auxNavigatorCL->SetWorldVolume(curvilinearWorldPVIn); curvilinearWorldPV = curvilinearWorldPVIn; geometryGeneration++;}
 
   static void RegisterCurvilinearBridgeWorld(G4VPhysicalVolume* curvilinearBridgeWorldPVIn)
-  {auxNavigatorCLB->SetWorldVolume(curvilinearBridgeWorldPVIn); curvilinearBridgeWorldPV = curvilinearBridgeWorldPVIn;}
+  {auxNavigatorCLB->SetWorldVolume(curvilinearBridgeWorldPVIn); curvilinearBridgeWorldPV = curvilinearBridgeWorldPVIn; geometryGeneration++;}
 
+  /// Register the beam line placed in the curvilinear world. If it has a placement
+  /// table (see BDSBeamline::BuildPlacementTable), curvilinear transforms are found
+  /// from it without navigating and the navigator is only used for points on a
+  /// surface or in a gap between volumes. Not owned by this class.
+  static void RegisterCurvilinearBeamline(const BDSBeamline* curvilinearBeamlineIn)
+  {curvilinearBeamline = curvilinearBeamlineIn; geometryGeneration++;}
+
+  /// Reset the static navigators. This also invalidates the cached volume and transform
+  /// in every instance.
   static void ResetNavigatorStates();
 
   /// A wrapper for the underlying static navigator instance located within this class.
@@ -223,6 +234,25 @@ protected:
   mutable G4AffineTransform globalToLocalCL;
   mutable G4AffineTransform localToGlobalCL;
   mutable G4bool            bridgeVolumeWasUsed;
+
+  /// The last volume found in either world and its transforms. Repeated look ups for points
+  /// strictly inside this volume reuse the transforms without navigating - typical of many
+  /// steps and field queries in the same element. Only volumes without daughters that
+  /// aren't replicated are cached, so being inside the solid guarantees the navigator would
+  /// find the same volume and transform.
+  struct FrameCache
+  {
+    G4VPhysicalVolume* volume = nullptr;
+    const G4VSolid*    solid  = nullptr;
+    G4AffineTransform  globalToLocal;
+    G4AffineTransform  localToGlobal;
+    G4long             generation = -1;
+  };
+  mutable FrameCache frameCache;   ///< Mass world.
+  mutable FrameCache frameCacheCL; ///< Curvilinear world.
+
+  /// Row of the curvilinear beam line placement table last found - the search starts there.
+  mutable G4int placementTableHint;
   
   /// Navigator object for safe navigation in the real (mass) world without
   /// affecting tracking of the particle.
@@ -247,6 +277,23 @@ private:
   const G4AffineTransform& LocalToGlobal(G4bool curvilinear) const;
   /// @}
 
+  /// If the point is strictly inside the cached volume for the selected world, set the
+  /// transforms from the cache and return the volume. Otherwise, return nullptr.
+  G4VPhysicalVolume* FindInCache(const G4ThreeVector& globalPoint,
+                                 G4bool curvilinear) const;
+
+  /// Find the volume and set the transforms without navigating - using the cache or, for
+  /// the curvilinear world, the placement table of the curvilinear beam line. Returns
+  /// nullptr if the navigator must be used.
+  G4VPhysicalVolume* FindWithoutNavigator(const G4ThreeVector& globalPoint,
+                                          G4bool curvilinear) const;
+
+  /// Cache the volume and the current transforms for the selected world if the volume is
+  /// suitable (see FrameCache).
+  void UpdateCache(G4VPhysicalVolume* volume,
+                   G4bool curvilinear,
+                   G4bool fromBridgeWorld) const;
+
   void InitialiseTransform(const G4bool massworld        = true,
                            const G4bool curvilinearWorld = true) const;
   
@@ -269,12 +316,19 @@ private:
   /// Counter to keep track of when the last instance of the class is deleted
   /// and therefore when the navigators can be safely deleted without affecting
   static G4int numberOfInstances;
+
+  /// Incremented whenever the navigators are reset or the geometry changes so that the
+  /// caches of all instances are invalidated.
+  static G4long geometryGeneration;
   
   /// @{ Cache of world PV to test if we're getting the wrong volume for the transform.
   static G4VPhysicalVolume* worldPV;
   static G4VPhysicalVolume* curvilinearWorldPV;
   static G4VPhysicalVolume* curvilinearBridgeWorldPV;
   /// @}
+
+  /// Beam line placed in the curvilinear world used for navigator-free look ups.
+  static const BDSBeamline* curvilinearBeamline;
   
   /// Margin by which to advance the point along the step direction if the
   /// world volume is found for transforms. This is in an attempt to find a
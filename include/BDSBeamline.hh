@@ -20,6 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSBEAMLINE_H
 
 #include "globals.hh" // geant4 globals / types
+#include "G4AffineTransform.hh"
 #include "G4ThreeVector.hh"
 #include "G4Transform3D.hh"
 
@@ -38,6 +39,7 @@ class BDSSamplerInfo;
 class BDSSimpleComponent;
 class BDSTiltOffset;
 class BDSTransform3D;
+class G4VSolid;
 namespace CLHEP {
   class HepRotation;
 }
@@ -246,6 +248,30 @@ public:
 
   /// Return indices in order of ecol, rcol, jcol and crystalcol elements.
   std::vector<G4int> GetIndicesOfCollimators() const;
+
+  /// Prepare a table of the placed volume of each element for FindPlacedElement. Must
+  /// be called after the beam line has been placed in a world (see BDSBeamlineElement::
+  /// SetPlacedVolume). Only elements with a single placed volume without daughters and
+  /// placed directly in a world are included. The extent of each volume along the global
+  /// axis the beam line spans most is sorted into an index for searching. Any previous
+  /// table is replaced.
+  void BuildPlacementTable();
+
+  /// Find the element whose placed volume strictly contains a global point and get the
+  /// transforms to and from its local frame without using a navigator. These are the
+  /// same as the navigator would give as the volumes don't have daughters. The search
+  /// starts at the table row in hint (and its neighbours) and the row found is written
+  /// back to it, so successive nearby points are quick. Otherwise, the sorted extent index
+  /// is binary searched for the volumes that may contain the point. Returns nullptr if the point
+  /// isn't strictly inside any volume in the table - e.g. on a surface or in a gap -
+  /// in which case the navigator should be used.
+  const BDSBeamlineElement* FindPlacedElement(const G4ThreeVector& globalPoint,
+                                              G4int&               hint,
+                                              G4AffineTransform&   globalToLocal,
+                                              G4AffineTransform&   localToGlobal) const;
+
+  /// Whether BuildPlacementTable has found any volumes.
+  G4bool HasPlacementTable() const {return !placedElements.empty();}
   
 private:
   /// Add a single component and calculate its position and rotation with respect
@@ -296,6 +322,32 @@ private:
   /// index for the beamline element in the main BDSBeamlineVector element.
   /// This is filled in order so it's sorted by design.
   std::vector<G4double> sEnd;
+
+  /// Whether a global point is strictly inside the placed volume of a row of the
+  /// placement table.
+  G4bool PlacedVolumeContains(std::size_t row, const G4ThreeVector& globalPoint) const;
+
+  /// @{ Placement table built by BuildPlacementTable. Each row is one placed volume.
+  /// The bounding sphere of each volume is stored as separate arrays.
+  std::vector<const BDSBeamlineElement*> placedElements;
+  std::vector<const G4VSolid*>           placedSolids;
+  std::vector<G4AffineTransform>         placedGlobalToLocal;
+  std::vector<G4AffineTransform>         placedLocalToGlobal;
+  std::vector<G4double>                  placedCentreX;
+  std::vector<G4double>                  placedCentreY;
+  std::vector<G4double>                  placedCentreZ;
+  std::vector<G4double>                  placedRadiusSq;
+  /// @}
+
+  /// @{ Index of the placement table sorted by the minimum extent of each bounding sphere
+  /// along sortAxis (0,1,2 for x,y,z). sortedMaxSoFar is the running maximum of the maximum
+  /// extent so a search backwards from a point may stop as soon as it's below the point.
+  G4int                 sortAxis;
+  std::vector<G4int>    sortedRows;
+  std::vector<G4double> sortedMin;
+  std::vector<G4double> sortedMax;
+  std::vector<G4double> sortedMaxSoFar;
+  /// @}
 };
 
 #endif
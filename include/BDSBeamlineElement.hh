@@ -139,8 +139,13 @@ public:
   inline G4Transform3D*    GetSamplerPlacementTransform() const {return samplerPlacementTransform;}
   inline G4int             GetIndex()                     const {return index;}
   inline G4String          GetMaterial()                  const {return component->Material();}
+  inline G4VPhysicalVolume* GetPlacedVolume()             const {return placedVolume;}
   ///@}
 
+  /// Record the single physical volume made when this element was placed. Not used
+  /// for assemblies as there is more than one volume.
+  inline void SetPlacedVolume(G4VPhysicalVolume* placedVolumeIn) {placedVolume = placedVolumeIn;}
+
   /// Create a global extent object from the extent of the component.
   BDSExtentGlobal GetExtentGlobal() const;
 
@@ -246,6 +251,10 @@ private:
 
   /// Index of this item in the beamline - saves keeping track of iterators and conversion.
   G4int index;
+
+  /// The physical volume of the placement of this element if there is only one (i.e. not
+  /// an assembly). Not owned by this class. Default is nullptr until placed.
+  G4VPhysicalVolume* placedVolume;
 };
 
 #endif
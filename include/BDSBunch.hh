@@ -28,7 +28,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh"
 #include "G4Transform3D.hh"
 
+#include <vector>
+
 class BDSBeamline;
+class BDSParticleCoordsBatch;
 
 namespace GMAD
 {
@@ -86,6 +89,19 @@ public:
   /// number of attempts (maxTries) is exceeded.
   virtual BDSParticleCoordsFullGlobal GetNextParticleValid(G4int maxTries = 100);
 
+  /// Append nParticles valid particles to particles. This gives exactly the same particles
+  /// as calling GetNextParticleValid() nParticles times. If CanGenerateInBatches() is true,
+  /// the local coordinates are generated many at once with GetNextParticlesLocal().
+  void GetNextParticlesValid(G4int nParticles,
+                             std::vector<BDSParticleCoordsFullGlobal>& particles,
+                             G4int maxTries = 100);
+
+  /// Whether generating local coordinates with GetNextParticlesLocal() and then applying
+  /// the tilt, transform and energy check gives exactly the same particles as repeated
+  /// calls to GetNextParticleValid(). This is true for any distribution that is a
+  /// simple sequence of particles of one type.
+  virtual G4bool CanGenerateInBatches() const {return !ExpectChangingParticleType();}
+
   /// An action that is called at the beginning of a run when we know the number of
   /// events that'll be generated. By default this is nothing, but can be used to
   /// calculate sample mean offsets in some derived classes.
@@ -105,6 +121,12 @@ public:
   /// z0 will be treated as S and the global z0 be calculated.
   virtual BDSParticleCoordsFull GetNextParticleLocal();
 
+  /// Append nParticles sets of local coordinates to batch. Equivalent to calling
+  /// GetNextParticleLocal() nParticles times, which is what this default does, but
+  /// derived classes may generate them all at once more efficiently.
+  virtual void GetNextParticlesLocal(G4int nParticles,
+                                     BDSParticleCoordsBatch& batch);
+
   /// Access whether there's a finite S offset and therefore we're using a CL transform.
   G4bool UseCurvilinearTransform() const {return useCurvilinear;}
 
@@ -147,6 +169,9 @@ public:
   /// Get the current bunch index for writing to output.
   inline G4int CurrentBunchIndex() const {return currentBunchIndex;}
 
+  /// Whether a time offset is applied to each particle according to the current bunch index.
+  inline G4bool UseBunchTiming() const {return useBunchTiming;}
+
   /// Calculate which bunch index we should be at given an event index.
   void CalculateBunchIndex(G4int eventIndex);
 
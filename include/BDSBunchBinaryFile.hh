@@ -0,0 +1,122 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSBUNCHBINARYFILE_H
+#define BDSBUNCHBINARYFILE_H
+
+#include "BDSBunchFileBased.hh"
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <cstddef>
+#include <cstdint>
+
+class BDSParticleCoordsFull;
+class BDSParticleCoordsFullGlobal;
+
+/**
+ * @brief A bunch distribution that reads a binary columnar file.
+ *
+ * The file format is described in BDSBunchBinaryFileFormat.hh. The file is memory
+ * mapped read only and read sequentially, so there is no parsing per event and
+ * the operating system page cache may be shared between many jobs reading the
+ * same file. Skipping, looping and advancing to an event for recreation are simply
+ * a change of index. The same column names as the userfile distribution are
+ * supported and coordinates are treated identically.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSBunchBinaryFile: public BDSBunchFileBased
+{
+public:
+  BDSBunchBinaryFile();
+  virtual ~BDSBunchBinaryFile();
+  /// @{ Assignment and copy constructor not implemented nor used
+  BDSBunchBinaryFile& operator=(const BDSBunchBinaryFile&) = delete;
+  BDSBunchBinaryFile(BDSBunchBinaryFile&) = delete;
+  /// @}
+
+  virtual void SetOptions(const BDSParticleDefinition* beamParticle,
+                          const GMAD::Beam& beam,
+                          const BDSBunchType& distrType,
+                          G4Transform3D beamlineTransformIn = G4Transform3D::Identity,
+                          const G4double beamlineS = 0);
+  virtual void CheckParameters();
+
+  /// Map the file and check the number of events requested is consistent.
+  virtual void Initialise();
+
+  /// Advance to the correct entry for recreation - simply an index change.
+  virtual void RecreateAdvanceToEvent(G4int eventOffset);
+
+  /// As with the userfile distribution, one entry is one event.
+  virtual BDSParticleCoordsFullGlobal GetNextParticleValid(G4int maxTries);
+
+  virtual G4bool DistributionIsFinished() const {return endOfFileReached;}
+
+  /// Get the next particle.
+  virtual BDSParticleCoordsFull GetNextParticleLocal();
+
+  virtual G4bool ExpectChangingParticleType() const {return changingParticleType;}
+
+private:
+  /// Open and memory map the file then check the header.
+  void MapFile();
+  void UnmapFile();
+
+  /// Match the columns in the file to the coordinates we use.
+  void ParseColumns();
+
+  /// Return to the first entry after nlinesSkip or throw an exception if looping isn't allowed.
+  void EndOfFileAction();
+
+  /// A view of one column in the mapped file.
+  struct Column
+  {
+    const char* data;  ///< Pointer into the mapped file - nullptr if the column isn't present.
+    uint32_t dataType; ///< BDSBunchBinaryFileColumn::type.
+    G4double unit;     ///< Unit from the file multiplied by the Geant4 unit.
+  };
+
+  /// Read a value from a column at the current index. Returns defaultValue if the column isn't present.
+  G4double Value(const Column& column, G4double defaultValue = 0) const;
+
+  G4String distrFile;     ///< Bunch file.
+  G4String distrFilePath; ///< Bunch file including absolute path.
+  G4long   nlinesSkip;    ///< Number of entries to skip at the start of the file.
+  G4bool   matchDistrFileLength;
+  G4double ffact;         ///< Cache of flip factor from global constants.
+
+  int         fileDescriptor;
+  const char* mappedData;
+  std::size_t mappedSize;
+  uint64_t    nParticles;
+  uint64_t    currentIndex;
+
+  G4bool endOfFileReached;
+  G4bool anEnergyCoordinateInUse;
+  G4bool changingParticleType;
+
+  /// @{ Columns.
+  Column x, y, z, xp, yp, zp, t, S, E, Ek, P, pdgid, weight;
+  /// @}
+};
+
+#endif
@@ -0,0 +1,86 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSBUNCHBINARYFILEFORMAT_H
+#define BDSBUNCHBINARYFILEFORMAT_H
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <cstdint>
+
+/**
+ * @brief On-disk layout of a binary columnar bunch file.
+ *
+ * The file starts with a BDSBunchBinaryFileHeader followed by nColumns
+ * BDSBunchBinaryFileColumn descriptions. The data for each column is then a
+ * contiguous array of nParticles values of the column type starting at the
+ * byte offset given in the column description (aligned to 8 bytes). Values
+ * are stored in native (little) endian byte order. Each value is multiplied
+ * by the column unit to give a value in GeV, m, rad or s, exactly as the units
+ * in the userfile distribution format.
+ *
+ * Column names are the same as the tokens of the userfile distrFileFormat
+ * without units: "x", "y", "z", "xp", "yp", "zp", "t", "S", "E", "Ek", "P",
+ * "pdgid" and "w".
+ *
+ * @author Laurie Nevay
+ */
+
+struct BDSBunchBinaryFileHeader
+{
+  char     magic[8];   ///< Always "BDSBUNCH" without a null terminator.
+  uint32_t version;    ///< Format version.
+  uint32_t nColumns;   ///< Number of columns.
+  uint64_t nParticles; ///< Number of entries in every column.
+};
+
+struct BDSBunchBinaryFileColumn
+{
+  /// Type of the data for this column.
+  enum type : uint32_t {float64 = 0, float32 = 1, int32 = 2};
+
+  char     name[16]; ///< Column name (null terminated).
+  uint32_t dataType; ///< One of the type enum values.
+  uint32_t padding;  ///< Unused - for alignment.
+  double   unit;     ///< Factor to convert to GeV, m, rad or s.
+  uint64_t offset;   ///< Byte offset of the column data from the start of the file.
+};
+
+namespace BDS
+{
+  /// Current version of the binary bunch file format.
+  const uint32_t bunchBinaryFileVersion = 1;
+
+  /// Size in bytes of a value of the given column type.
+  std::size_t BunchBinaryFileTypeSize(uint32_t dataType);
+
+  /// Convert an ASCII file in the userfile distribution format to the binary columnar
+  /// format. The format string is the same as the distrFileFormat beam parameter and
+  /// nlinesIgnore lines are ignored at the start of the file. Empty and comment lines
+  /// are skipped as in the userfile distribution. Optionally, floating point columns can
+  /// be stored in single precision. Returns the number of particles written. Throws a
+  /// BDSException if anything goes wrong.
+  G4long ConvertUserFileToBinaryBunchFile(const G4String& inputFileName,
+                                          const G4String& distrFileFormat,
+                                          const G4String& outputFileName,
+                                          G4int           nlinesIgnore = 0,
+                                          G4bool          singlePrecision = false);
+}
+
+#endif
@@ -61,6 +61,17 @@ public:
 			G4double kineticEnergy,
 			G4int    pdgID);
 
+  /// As AcceptParticle but without the kinetic energy cut, which requires the mass
+  /// from a particle definition. This doesn't use the Geant4 particle table so it may
+  /// be used from another thread as long as PrepareParticleFilter() has been called.
+  G4bool AcceptParticleCoordinates(const BDSParticleCoordsFull& coords,
+				   G4double rpOriginal,
+				   G4int    pdgID) const;
+
+  /// Parse the accepted particle IDs if not done already. Only to be used once the
+  /// particle table is initialised.
+  void PrepareParticleFilter();
+
   /// Get a rotation matrix according to Xp0 and Yp0.
   G4RotationMatrix ReferenceBeamMomentumOffset() const;
   
@@ -72,6 +83,7 @@ protected:
 
   /// @{ Cache of limit.
   G4int    eventGeneratorNEventsSkip;
+  G4int    eventGeneratorPrefetchNEvents;
   G4double eventGeneratorMinX;
   G4double eventGeneratorMaxX;
   G4double eventGeneratorMinY;
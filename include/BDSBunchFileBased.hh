@@ -49,6 +49,9 @@ public:
   virtual void BeginOfRunAction(G4int numberOfEvents,
                                 G4bool batchMode);
 
+  /// File based distributions may loop or skip entries when getting a valid particle.
+  virtual G4bool CanGenerateInBatches() const {return false;}
+
   /// @{ Accessor.
   unsigned long long int NOriginalEvents() const {return nOriginalEvents;}
   unsigned long long int NEventsInFile() const {return nEventsInFile;}
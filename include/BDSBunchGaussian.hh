@@ -20,6 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSBUNCHGAUSSIAN_H 
 
 #include "BDSBunch.hh"
+#include "BDSParticleCoordsBatch.hh"
 
 #include "globals.hh"
 #include "G4Transform3D.hh"
@@ -27,6 +28,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "CLHEP/Matrix/SymMatrix.h"
 #include "CLHEP/Matrix/Vector.h"
 
+#include <cstddef>
 #include <vector>
 
 namespace CLHEP
@@ -67,6 +69,10 @@ public:
   /// Either draw from the vector of already created points or fire fresh
   /// from the matrix.
   virtual BDSParticleCoordsFull GetNextParticleLocal();
+
+  /// Either copy from the already created points or fire many at once.
+  virtual void GetNextParticlesLocal(G4int nParticles,
+                                     BDSParticleCoordsBatch& batch);
   
 protected:
   /// Create multidimensional Gaussian random number generator
@@ -81,6 +87,15 @@ protected:
   /// Fire random number generator and get coordinates. Can be overloaded if required.
   virtual BDSParticleCoordsFull GetNextParticleLocalCoords();
 
+  /// Append nParticles coordinates to batch. This uses the same random numbers and
+  /// transformation as RandMultiGauss but draws all the normal deviates first and
+  /// then transforms them a whole coordinate at a time.
+  virtual void GetNextParticlesLocalCoords(G4int nParticles,
+                                           BDSParticleCoordsBatch& batch);
+
+  /// Polar Box-Muller method as in CLHEP::RandMultiGauss.
+  G4double NormalDeviate();
+
   CLHEP::HepVector    meansGM;
   CLHEP::HepSymMatrix sigmaGM;
 
@@ -89,13 +104,21 @@ protected:
   
   G4bool offsetSampleMean; ///< Whether to offset the sample mean.
 
-  /// @{ Holder for pre-calculated coordinates.
-  std::vector<G4double> x0_v, xp_v, y0_v, yp_v, z0_v, zp_v,E_v,t_v,weight_v;
+  /// @{ Eigen decomposition of the sigma matrix used by gaussMultiGen for batch generation.
+  CLHEP::HepRandomEngine* gaussEngine;
+  G4double gaussMu[6];
+  G4double gaussU[6][6];
+  G4double gaussSigmas[6];
+  G4bool   gaussHaveNextNormal;
+  G4double gaussNextNormal;
   /// @}
-  G4int iPartIteration; ///< Iterator for reading out pre-calculate coordinates
 
-  /// Convenience vector of vectors for clearing up.
-  std::vector<std::vector<G4double>* > coordinates;
+  /// Holder for pre-calculated coordinates.
+  BDSParticleCoordsBatch preGenerated;
+  std::size_t iPartIteration; ///< Iterator for reading out pre-calculate coordinates
+
+  /// Workspace for normal deviates in batch generation - kept to avoid reallocation.
+  std::vector<G4double> normals;
 };
 
 #endif
@@ -79,6 +79,10 @@ private:
   G4double haloPSWeightParameter;
   G4String weightFunction;
 
+  /// Weight function decoded once from the string so it's not compared for every particle.
+  enum class WeightFunction {flat, oneoverr, oneoverrsqrd, exp};
+  WeightFunction weightFunctionType;
+
   G4double emitInnerX;
   G4double emitInnerY;
   G4double emitOuterX;
@@ -20,11 +20,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSBUNCHSIXTRACKLINK_H 
 
 #include "BDSBunch.hh"
-#include "BDSParticleExternal.hh"
+#include "BDSIMLinkCAPI.hh"
+#include "BDSParticleCoordsFull.hh"
 
+#include "G4Types.hh"
+
+#include <array>
+#include <map>
 #include <vector>
 
-class BDSParticleCoordsFull;
 class BDSParticleDefinition;
 
 /**
@@ -35,6 +39,11 @@ class BDSParticleDefinition;
  * to aid memory management (avoid double deletion) we have a member in this class
  * for the current particle definition that is updated each time. The accessor is
  * overloaded to access that one instead of the base class one.
+ *
+ * Particles are stored by value in one contiguous vector that keeps its capacity
+ * when cleared. Particles added with AddParticles share one particle definition
+ * per species that is kept for the lifetime of the bunch, so adding a bunch this
+ * way makes no heap allocation per particle.
  * 
  * @author Laurie Nevay
  */
@@ -54,6 +63,10 @@ public:
 		   int   externalParticleID,
 		   int   externalParentID);
 
+  /// Append all particles from a set of arrays in SixTrack units (m, rad, GeV, s). Throws
+  /// an exception if a particle species can't be found. Returns the number of particles added.
+  G4int AddParticles(const BDSLinkParticlesIn& particlesIn);
+
   /// Delete all particle objects in the bunch and clear the vector.
   void ClearParticles();
 
@@ -73,12 +86,30 @@ public:
   virtual void UpdateIonDefinition();
   
 private:
+  /// A particle in the bunch. The particle definition is not owned.
+  struct Particle
+  {
+    BDSParticleDefinition* particleDefinition;
+    BDSParticleCoordsFull  coords;
+    G4int                  externalParticleID;
+    G4int                  externalParentID;
+  };
+
+  /// Get (constructing if required) the shared particle definition for a species.
+  BDSParticleDefinition* SpeciesDefinition(G4int pdgID, G4int Z, G4int A, G4int charge);
+
   G4int currentIndex;
   G4int currentExternalParticleID;
   G4int currentExternalParentID;
   BDSParticleDefinition* currentParticleDefinition;
 
   G4int size;         ///< Number of particles (1 counting).
-  std::vector<BDSParticleExternal*> particles;
+  std::vector<Particle> particles;
+
+  /// Definitions given to AddParticle - deleted when the bunch is cleared.
+  std::vector<BDSParticleDefinition*> ownedDefinitions;
+
+  /// Shared definitions by species {pdgID, Z, A, charge} - kept until destruction.
+  std::map<std::array<G4int,4>, BDSParticleDefinition*> speciesDefinitions;
 };
 #endif
@@ -22,11 +22,13 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSBunchFileBased.hh"
 
 #include <fstream>
+#include <ios>
 #include <list>
 #include <regex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #ifdef USE_GZSTREAM
 #include "src-external/gzstream/gzstream.h"
@@ -37,6 +39,13 @@ class BDSParticleCoordsFullGlobal;
 
 /**
  * @brief A bunch distribution that reads a user specified column file.
+ *
+ * The file is read once at the start to count the number of valid lines. At the
+ * same time, a sparse index of the byte offset of every indexStride'th valid line
+ * is built. Skipping lines, looping the file and advancing to an event offset for
+ * recreation are then a seek to the nearest index entry followed by reading at most
+ * indexStride lines. Optionally, this index can be written to a sidecar file next
+ * to the distribution file so that it isn't rebuilt on the next run with the same file.
  * 
  * @author Lawrence Deacon
  */
@@ -54,10 +63,8 @@ public:
 			  const G4double beamlineS = 0);
   virtual void CheckParameters();
 
-  /// Advance to the correct event number in the file for recreation. The implementation
-  /// is brute-force getting of the lines - this could be more efficient (certainly for
-  /// a file that is looped over multiple times) but this is simple, clear and the time
-  /// penalty is on the order of 1 minute for ~100k events.
+  /// Advance to the correct event number in the file for recreation. This uses the
+  /// index of valid lines built when the file was first counted.
   virtual void RecreateAdvanceToEvent(G4int eventOffset);
 
   /// Override base class method to find valid particle over rest mass. For a bunch file
@@ -82,11 +89,59 @@ private:
   G4long   nlinesSkip;    ///< Number of lines that will be skipped after the nlinesIgnore.
   G4long   nLinesValidData;
   G4double particleMass;  ///< Cache of nominal beam particle mass.
-  G4int    lineCounter;   ///< Line counter.
+  G4long   lineCounter;   ///< Line counter.
   G4bool   printedOutFirstTime;    ///< Whether we've printed out opening the file the first time.
   G4bool   anEnergyCoordinateInUse;///< Whether Et, Ek or P are in the columns.
   G4bool   changingParticleType;   ///< Whether the particle type is a column.
   G4bool   endOfFileReached;
+  G4bool   useIndexFile;           ///< Whether to read / write a sidecar index file.
+
+  /// An entry in the sparse index of valid lines in the file.
+  struct IndexEntry
+  {
+    std::streamoff offset;     ///< Byte offset of the start of the line in the (uncompressed) file.
+    G4long         lineNumber; ///< Line number (counting from 0) including all lines.
+  };
+  
+  /// Every indexStride'th valid line (after nlinesIgnore) is recorded in the index.
+  static const G4long indexStride;
+  std::vector<IndexEntry> lineIndex;
+  std::streamoff currentOffset; ///< Byte offset of the current read position in the file.
+  G4long validLineCounter;      ///< Index of the next valid line to be read.
+  std::string bufferedLine;     ///< A line already read from the file but not yet used.
+  G4bool haveBufferedLine;      ///< Whether bufferedLine should be returned by the next ReadLine.
+
+  /// Read one line from the file and keep track of the byte offset and line number. If a
+  /// line has been read ahead by SeekToValidLine, that is returned first.
+  G4bool ReadLine(std::string& line);
+
+  /// Whether there are no more lines to read including any buffered line.
+  G4bool NoMoreLines() const;
+
+  /// Position the file at the start of valid line number iValidLine (counting from 0 after
+  /// nlinesIgnore). Uses the index to jump to the nearest entry and reads forward from there.
+  /// If the target is ahead of the current position, the file is only read forward. The first
+  /// valid line found is kept in a buffer rather than seeking back to its start, as seeking
+  /// backwards in a compressed file means decompressing it again from the beginning.
+  void SeekToValidLine(G4long iValidLine);
+
+  /// Position the underlying stream at a byte offset. For a plain file, this is a seek. For
+  /// a stream that doesn't support seeking (e.g. gzip), the stream is read forward (reopening
+  /// if required) without parsing lines.
+  void SeekToByte(std::streamoff offset);
+
+  /// @{ Load or write the sidecar index file. Load returns false if the file doesn't exist
+  /// or doesn't match the current distribution file or settings.
+  G4bool LoadIndexFile();
+  void   WriteIndexFile() const;
+  /// @}
+
+  /// Name of the sidecar index file.
+  G4String IndexFileName() const {return distrFilePath + ".bdsimindex";}
+
+  /// A cheap signature of the distribution file (size and modification time) used to
+  /// validate a sidecar index file.
+  std::string FileSignature() const;
 
   void ParseFileFormat(); ///< Parse the column tokens and units factors
   void OpenBunchFile();   ///< Open the file and check it's open.
@@ -101,16 +156,14 @@ private:
   
   void CloseBunchFile();  ///< Close the file handler
 
-  /// Read a word out of the string stream, in effect advancing the internal
-  /// string stream iterator.
-  void skip(std::stringstream& stream, G4int nvalues);
-
   /// The file handler. Templated as could be std::ifstream or igzstream for example.
   T InputBunchFile;
 
-  /// Read a word into a value. Templated so we can cleverly use different types
-  /// to read into directly such as int or double.
-  template <typename Type> void ReadValue(std::stringstream& stream, Type& value);
+  /// @{ Read the next white space delimited number from a line into a value. The pointer
+  /// is advanced past the number. Returns false if no number could be read.
+  G4bool ReadValue(const char*& p, const char* end, G4double& value) const;
+  G4bool ReadValue(const char*& p, const char* end, G4int& value) const;
+  /// @}
 
   /// Struct for name and unit pair.
   struct Doublet {
@@ -120,20 +173,11 @@ private:
 
   /// List of variables to parse on each line.
   std::list<Doublet> fields;
-  
-  /// Return true if a line is all whitespace or is commented out (starts with '#').
-  G4bool SkippableLine(const std::string& line) const;
-
-  /// Check conflicting columns aren't specified in file, e.g. P and Ek. Throw exception if wrong.
-  void CheckConflictingParameters(const std::set<G4String>& s) const;
-
-  template <typename U>
-  void CheckAndParseUnits(const G4String& name, const G4String& rest, U unitParser);
 
   /// Open the file, skip the nlinesIgnore, then count the number of valid lines in the file.
   /// A valid line is one that can be used for coordinates, so empty lines or commented lines
   /// are ignored from this count. This number should be the number of particle coordinate sets
-  /// we can read from the file.
+  /// we can read from the file. The index of valid lines is built at the same time.
   G4long CountNLinesValidDataInFile();
   
   /// Open the file and skip lines.
@@ -144,18 +188,44 @@ private:
   void EndOfFileAction();
 
   G4double ffact; ///< Cache of flip factor from global constants.
-  std::regex comment;
   G4bool   matchDistrFileLength;
 };
 
 namespace BDS
 {
-  /// @{ Utility function to parse variable and unit string.  These
-  /// are meant for passing to CheckAndParseUnits.
+  /// A column of a userfile distribution format with its unit factor relative to GeV,
+  /// m, rad or s. The names are "E", "Ek", "P", "t", "x", "y", "z", "xp", "yp", "zp",
+  /// "S", "pdgid", "weight" and "skip" for a column to be ignored ("-").
+  struct UserFileColumn
+  {
+    G4String name;
+    G4double unit;
+  };
+
+  /// Split a userfile distribution format string (e.g. "x[mm]:xp[mrad]:E[GeV]") into
+  /// columns. Throws a BDSException if a token or unit can't be parsed or if conflicting
+  /// columns are given (more than one of E, Ek and P, or both z and S) in any order.
+  std::vector<UserFileColumn> ParseUserFileFormat(const G4String& format);
+
+  /// Return true if a line of a userfile distribution is all whitespace or is commented
+  /// out (starts with '#' or contains '!').
+  G4bool SkippableUserFileLine(const std::string& line);
+
+  /// @{ Utility function to parse variable and unit string.
   G4double ParseEnergyUnit(const G4String& fmt);
   G4double ParseLengthUnit(const G4String& fmt);
   G4double ParseAngleUnit(const G4String& fmt);
   G4double ParseTimeUnit(const G4String& fmt);
   /// @}
+
+  /// Parse a floating point number starting at p, skipping any leading white space, and
+  /// advance p past it. This doesn't depend on the locale and is considerably faster than
+  /// a string stream. Numbers that can't be represented exactly by the fast path are
+  /// passed to strtod so the result is always identical to a conventional parse. Returns
+  /// false if no number could be read.
+  G4bool ParseDouble(const char*& p, const char* end, G4double& value);
+
+  /// As ParseDouble but for a (signed) integer.
+  G4bool ParseLong(const char*& p, const char* end, long long& value);
 }
 #endif
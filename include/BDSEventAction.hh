@@ -32,6 +32,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <string>
 #include <vector>
 
+class BDSEventBudget;
+class BDSEventProfiler;
 class BDSEventInfo;
 class BDSOutput;
 class BDSTrajectoriesToStore;
@@ -73,6 +75,12 @@ public:
   /// has already been constructed.
   inline void SetPrintModulo(G4int printModuloIn) {printModulo = printModuloIn;}
 
+  /// Set the (optional) per-event budget that is reset at the start of each event. Not owned.
+  inline void SetEventBudget(BDSEventBudget* eventBudgetIn) {eventBudget = eventBudgetIn;}
+
+  /// Set the (optional) profiler that is reset at the start of each event. Not owned.
+  inline void SetEventProfiler(BDSEventProfiler* eventProfilerIn) {eventProfiler = eventProfilerIn;}
+
 protected:
   /// Sift through all trajectories (if any) and mark for storage.
   BDSTrajectoriesToStore* IdentifyTrajectoriesForStorage(const G4Event* evt,
@@ -82,6 +90,10 @@ protected:
 							 const std::vector<BDSHitsCollectionSampler*>& allSamplerHits,
 							 G4int nChar = 50) const;
 
+  /// Write the seed state at the start of a truncated event to a file so the event
+  /// can be reprocessed later with the seedStateFileName option.
+  void WriteTruncatedEventSeedState(G4int eventIndex) const;
+
   /// Recursively (using this function) mark each parent trajectory as true - to be stored,
   /// and also flag the bitset for 'connect' as true.
   void ConnectTrajectory(std::map<BDSTrajectory*, bool>& interestingTraj,
@@ -152,6 +164,9 @@ private:
   BDSEventInfo* eventInfo;
 
   long long int nTracks; ///< Accumulated number of tracks for the event.
+
+  BDSEventBudget*   eventBudget;   ///< Optional per-event budget. Not owned.
+  BDSEventProfiler* eventProfiler; ///< Optional per-event profiler. Not owned.
   
   /// Cache of primary trajectories as constructed. Do this as a map because
   /// the primary trajectory may be update and appended (merged) at some point
@@ -0,0 +1,77 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSEVENTBUDGET_H
+#define BDSEVENTBUDGET_H
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <ctime>
+
+/**
+ * @brief A budget of steps and CPU time for each event.
+ *
+ * Every step is counted and the CPU time used by the event is checked every
+ * cpuTimeCheckInterval steps to keep the overhead small. Once either limit is
+ * exceeded the event is marked as truncated until the start of the next event.
+ * A limit of 0 or less means no limit.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSEventBudget
+{
+public:
+  BDSEventBudget(G4long   maximumStepsIn,
+                 G4double maximumCPUTimeIn);
+  ~BDSEventBudget(){;}
+
+  /// Reset the counters and start the CPU clock for a new event.
+  void BeginEvent();
+
+  /// Count a step. Returns true only for the step that exceeds the budget.
+  G4bool Step();
+
+  /// Whether the budget has been exceeded this event.
+  inline G4bool Truncated() const {return truncated;}
+
+  /// Description of which limit was exceeded this event.
+  G4String Reason() const;
+
+  /// Whether any limit is set.
+  inline G4bool Active() const {return maximumSteps > 0 || maximumCPUTime > 0;}
+
+  /// Number of steps between checks of the CPU time.
+  static const G4long cpuTimeCheckInterval = 1000;
+
+private:
+  BDSEventBudget() = delete;
+
+  /// CPU time used by the event so far in seconds.
+  G4double CPUTimeThisEvent() const;
+
+  G4long   maximumSteps;
+  G4double maximumCPUTime; ///< In seconds.
+  G4long   nSteps;
+  G4bool   truncated;
+  G4bool   exceededCPUTime;
+  std::clock_t cpuStartTime;
+};
+
+#endif
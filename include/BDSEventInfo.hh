@@ -54,6 +54,7 @@ public:
   inline void SetSeedStateAtStart(const G4String& seedStateAtStartIn) {info->seedStateAtStart = (std::string)seedStateAtStartIn;}
   inline void SetIndex(G4int indexIn)                   {info->index     = (int)indexIn;}
   inline void SetAborted(G4bool abortedIn)              {info->aborted   = (bool)abortedIn;}
+  inline void SetTruncated(G4bool truncatedIn)          {info->truncated = (bool)truncatedIn;}
   inline void SetPrimaryHitMachine(G4bool hitIn)        {info->primaryHitMachine = (bool)hitIn;}
   inline void SetMemoryUsage(G4double memoryUsageMbIn)  {info->memoryUsageMb = (double)memoryUsageMbIn;}
   inline void SetPrimaryAbsorbedInCollimator(G4bool absorbed) {info->primaryAbsorbedInCollimator = absorbed;}
@@ -0,0 +1,124 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSEVENTPROFILER_H
+#define BDSEVENTPROFILER_H
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <chrono>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+class BDSPhysicalVolumeInfoRegistry;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4Step;
+class G4VPhysicalVolume;
+
+/**
+ * @brief Break down the time taken by each event by beam line element, logical
+ * volume and particle species.
+ *
+ * Every step is counted in each category. The time is only measured for one in every
+ * timingSampleInterval steps (the wall time until the next step) and scaled by the
+ * interval, so the per-step overhead is a counter increment and a few cached lookups.
+ * The bins for logical volumes and particles are made for everything defined at
+ * construction, so this should be constructed after the geometry and physics. Ions
+ * made afterwards are counted together in an "ions" bin.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSEventProfiler
+{
+public:
+  BDSEventProfiler();
+  ~BDSEventProfiler(){;}
+
+  /// Steps and (sampled) time in seconds in each bin of one category for the current event.
+  struct Tally
+  {
+    std::vector<G4double> steps;
+    std::vector<G4double> time;
+  };
+
+  /// Reset the tallies for a new event.
+  void BeginEvent();
+
+  /// Count a step and attribute the time of a sample if one is in progress.
+  void Step(const G4Step* step);
+
+  /// @{ Accessor.
+  inline const Tally& PerElement()  const {return perElement;}
+  inline const Tally& PerVolume()   const {return perVolume;}
+  inline const Tally& PerParticle() const {return perParticle;}
+  inline const std::vector<G4String>& ElementNames()  const {return elementNames;}
+  inline const std::vector<G4String>& VolumeNames()   const {return volumeNames;}
+  inline const std::vector<G4String>& ParticleNames() const {return particleNames;}
+  /// @}
+
+  /// Number of steps between timing samples.
+  static const G4int timingSampleInterval = 100;
+
+private:
+  /// Update the cached bins for a new pre-step point volume.
+  void UpdateVolume(G4VPhysicalVolume* pv);
+
+  /// Update the cached bin for a new particle species.
+  void UpdateParticle(const G4ParticleDefinition* particle);
+
+  /// Add a step and time to a bin if it's valid (>= 0).
+  static void Add(Tally& tally, G4int bin, G4double time);
+
+  /// Make a tally with nBins empty bins.
+  static Tally MakeTally(std::size_t nBins);
+
+  /// Zero all the bins of a tally.
+  static void Reset(Tally& tally);
+
+  std::vector<G4String> elementNames;
+  std::vector<G4String> volumeNames;
+  std::vector<G4String> particleNames;
+  std::unordered_map<const G4LogicalVolume*, G4int>      volumeBins;
+  std::unordered_map<const G4ParticleDefinition*, G4int> particleBins;
+  G4int ionsBin;
+  G4int otherParticlesBin;
+
+  Tally perElement;
+  Tally perVolume;
+  Tally perParticle;
+
+  BDSPhysicalVolumeInfoRegistry* pvInfoRegistry; ///< Cache of singleton.
+
+  /// @{ Cache of the last volume and particle seen as consecutive steps are mostly the same.
+  G4VPhysicalVolume*          lastVolume;
+  G4int                       lastElementBin;
+  G4int                       lastVolumeBin;
+  const G4ParticleDefinition* lastParticle;
+  G4int                       lastParticleBin;
+  /// @}
+
+  G4int  stepsSinceSample;
+  G4bool sampling;
+  std::chrono::steady_clock::time_point sampleStartTime;
+};
+
+#endif
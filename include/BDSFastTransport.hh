@@ -0,0 +1,150 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFASTTRANSPORT_H
+#define BDSFASTTRANSPORT_H
+
+#include "BDSBeamPipeType.hh"
+
+#include "G4RotationMatrix.hh"
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+
+#include <cstddef>
+#include <vector>
+
+class BDSBeamline;
+class BDSBeamlineElement;
+class BDSParticleCoordsFullGlobal;
+class BDSParticleDefinition;
+
+/**
+ * @brief Transport many primaries together through the vacuum at the start of a beam line.
+ *
+ * From the start of the beam line, consecutive straight elements that are either a
+ * drift without a field, or a quadrupole or solenoid tracked with the BDSIM thick lens
+ * integrator, form an analytic section. These must use the default vacuum material, have
+ * no tilt, offset, modulator or vacuum biasing and have a circular, elliptical, rectangular,
+ * lhc or rectellipse aperture. The section ends at the first element that isn't like this
+ * or that has a sampler attached so no sampler output is changed.
+ *
+ * The particles are stored as one array per coordinate and advanced element by element
+ * in steps of at most maximumStepLength with the same matrices as BDSIntegratorQuadrupole
+ * and BDSIntegratorSolenoid. A particle that leaves the aperture, or would use the backup
+ * integrator or be below the minimum radius of curvature in an element, is handed back at
+ * the start of that element so Geant4 tracks the whole element. Otherwise it is handed back
+ * at the end of the section.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSFastTransport
+{
+public:
+  explicit BDSFastTransport(const BDSBeamline* beamline);
+  ~BDSFastTransport(){;}
+
+  /// Number of elements in the analytic section.
+  inline G4int NElements() const {return (G4int)elements.size();}
+
+  /// Length of the analytic section.
+  inline G4double Length() const {return length;}
+
+  /// Replace the global coordinates of each particle by those where it should be handed
+  /// to Geant4. Only particles that start at the beginning of the beam line (local z and
+  /// S of 0) are moved. The local coordinates, which are used for the primary output,
+  /// are unchanged.
+  void Transport(std::vector<BDSParticleCoordsFullGlobal>& particles,
+                 const BDSParticleDefinition*              particleDefinition) const;
+
+  /// Maximum step through a magnet between aperture checks.
+  static const G4double maximumStepLength;
+
+  /// The aperture is reduced by this for the check of whether a particle is inside it.
+  static const G4double apertureMargin;
+
+private:
+  BDSFastTransport() = delete;
+
+  /// Motion in an element.
+  enum class Kind {drift, quadrupole, solenoid};
+
+  /// Everything required to transport through one element.
+  struct Element
+  {
+    Kind             kind;
+    G4int            beamlineIndex;
+    G4double         chordLength;
+    G4int            nSteps;
+    G4double         strength;      ///< B' for a quadrupole or B for a solenoid as in the integrators.
+    BDSBeamPipeType  apertureType;
+    G4double         aper1, aper2, aper3, aper4;
+    G4double         aperOffsetX, aperOffsetY;
+    G4ThreeVector    positionStart;
+    G4RotationMatrix rotationStart;
+  };
+
+  /// Particles being transported stored as one array per coordinate. Positions and
+  /// unit momenta are in the curvilinear frame of the current element.
+  struct State
+  {
+    void Resize(std::size_t n);
+    /// Copy particle i to index j.
+    void Move(std::size_t i, std::size_t j);
+    /// Copy the index and coordinates (not the particle constants) from another state.
+    void CopyCoordinates(const State& other);
+
+    std::vector<std::size_t> index; ///< Index in the vector of particles.
+    std::vector<G4double> x, y, xp, yp, zp, T;
+    std::vector<G4double> fcofOverP;     ///< As G4Mag_EqRhs::FCof() divided by the momentum.
+    std::vector<G4double> inverseVelocity;
+    std::vector<G4int>    ok;            ///< Whether the particle may continue in this element.
+  };
+
+  /// Fill an element description if the beam line element is suitable. Returns false if not.
+  G4bool Analytic(const BDSBeamlineElement* beamlineElement,
+                  Element&                  element) const;
+
+  /// @{ Advance all particles by a step of dz along the element axis.
+  void AdvanceDrift(State& s, std::size_t n, G4double dz) const;
+  void AdvanceQuadrupole(State& s, std::size_t n, G4double dz, G4double bPrime) const;
+  void AdvanceSolenoid(State& s, std::size_t n, G4double dz, G4double bField) const;
+  /// @}
+
+  /// Mark any particle outside the aperture of the element as not ok.
+  void CheckAperture(State& s, std::size_t n, const Element& element) const;
+
+  /// Write the coordinates of particle i in the state to the global coordinates of the
+  /// particle it came from using a reference position and rotation.
+  void HandBack(const State&                              s,
+                std::size_t                               i,
+                const G4ThreeVector&                      position,
+                const G4RotationMatrix&                   rotation,
+                G4int                                     beamlineIndex,
+                std::vector<BDSParticleCoordsFullGlobal>& particles) const;
+
+  std::vector<Element> elements;
+  G4double         length;
+  G4ThreeVector    positionEnd;   ///< Reference position at the end of the section.
+  G4RotationMatrix rotationEnd;   ///< Reference rotation at the end of the section.
+  G4int            beamlineIndexEnd;
+  G4double         backupStepperMomLimit;
+  G4double         minimumRadiusOfCurvature;
+};
+
+#endif
@@ -42,7 +42,8 @@ class BDSFieldEMMuonCooler: public BDSFieldEM
 public:
   BDSFieldEMMuonCooler() = delete;
   BDSFieldEMMuonCooler(const BDSFieldInfoExtraMuonCooler* info,
-                       G4double brho);
+                       G4double brho,
+                       G4double specialFunctionToleranceIn = 0);
   virtual ~BDSFieldEMMuonCooler();
 
   virtual void BuildMagnets(const BDSFieldInfoExtraMuonCooler* info);
@@ -58,6 +59,7 @@ private:
   BDSFieldMag* dipoleField;
   BDSFieldEM* rfField;
   std::vector< std::pair<G4ThreeVector, BDSFieldEM*> > rfFieldVector;
+  G4double specialFunctionTolerance; ///< Tolerance for tabulated special functions in the fields - 0 for exact.
 };
 
 #endif
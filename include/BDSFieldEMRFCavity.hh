@@ -28,10 +28,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 class BDSCavityInfo;
 class BDSMagnetStrength;
+class BDSSpecialFunctionTable;
 
 /**
  * @brief Pill box cavity electromagnetic field.
  *
+ * If a finite specialFunctionTolerance is given, the Bessel functions are
+ * interpolated from shared tables with that maximum absolute error rather
+ * than evaluated exactly.
+ *
  * @author Stuart Walker
  */
 
@@ -39,13 +44,15 @@ class BDSFieldEMRFCavity: public BDSFieldEM
 {
 public:
   BDSFieldEMRFCavity() = delete;
-  explicit BDSFieldEMRFCavity(BDSMagnetStrength const* strength);
+  explicit BDSFieldEMRFCavity(BDSMagnetStrength const* strength,
+                              G4double specialFunctionTolerance = 0);
   
   BDSFieldEMRFCavity(G4double eFieldAmplitude,
                      G4double frequency,
                      G4double phaseOffset,
                      G4double cavityRadius,
-                     G4double synchronousTIn);
+                     G4double synchronousTIn,
+                     G4double specialFunctionTolerance = 0);
   
   virtual ~BDSFieldEMRFCavity(){;}
 
@@ -71,6 +78,11 @@ private:
   static const G4double Z0; ///< Impedance of free space.
   const G4double normalisedCavityRadius; ///< Pre-calculated normalised calculated radius w.r.t. bessel first 0.
   const G4double angularFrequency; ///< Angular frequency calculated from frequency - cached to avoid repeated calculation.
+
+  /// @{ Tables of the Bessel functions - nullptr if they're evaluated exactly. Not owned.
+  const BDSSpecialFunctionTable* besselJ0Table;
+  const BDSSpecialFunctionTable* besselJ1Table;
+  /// @}
 };
 
 #endif
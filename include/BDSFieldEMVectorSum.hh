@@ -20,6 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSFIELDEMVECTORSUM_H
 
 #include "BDSFieldEM.hh"
+#include "BDSFieldZIndex.hh"
 
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
@@ -29,6 +30,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 /**
  * @brief A vector sum of multiple displaced EM fields.
+ *
+ * Each field is only evaluated within its length in z. The fields to evaluate
+ * are found from an index of these intervals in z.
  * 
  * @author Laurie Nevay
  */
@@ -56,6 +60,10 @@ private:
   std::vector<G4ThreeVector> fieldOffsets;
   std::vector<G4double> timeOffsets;
   std::vector<double> zLengthsOver2; // store half lengths to save a flop at lookup time
+  BDSFieldZIndex zIndex;
+
+  /// Rebuild zIndex from the offsets and lengths.
+  void BuildIndex();
 
 };
 
@@ -205,5 +205,6 @@ private:
   static BDSPrimaryGeneratorAction* primaryGeneratorAction;
   
   G4bool useOldMultipoleOuterFields;
+  G4double specialFunctionTolerance; ///< Cache of option for tabulated special functions in fields.
 };
 #endif
@@ -21,15 +21,18 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "BDSArrayReflectionType.hh"
 #include "BDSInterpolatorType.hh"
+#include "BDSMagnetStrength.hh"
 #include "G4String.hh"
 #include "G4Transform3D.hh"
 
 #include <array>
+#include <map>
 #include <set>
 
 class BDSArray1DCoords;
 class BDSArray2DCoords;
 class BDSArray3DCoords;
+class BDSArray4D;
 class BDSArray4DCoords;
 class BDSArrayInfo;
 class BDSArrayOperatorIndex;
@@ -43,7 +46,6 @@ class BDSInterpolator1D;
 class BDSInterpolator2D;
 class BDSInterpolator3D;
 class BDSInterpolator4D;
-class BDSMagnetStrength;
 
 /**
  * @brief A loader for various field map formats.
@@ -55,6 +57,12 @@ class BDSMagnetStrength;
  * This is a singleton as the field loader owns the loaded data arrays and reuses them
  * wrapping them in interpolators multiple times if needed. For this reason there should
  * be only one field loader.
+ *
+ * The strengths calculated from a field map for autoScale are also cached, keyed
+ * on the file (path, size and modification time), format, interpolator, reflection,
+ * rigidity and transform, so magnets of the same family only calculate them once.
+ * Optionally, these are also stored in a file so subsequent runs need not recalculate
+ * them.
  * 
  * @author Laurie Nevay
  */
@@ -99,6 +107,12 @@ private:
   BDSArray4DCoords* Get4DCached(const G4String& filePath);
   /// @}
 
+  /// Rearrange a newly loaded array to the layout given by the option fieldMapLayout and
+  /// convert it to the storage type given by the option fieldMapStorageType, printing the
+  /// memory used and the error introduced.
+  void ConvertArray(BDSArray4D* array,
+                    const G4String& filePath) const;
+
   /// @{ Utility function to use the right templated loader class (gz or normal).
   BDSArray2DCoords* LoadPoissonMag2D(const G4String& filePath);
   BDSArray1DCoords* LoadBDSIM1D(const G4String& filePath);
@@ -121,6 +135,23 @@ private:
                                      const std::array<G4bool, 4>& operatesOnXYZT,
                                      G4double tolerance=0.05) const;
 
+  /// Return the multipole strengths of the field described by the recipe as calculated
+  /// by BDSFieldMagGradient for autoScale. The result is cached so each unique combination
+  /// of recipe and rigidity is only calculated once.
+  const BDSMagnetStrength& AutoScaleStrengths(const BDSFieldInfo& recipe);
+
+  /// Build a unique key for the autoScale cache from everything in the recipe that
+  /// affects the calculated strengths.
+  G4String AutoScaleCacheKey(const BDSFieldInfo& recipe) const;
+
+  /// Read any previously calculated strengths from the autoScale cache file if one
+  /// is specified by the option fieldAutoScaleCacheFile. Only done once.
+  void LoadAutoScaleCache();
+
+  /// Append an entry to the autoScale cache file if one is in use.
+  void SaveAutoScaleCacheEntry(const G4String& key,
+                               const BDSMagnetStrength& strengths) const;
+
   /// Small utility to check the pointer is valid and if it is that it's also not empty.
   /// Returns true only if it's value and not empty.
   G4bool NeedToProvideTransform(const BDSArrayReflectionTypeSet* reflectionTypes) const;
@@ -279,6 +310,11 @@ private:
   std::map<G4String, BDSArray3DCoords*> arrays3d;
   std::map<G4String, BDSArray4DCoords*> arrays4d;
   /// @}
+
+  /// Strengths calculated for autoScale by cache key.
+  std::map<G4String, BDSMagnetStrength> autoScaleCache;
+  G4bool   autoScaleCacheLoaded; ///< Whether the cache file has been read yet.
+  G4String autoScaleCacheFile;   ///< Cache file name - empty if not used.
 };
 
 #endif
@@ -24,6 +24,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Transform3D.hh"
 
+#include <limits>
+
 class BDSModulator;
 
 /**
@@ -54,6 +56,11 @@ public:
   /// Each derived class should override this if needs be. Used to warn about
   /// time modulation with a time-varying field.
   virtual G4bool TimeVarying() const {return false;}
+
+  /// Half length in local z (before the transform) beyond which GetField always returns
+  /// exactly zero. Used to skip fields that can't contribute to a sum. Derived classes
+  /// should override this if they have such a limit. Default is no limit.
+  virtual G4double LocalZHalfExtent() const {return std::numeric_limits<G4double>::max();}
   
   /// Implement interface to this class's GetField to fulfill G4MagneticField
   /// inheritance and allow a BDSFieldMag instance to be passed around in the field
@@ -54,6 +54,9 @@ public:
   inline G4double GetB0() const {return B0;}
   /// @}
 
+  /// The field is zero beyond half the coil length.
+  virtual G4double LocalZHalfExtent() const {return halfLength;}
+
 private:
   /// Private default constructor to ensure use of supplied constructor
   
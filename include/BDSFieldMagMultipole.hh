@@ -33,6 +33,11 @@ class BDSMagnetStrength;
  * 
  * The magnetic field is calculated from the strength parameters
  * "kn" up to a specified order and a design rigidity (brho).
+ *
+ * The field is summed directly in Cartesian coordinates using powers of
+ * the complex number (x + iy) built up by multiplication, so there are no
+ * trigonometric or power functions per order. The factorials are included
+ * in the coefficients at construction.
  */
 
 class BDSFieldMagMultipole: public BDSFieldMag
@@ -52,6 +57,39 @@ private:
   /// Private default constructor to force use of supplied constructor.
   BDSFieldMagMultipole();
 
+  /// Add the field of the first N orders to bx and by. With z = x + iy, order n
+  /// (starting at 2 for a quadrupole) contributes an*Im(z^(n-1)) - bn*Re(z^(n-1)) to bx
+  /// and an*Re(z^(n-1)) + bn*Im(z^(n-1)) to by. A compile time N lets the compiler
+  /// unroll the loop for the common low orders.
+  template <G4int N>
+  static inline void SumOrders(const G4double* an,
+                               const G4double* bn,
+                               G4double        x,
+                               G4double        y,
+                               G4double&       bx,
+                               G4double&       by)
+  {
+    G4double re = x; // z^1
+    G4double im = y;
+    for (G4int i = 0; i < N; i++)
+      {
+        bx += an[i]*im - bn[i]*re;
+        by += an[i]*re + bn[i]*im;
+        G4double reNext = re*x - im*y;
+        im = re*y + im*x;
+        re = reNext;
+      }
+  }
+
+  /// As above but for a number of orders only known at run time.
+  static void SumOrders(G4int           n,
+                        const G4double* an,
+                        const G4double* bn,
+                        G4double        x,
+                        G4double        y,
+                        G4double&       bx,
+                        G4double&       by);
+
   /// Order up to which field components are considered.
   G4int order;
 
@@ -60,10 +98,10 @@ private:
   /// Just an optimisation to save addition.
   G4int maximumNonZeroOrder;
 
-  /// Normal field components (normal - ie not skew) = kn * brho
+  /// Normal field coefficients (normal - ie not skew) = -kn * brho / (n-1)!
   std::vector<G4double> normalComponents;
 
-  /// Skew field components = kns * brho
+  /// Skew field coefficients = -kns * brho / (n-1)!
   std::vector<G4double> skewComponents;
 };
 
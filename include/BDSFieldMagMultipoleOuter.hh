@@ -72,11 +72,13 @@ private:
   const G4int       order;           ///< N-poles / 2.
   G4double          phiOffset;       ///< Tilt in XY calculated from B vector of inner field. if B0=(0,1,0), phiOffset=0.
   G4double          spatialLimit;    ///< Radius from any current source within which the field is artificially saturated.
+  G4double          spatialLimitSq;  ///< Cache of spatialLimit squared.
   G4double          normalisation;   ///< Storage of the overall normalisation factor.
   G4bool            positiveField;   ///< Sign of magnetic field.
   G4int             poleNOffset;     ///< Offset for pole to start at - in effect this flips the sign of the field.
   G4double          poleTipRadius;   ///< Radius of transition between inner and outer fields.
   std::vector<G4TwoVector> currents; ///< Locations of infinite wire current sources.
+  std::vector<G4double> currentSigns; ///< Sign (+-1) of each current source.
   G4double          maxField;        ///< Any field beyond this will curtailed to this value.
   G4bool            initialisationPhase; ///< Need a way to control cludge normalisation behaviour during initial normalisation calculation.
 };
@@ -20,10 +20,14 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSFIELDMAGSOLENOIDBLOCK_H
 
 #include "BDSFieldMag.hh"
+#include "BDSFieldMagSolenoidSheet.hh"
 
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
 
+#include <memory>
+#include <vector>
+
 class BDSMagnetStrength;
 
 /**
@@ -49,18 +53,24 @@ public:
                            G4double radialThicknessIn,
                            G4double fullLengthZIn,
                            G4double toleranceIn,
-                           G4int  nSheetsIn);
+                           G4int  nSheetsIn,
+                           G4double specialFunctionTolerance = 0);
   /// Alternative constructor for field factory that uses "field" (i.e. B) strength
   /// from the magnet strength instance, the argument innerRadiusIn, coilRadialThickness,
   /// and length from the strength instance.
   BDSFieldMagSolenoidBlock(const BDSMagnetStrength* st,
-                           G4double innerRadiusIn);
+                           G4double innerRadiusIn,
+                           G4double specialFunctionTolerance = 0);
   virtual ~BDSFieldMagSolenoidBlock(){;}
 
   /// Calculate the field value.
   virtual G4ThreeVector GetField(const G4ThreeVector& position,
                                  const G4double       t = 0) const;
   
+  /// The block stops summing at the first sheet with zero field, so it is zero wherever
+  /// the innermost sheet is.
+  virtual G4double LocalZHalfExtent() const;
+
   /// @{ Accessor.
   inline G4double GetB0() const {return B0;}
   inline G4double GetI()  const {return I;}
@@ -77,6 +87,9 @@ private:
   G4double coilTolerance;
   G4int    nSheetsBlock;
   G4double currentDensity;
+
+  /// The current sheets the block is made of - built once at construction.
+  std::vector<std::unique_ptr<BDSFieldMagSolenoidSheet> > sheets;
 };
 
 #endif
@@ -25,6 +25,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Types.hh"
 
 class BDSMagnetStrength;
+class BDSSpecialFunctionTable;
 
 /**
  * @brief Class that provides the magnetic field due to a cylinder of current.
@@ -37,6 +38,9 @@ class BDSMagnetStrength;
  * https://arxiv.org/abs/0909.3880.
  *
  * The field is calculated in cylindrical coordinates. A complete description is in the manual.
+ *
+ * If a finite specialFunctionTolerance is given, the elliptic integral for the radial
+ * field is interpolated from a shared table with that maximum absolute error.
  * 
  * @author Laurie Nevay
  */
@@ -48,7 +52,8 @@ public:
   /// This constructor uses the "field" and "length" parameters
   /// from the BDSMagnetStrength instance and forwards to the next constructor.
   BDSFieldMagSolenoidSheet(BDSMagnetStrength const* strength,
-                           G4double radiusIn ,G4double toleranceIn = 0.0);
+                           G4double radiusIn ,G4double toleranceIn = 0.0,
+                           G4double specialFunctionTolerance = 0.0);
   /// More reasonable constructor for the internal parameterisation. 'strength'
   /// can be either B0 or I. This is interpreted via 'strengthIsCurrent'. Have
   /// to do this as the signature would be the same for either case.
@@ -56,7 +61,8 @@ public:
                            G4bool   strengthIsCurrent,
                            G4double sheetRadius,
                            G4double fullLength,
-                           G4double toleranceIn = 0.0
+                           G4double toleranceIn = 0.0,
+                           G4double specialFunctionTolerance = 0.0
                            );
 
   virtual ~BDSFieldMagSolenoidSheet(){;}
@@ -65,6 +71,10 @@ public:
   virtual G4ThreeVector GetField(const G4ThreeVector& position,
                                  const G4double       t = 0) const;
   
+  /// If there's an on axis tolerance, the field is zero beyond the distance where the
+  /// on axis field drops below it.
+  virtual G4double LocalZHalfExtent() const {return zHalfExtent;}
+
   /// @{ Accessor.
   inline G4double GetB0() const {return B0;}
   inline G4double GetI()  const {return I;}
@@ -74,6 +84,12 @@ private:
   /// Approximation for rho=0 Bz field. Brho=0 by definition. zp and zm are z+halfLength
   /// and z-halfLength. Returns Bz.
   G4double OnAxisBz(G4double zp, G4double zm) const;
+
+  /// Find the smallest |z| beyond which the on axis field is always below coilTolerance.
+  G4double CalculateZHalfExtent() const;
+
+  /// CEL(kc, 1, 1, -1) from the table if there is one and kc is in its range.
+  inline G4double CELRadial(G4double kc) const;
   
   G4double a;
   G4double halfLength;
@@ -82,6 +98,8 @@ private:
   G4double spatialLimit;
   G4double normalisation;
   G4double coilTolerance;
+  const BDSSpecialFunctionTable* celRadialTable; ///< Table for CELRadial - nullptr if not used. Not owned.
+  G4double zHalfExtent; ///< Cache of CalculateZHalfExtent().
 };
 
 #endif
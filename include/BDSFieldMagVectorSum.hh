@@ -20,6 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSFIELDMAGVECTORSUM_H
 
 #include "BDSFieldMag.hh"
+#include "BDSFieldZIndex.hh"
 
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
@@ -28,6 +29,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 /**
  * @brief A vector sum of multiple displaced magnetic fields.
+ *
+ * Fields that declare a limit in z beyond which they are zero (see
+ * BDSFieldMag::LocalZHalfExtent) are only evaluated for points within it. The
+ * fields to evaluate are found from an index of these intervals in z.
  * 
  * @author Laurie Nevay
  */
@@ -47,6 +52,8 @@ public:
 private:
   std::vector<BDSFieldMag*> fields;
   std::vector<G4ThreeVector> fieldOffsets;
+  std::vector<G4double> zHalfExtents; ///< Cache of LocalZHalfExtent() of each field.
+  BDSFieldZIndex zIndex;
 };
 
 #endif
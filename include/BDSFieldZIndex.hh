@@ -0,0 +1,88 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFIELDZINDEX_H
+#define BDSFIELDZINDEX_H
+
+#include "G4Types.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+/**
+ * @brief Index of the intervals in z over which a set of summed fields are finite.
+ *
+ * Each field i occupies [zCentre - zHalfLength, zCentre + zHalfLength]. The
+ * intervals are sorted by their lower edge so the fields whose interval may
+ * contain a point are found with a binary search rather than testing every
+ * field. Fields with an infinite half length are always returned. The indices
+ * returned are those of the vectors the index was built from.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSFieldZIndex
+{
+public:
+  BDSFieldZIndex();
+  ~BDSFieldZIndex(){;}
+
+  /// Build the index. Both vectors must be the same length. Replaces any previous index.
+  void Build(const std::vector<G4double>& zCentres,
+             const std::vector<G4double>& zHalfLengths);
+
+  /// Call function(i) for each field i whose interval contains z (with a small margin -
+  /// the caller should apply any exact test). Unbounded fields come first, then the
+  /// others in order of the lower edge of their interval.
+  template <typename Function>
+  void ForEachCandidate(G4double z, Function&& function) const
+  {
+    for (auto i : unbounded)
+      {function(i);}
+    if (zLow.empty())
+      {return;}
+
+    // a small margin so the caller's own test decides exactly at the edges
+    G4double margin = 1e-9 * (std::abs(z) + maximumLength) + 1e-12;
+    // only intervals starting between z - maximumLength and z can contain z
+    auto first = std::lower_bound(zLow.begin(), zLow.end(), z - maximumLength - margin);
+    auto last  = std::upper_bound(first, zLow.end(), z + margin);
+    for (auto it = first; it != last; ++it)
+      {
+        std::size_t j = (std::size_t)std::distance(zLow.begin(), it);
+        if (zHigh[j] + margin >= z)
+          {function(fieldIndex[j]);}
+      }
+  }
+
+  /// Number of fields in the index.
+  std::size_t Size() const {return nFields;}
+
+private:
+  std::size_t nFields;
+  G4double maximumLength;              ///< Longest finite interval.
+  std::vector<G4double>    zLow;       ///< Lower edge of each finite interval - sorted.
+  std::vector<G4double>    zHigh;      ///< Upper edge for each entry in zLow.
+  std::vector<std::size_t> fieldIndex; ///< Original index for each entry in zLow.
+  std::vector<std::size_t> unbounded;  ///< Original index of fields with no limit in z.
+};
+
+#endif
@@ -19,6 +19,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSGLOBALCONSTANTS_H
 #define BDSGLOBALCONSTANTS_H
 
+#include "BDSArrayLayoutType.hh"
+#include "BDSArrayStorageType.hh"
 #include "BDSIntegratorSetType.hh"
 #include "BDSMagnetGeometryType.hh"
 #include "BDSOutputType.hh"
@@ -148,6 +150,7 @@ public:
   
   inline G4bool   G4PhysicsUseBDSIMRangeCuts()     const {return G4bool(options.g4PhysicsUseBDSIMRangeCuts);}
   inline G4bool   G4PhysicsUseBDSIMCutsAndLimits() const {return G4bool(options.g4PhysicsUseBDSIMCutsAndLimits);}
+  inline G4String PhysicsTableCacheDir()           const {return G4String(options.physicsTableCacheDir);}
   
   inline G4double PrintFractionEvents()      const {return G4double(options.printFractionEvents);}
   inline G4double PrintFractionTurns()       const {return G4double(options.printFractionTurns);}
@@ -209,6 +212,7 @@ public:
   inline G4double MinimumEpsilonStepThin()   const {return G4double(options.minimumEpsilonStepThin);}
   inline G4double MaximumEpsilonStepThin()   const {return G4double(options.maximumEpsilonStepThin);}
   inline G4String FieldModulator()           const {return G4String(options.fieldModulator);}
+  inline G4String FieldAutoScaleCacheFile()  const {return G4String(options.fieldAutoScaleCacheFile);}
   inline G4double MaxTime()                  const {return G4double(options.maximumTrackingTime)*CLHEP::s;}
   inline G4double MaxStepLength()            const {return G4double(options.maximumStepLength)*CLHEP::m;}
   inline G4double MaxTrackLength()           const {return G4double(options.maximumTrackLength)*CLHEP::m;}
@@ -259,6 +263,7 @@ public:
   inline G4bool   StoreELossPreStepKineticEnergy() const {return G4bool (options.storeElossPreStepKineticEnergy);}
   inline G4bool   StoreELossModelID()        const {return G4bool  (options.storeElossModelID);}
   inline G4bool   StoreELossPhysicsProcesses()const{return G4bool  (options.storeElossPhysicsProcesses);}
+  inline G4bool   StoreEventProfile()        const {return G4bool  (options.storeEventProfile);}
   inline G4bool   StoreParticleData()        const {return G4bool  (options.storeParticleData);}
   inline G4bool   StoreTrajectory()          const {return G4bool  (options.storeTrajectory);}
   inline G4bool   StoreTrajectoryAll()       const {return          options.storeTrajectoryDepth == -1;}
@@ -304,6 +309,8 @@ public:
   inline G4int    MaximumPhotonsPerStep()    const {return G4int   (options.maximumPhotonsPerStep);}
   inline G4int    MaximumBetaChangePerStep() const {return G4int   (options.maximumBetaChangePerStep);}
   inline G4long   MaximumTracksPerEvent()    const {return G4long  (options.maximumTracksPerEvent);}
+  inline G4long   MaximumStepsPerEvent()     const {return G4long  (options.maximumStepsPerEvent);}
+  inline G4double MaximumCPUTimePerEvent()   const {return G4double(options.maximumCPUTimePerEvent);}
   inline G4double MinimumKineticEnergy()     const {return G4double(options.minimumKineticEnergy*CLHEP::GeV);}
   inline G4double MinimumKineticEnergyTunnel() const {return G4double(options.minimumKineticEnergyTunnel)*CLHEP::GeV;}
   inline G4double MinimumRange()             const {return G4double(options.minimumRange*CLHEP::m);}
@@ -316,6 +323,13 @@ public:
   inline G4bool   AutoColourWorldGeometryFile()  const {return G4bool  (options.autoColourWorldGeometryFile);}
   inline G4String ImportanceWorldGeometryFile()  const {return G4String(options.importanceWorldGeometryFile);}
   inline G4String ImportanceVolumeMapFile()      const {return G4String(options.importanceVolumeMap);}
+  inline G4String ImportanceVolumeMapOutputFile() const {return G4String(options.importanceVolumeMapOutput);}
+  inline G4String WeightWindowMesh()         const {return G4String(options.weightWindowMesh);}
+  inline G4bool   UseWeightWindows()         const {return !options.weightWindowMesh.empty();}
+  inline G4String WeightWindowFile()         const {return G4String(options.weightWindowFile);}
+  inline G4double WeightWindowUpperRatio()   const {return G4double(options.weightWindowUpperRatio);}
+  inline G4double WeightWindowSurvivalRatio()const {return G4double(options.weightWindowSurvivalRatio);}
+  inline G4int    WeightWindowMaximumSplit() const {return G4int   (options.weightWindowMaximumSplit);}
   inline G4double WorldVolumeMargin()        const {return G4double(options.worldVolumeMargin*CLHEP::m);}
   inline G4bool   YokeFields()               const {return G4bool  (options.yokeFields);}
   inline G4bool   YokeFieldsMatchLHCGeometry()const{return G4bool  (options.yokeFieldsMatchLHCGeometry);}
@@ -323,6 +337,7 @@ public:
   inline G4double ScalingFieldOuter()        const {return G4double(options.scalingFieldOuter);}
   inline G4bool   IntegrateKineticEnergyAlongBeamline()const {return G4bool  (options.integrateKineticEnergyAlongBeamline);}
   inline G4String CavityFieldType()          const {return G4String(options.cavityFieldType);}
+  inline G4double SpecialFunctionTolerance() const {return G4double(options.specialFunctionTolerance);}
   inline G4bool   TurnOnOpticalAbsorption()  const {return G4bool  (options.turnOnOpticalAbsorption);}
   inline G4bool   TurnOnRayleighScattering() const {return G4bool  (options.turnOnRayleighScattering);}
   inline G4bool   TurnOnMieScattering()      const {return G4bool  (options.turnOnMieScattering);}
@@ -356,6 +371,9 @@ public:
   inline G4double DEThresholdForScattering() const {return G4double(options.dEThresholdForScattering)*CLHEP::GeV;}
   inline G4String PTCOneTurnMapFileName()    const {return G4String (options.ptcOneTurnMapFileName);}
   inline G4double BackupStepperMomLimit()    const {return G4double(options.backupStepperMomLimit)*CLHEP::rad;}
+  inline G4bool   FastTransportPrimaries()   const {return G4bool  (options.fastTransportPrimaries);}
+  inline G4int    FastTransportBatchSize()   const {return G4int   (options.fastTransportBatchSize);}
+  inline G4bool   TrackPrimariesOnly()       const {return G4bool  (options.trackPrimariesOnly);}
 
   /// @{ options that require some implementation.
   G4bool StoreTrajectoryTransportationSteps() const;
@@ -376,6 +394,8 @@ public:
   inline G4UserLimits*         DefaultUserLimits()       const {return defaultUserLimits;}
   inline G4UserLimits*         DefaultUserLimitsTunnel() const {return defaultUserLimitsTunnel;}
   inline BDSIntegratorSetType  IntegratorSet()           const {return integratorSet;}
+  inline BDSArrayStorageType   FieldMapStorageType()     const {return fieldMapStorageType;}
+  inline BDSArrayLayoutType    FieldMapLayout()          const {return fieldMapLayout;}
   inline G4Transform3D         BeamlineTransform()       const {return beamlineTransform;}
   inline std::set<G4int>       ParticlesToExcludeFromCutsAsSet() const {return particlesToExcludeFromCutsAsSet;}
 
@@ -444,6 +464,8 @@ private:
 
   BDSOutputType        outputType;         ///< Output type enum for output format to be used.
   BDSIntegratorSetType integratorSet;      ///< Integrator type enum for integrator set to be used.
+  BDSArrayStorageType  fieldMapStorageType; ///< How field map values are stored in memory.
+  BDSArrayLayoutType   fieldMapLayout;      ///< Order of field map values in memory.
   G4Transform3D        beamlineTransform;  ///< Transform for start of beam line.
 
   std::bitset<BDS::NTrajectoryFilters> trajectoryFiltersSet; ///< Which filters were used in the options.
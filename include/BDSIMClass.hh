@@ -23,10 +23,16 @@ class BDSBunch;
 class BDSComponentConstructor;
 class BDSComponentFactoryUser;
 class BDSDetectorConstruction;
+class BDSEventBudget;
+class BDSEventProfiler;
 class BDSGlobalConstants;
 class BDSOutput;
+class BDSParallelWorldImportance;
 class BDSParser;
+class BDSPhysicsTableCache;
 class BDSRunManager;
+class BDSTrackKillRules;
+class BDSWeightWindowMesh;
 class G4VModularPhysicsList;
 
 #include "G4String.hh"
@@ -106,6 +112,12 @@ private:
   BDSComponentFactoryUser* userComponentFactory; ///< Optional user registered component factory.
   G4VModularPhysicsList* userPhysicsList;        ///< Optional user registered physics list.
   BDSDetectorConstruction* realWorld;
+  BDSPhysicsTableCache*    physicsTableCache;     ///< Optional physics table cache.
+  BDSParallelWorldImportance* importanceWorld;    ///< Optional importance sampling world - not owned.
+  BDSWeightWindowMesh*     weightWindows;         ///< Optional mesh based weight windows.
+  BDSTrackKillRules*       killRules;             ///< Optional user defined rules to kill tracks.
+  BDSEventBudget*          eventBudget;           ///< Optional per-event step and CPU time budget.
+  BDSEventProfiler*        eventProfiler;         ///< Optional per-event step and time profiler.
   /// @}
 };
 
@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSIMLINK_H
 #define BDSIMLINK_H
 #include "BDSHitSamplerLink.hh"
+#include "BDSIMLinkCAPI.hh"
 #include "BDSLinkRunAction.hh"
 
 #include <map>
@@ -88,6 +89,14 @@ public:
   void SelectLinkElement(const std::string& elementName, bool debug = false);
   void SelectLinkElement(int index, bool debug = false);
 
+  /// @{ Add many elements at once. Between these calls the geometry is left open and
+  /// AddLinkCollimatorJaw doesn't update the output nor close (and so re-optimise) the
+  /// geometry - EndLinkElements does this once for all the new elements. Without these,
+  /// each element added re-optimises the whole world. BeamOn ends an unfinished set.
+  void BeginLinkElements();
+  void EndLinkElements();
+  /// @}
+
   /// Use standard C++ types as expected to be used externally.
   int AddLinkCollimatorJaw(const std::string& collimatorName,
                            const std::string& materialName,
@@ -107,6 +116,11 @@ public:
 
   BDSHitsCollectionSamplerLink* SamplerHits() const;
   void ClearSamplerHits() {runAction->ClearSamplerHits();}
+
+  /// Write the sampler hits into preallocated arrays in SixTrack units (m, rad, GeV, s)
+  /// so the caller doesn't have to walk the hits collection. Up to particlesOut.capacity
+  /// are written. Returns the total number of hits, which may be larger than the capacity.
+  int FillParticleArrays(BDSLinkParticlesOut& particlesOut) const;
   
   int GetCurrentMaximumSixTrackParticleID() const;
   void SetCurrentMaximumExternalParticleID(int currentMaximumExternalParticleID);
@@ -154,6 +168,7 @@ private:
   std::map<std::string, int>        nameToElementIndex;
   std::map<int, int>                linkIDToBeamlineIndex;
   int                               currentElementIndex; ///< Element to track in.
+  bool                              addingLinkElements;  ///< Whether between Begin and EndLinkElements.
   G4VModularPhysicsList*            userPhysicsList;     ///< Optional user registered physics list.
 };
 
@@ -0,0 +1,143 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSIMLINKCAPI_H
+#define BDSIMLINKCAPI_H
+
+#include <stdint.h>
+
+/**
+ * @file BDSIMLinkCAPI.hh
+ *
+ * @brief C interface to exchange whole bunches with BDSIMLink.
+ *
+ * Particles are passed as a structure of contiguous arrays - one array per
+ * coordinate - and the particles returned from the link samplers are written
+ * into arrays preallocated by the caller. Units are those used by SixTrack:
+ * m, rad (px/p), GeV and s. The charge is in units of e. Any optional array
+ * may be a null pointer. This header may be included from C or C++.
+ *
+ * Elements are best added between bdsim_link_begin_elements and bdsim_link_end_elements.
+ * A typical pass through one element is then:
+ *   bdsim_link_select_element(handle, "TCP.C6L7.B1");
+ *   n = bdsim_link_track(handle, &in, &out);
+ *   if (n > out.capacity) {reallocate then bdsim_link_collect(handle, &out);}
+ *
+ * @author Laurie Nevay
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Particles to be tracked - n entries in each non-null array.
+typedef struct BDSLinkParticlesIn
+{
+  int            n;
+  const double*  x;           ///< m
+  const double*  y;           ///< m
+  const double*  xp;          ///< px / p
+  const double*  yp;          ///< py / p
+  const double*  totalEnergy; ///< GeV
+  const double*  t;           ///< s - optional, 0 if null
+  const double*  weight;      ///< optional, 1 if null
+  const int32_t* pdgID;
+  const int16_t* Z;           ///< optional, only used for ions
+  const int16_t* A;           ///< optional, only used for ions
+  const int16_t* charge;      ///< optional, only used for ions, Z if null
+  const int32_t* particleID;  ///< optional, index in the arrays if null
+  const int32_t* parentID;    ///< optional, 0 if null
+} BDSLinkParticlesIn;
+
+/// Preallocated arrays for the returned particles - up to capacity entries are
+/// written to each non-null array.
+typedef struct BDSLinkParticlesOut
+{
+  int      capacity;
+  double*  x;           ///< m
+  double*  y;           ///< m
+  double*  xp;          ///< px / p
+  double*  yp;          ///< py / p
+  double*  totalEnergy; ///< GeV
+  double*  t;           ///< s
+  double*  weight;
+  double*  mass;        ///< GeV
+  int32_t* pdgID;
+  int16_t* Z;
+  int16_t* A;
+  int16_t* charge;
+  int32_t* particleID;
+  int32_t* parentID;
+} BDSLinkParticlesOut;
+
+/// Opaque handle to an instance of BDSIMLink and its bunch.
+typedef struct BDSIMLinkHandle BDSIMLinkHandle;
+
+/// Construct and initialise BDSIM with the usual command line arguments. The minimum
+/// kinetic energy is in GeV. Returns a null pointer if initialisation failed.
+BDSIMLinkHandle* bdsim_link_create(int    argc,
+                                   char** argv,
+                                   double minimumKineticEnergy,
+                                   int    protonsAndIonsOnly);
+
+/// Delete the instance and everything it owns.
+void bdsim_link_destroy(BDSIMLinkHandle* handle);
+
+/// @{ Add many elements at once so the geometry is only optimised once when the set is
+/// ended. Returns 0 on success and -1 on failure.
+int bdsim_link_begin_elements(BDSIMLinkHandle* handle);
+int bdsim_link_end_elements(BDSIMLinkHandle* handle);
+/// @}
+
+/// Add a collimator with two jaws. Lengths are in m and angles in rad. Returns the
+/// index of the new element or -1 on failure.
+int bdsim_link_add_collimator_jaw(BDSIMLinkHandle* handle,
+                                  const char*      collimatorName,
+                                  const char*      materialName,
+                                  double           length,
+                                  double           halfApertureLeft,
+                                  double           halfApertureRight,
+                                  double           rotation,
+                                  double           xOffset,
+                                  double           yOffset);
+
+/// @{ Select the element subsequent bunches are tracked through. Returns 0 on
+/// success and -1 on failure.
+int bdsim_link_select_element(BDSIMLinkHandle* handle, const char* elementName);
+int bdsim_link_select_element_index(BDSIMLinkHandle* handle, int index);
+/// @}
+
+/// Track all particles in 'in' through the currently selected element and write the
+/// particles returned by the link samplers into 'out'. The previous bunch and hits are
+/// cleared first. Returns the total number of particles returned, which may be larger
+/// than out->capacity in which case only the first out->capacity are written and
+/// bdsim_link_collect may be used with larger arrays. 'out' may be a null pointer.
+/// Returns -1 on failure.
+int bdsim_link_track(BDSIMLinkHandle*          handle,
+                     const BDSLinkParticlesIn* in,
+                     BDSLinkParticlesOut*      out);
+
+/// Write the particles returned from the last bdsim_link_track call into 'out' again.
+/// Returns the total number of particles returned or -1 on failure.
+int bdsim_link_collect(BDSIMLinkHandle* handle, BDSLinkParticlesOut* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -40,6 +40,7 @@ typedef G4THitsCollection<BDSHitCollimator> BDSHitsCollectionCollimator;
 class BDSHitEnergyDeposition;
 typedef G4THitsCollection<BDSHitEnergyDeposition> BDSHitsCollectionEnergyDeposition;
 class BDSEventInfo;
+class BDSEventProfiler;
 class BDSParticleCoordsFullGlobal;
 class BDSParticleDefinition;
 class BDSHitSampler;
@@ -119,6 +120,12 @@ public:
   /// should not be used in conjunction with FillEvent().
   void FillEventPrimaryOnly(const BDSParticleCoordsFullGlobal& coords,
                             const BDSParticleDefinition*       particle);
+
+
+  /// As FillEventPrimaryOnly but for many events at once, each with one primary. Only the
+  /// primary structures are cleared after each event as nothing else is filled.
+  void FillEventsPrimaryOnly(const std::vector<BDSParticleCoordsFullGlobal>& coords,
+                             const BDSParticleDefinition*                    particle);
   
   /// Copy event information from Geant4 simulation structures to output structures.
   void FillEvent(const BDSEventInfo*                            info,
@@ -145,6 +152,10 @@ public:
   /// Close a file and open a new one.
   void CloseAndOpenNewFile();
 
+  /// Set the (optional) profiler whose tallies are stored in histograms for each
+  /// event. Must be set before the histograms are created at the start of a run. Not owned.
+  inline void SetEventProfiler(const BDSEventProfiler* eventProfilerIn) {eventProfiler = eventProfilerIn;}
+
   /// Copy run information to output structure.
   void FillRun(const BDSEventInfo* info,
                unsigned long long int nOriginalEventsIn,
@@ -285,6 +296,18 @@ private:
                                   unsigned long long int nEventsDistrFileSkippedIn,
                                   unsigned int distrFileLoopNTimesIn);
 
+  /// Create a 1D histogram with one bin per label in both the event and run histograms.
+  G4int CreateLabelledHistogram(const G4String& name,
+                                const G4String& title,
+                                const std::vector<G4String>& labels);
+
+  /// Fill the event profile histograms from the profiler tallies for this event.
+  void FillEventProfile();
+
+  /// Add a vector of values with one per bin to a 1D histogram in the event and run histograms.
+  void FillEventProfileHistogram(const G4String& histogramName,
+                                 const std::vector<G4double>& values);
+
   /// Utility function to copy out select bins from one histogram to another for 1D
   /// histograms only.
   void CopyFromHistToHist1D(const G4String& sourceName,
@@ -350,6 +373,8 @@ private:
   G4int    nCollimatorsInteracted;
   /// @}
 
+  const BDSEventProfiler* eventProfiler; ///< Optional step and time profiler.
+
   /// @{ Map of histogram name (short) to index of histogram in output.
   std::map<G4String, G4int> histIndices1D;
   std::map<G4String, G4int> histIndices3D;
@@ -41,6 +41,7 @@ public:
   std::string seedStateAtStart;         ///< Seed state at the start of the event.
   int    index;                         ///< Number of this event or run.
   bool   aborted;                       ///< Whether the event was aborted or not.
+  bool   truncated;                     ///< Whether the event exceeded its step or CPU time budget.
   bool   primaryHitMachine;             ///< Whether the primary particle hit the accelerator or not.
   bool   primaryAbsorbedInCollimator;   ///< Whether the primary stopped in a collimator.
   double memoryUsageMb;                 ///< Memory usage (rusage.ru_maxrss).
@@ -67,7 +68,7 @@ public:
   /// Fill from another instance.
   void Fill(const BDSOutputROOTEventInfo* other);
   
-  ClassDef(BDSOutputROOTEventInfo, 7);
+  ClassDef(BDSOutputROOTEventInfo, 8);
 };
 
 #endif
@@ -0,0 +1,107 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSPTCMAPPOLYNOMIAL_H
+#define BDSPTCMAPPOLYNOMIAL_H
+
+#include "G4Types.hh"
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+/**
+ * @brief A set of polynomials in the same variables compiled for fast evaluation.
+ *
+ * Used for a PTC map where each output coordinate is a sum of terms of a coefficient
+ * multiplied by integer powers of the input coordinates. Terms are added and then
+ * Compile() builds a list of all the monomials required by any output. Every monomial
+ * is the product of a previously calculated monomial and one variable, so each is
+ * evaluated with one multiplication and shared between all outputs. There are no
+ * calls to std::pow.
+ *
+ * Many sets of coordinates, stored as one array per variable, can be evaluated at
+ * once in blocks where each monomial is calculated for the whole block in a loop
+ * the compiler can vectorise.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSPTCMapPolynomial
+{
+public:
+  /// Number of variables and outputs (x, px, y, py, deltaP).
+  static const G4int nVariables = 5;
+  typedef std::array<G4int, nVariables> Exponents;
+
+  BDSPTCMapPolynomial();
+  ~BDSPTCMapPolynomial(){;}
+
+  /// Add a term to one output (0 to nVariables-1). Terms with the same exponents
+  /// are summed. Throws a BDSException for an invalid output or negative exponent.
+  void AddTerm(G4int output, G4double coefficient, const Exponents& exponents);
+
+  /// Build the monomials and the coefficients of each output from the terms.
+  void Compile();
+
+  /// Number of monomials calculated per evaluation including the constant 1.
+  inline std::size_t NMonomials() const {return parent.size();}
+
+  /// Number of terms summed per evaluation for all outputs.
+  std::size_t NTerms() const;
+
+  /// Evaluate all outputs for one set of coordinates. An output with no terms is 0.
+  /// out must not be the same memory as in.
+  void Evaluate(const G4double in[nVariables], G4double out[nVariables]) const;
+
+  /// Evaluate all outputs for n sets of coordinates stored as one array per variable.
+  /// The output arrays must not be the same memory as the input arrays.
+  void Evaluate(std::size_t           n,
+                const G4double* const in[nVariables],
+                G4double* const       out[nVariables]) const;
+
+  /// Number of coordinate sets evaluated together in the many particle evaluation.
+  static const std::size_t blockSize = 64;
+
+private:
+  /// A term of an output after compilation.
+  struct Term
+  {
+    G4int    monomial;
+    G4double coefficient;
+  };
+
+  /// Terms as added before compilation - one map per output.
+  std::array<std::map<Exponents, G4double>, nVariables> terms;
+
+  /// @{ Monomial i (for i > 0) is monomial parent[i] multiplied by variable[i]. Monomial 0 is 1.
+  std::vector<G4int> parent;
+  std::vector<G4int> variable;
+  /// @}
+
+  /// Compiled terms for each output in order of monomial.
+  std::array<std::vector<Term>, nVariables> compiled;
+
+  /// @{ Scratch memory for the monomial values.
+  mutable std::vector<G4double> monomials;
+  mutable std::vector<G4double> monomialsBlock;
+  /// @}
+};
+
+#endif
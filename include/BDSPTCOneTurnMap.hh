@@ -20,11 +20,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSPTCONETURNMAP_H
 
 #include "BDSParticleCoordsFullGlobal.hh"
+#include "BDSPTCMapPolynomial.hh"
 
 #include "globals.hh" // Geant4 typedefs
 #include "G4Track.hh"
 
-#include <vector>
+#include <cstddef>
 #include <set>
 
 class BDSParticleDefinition;
@@ -33,6 +34,7 @@ class BDSParticleDefinition;
  * @brief Class to load and use PTC 1 turn map.
  *
  * This class uses PTC units internally for calculating the result of the map.
+ * The map is compiled into a BDSPTCMapPolynomial when it is loaded.
  *
  * @author Stuart Walker.
  */
@@ -40,16 +42,6 @@ class BDSParticleDefinition;
 class BDSPTCOneTurnMap
 {
 public:
-  struct PTCMapTerm
-  {
-    G4double coefficient;
-    G4int nx;
-    G4int npx;
-    G4int ny;
-    G4int npy;
-    G4int ndeltaP;
-  };
-    
   BDSPTCOneTurnMap() = delete;                                   ///< Default constructor.
   BDSPTCOneTurnMap(const BDSPTCOneTurnMap &other) = default;     ///< Copy constructor.
   BDSPTCOneTurnMap(BDSPTCOneTurnMap &&other) noexcept = default; ///< Move constructor. 
@@ -79,14 +71,19 @@ public:
 		   G4double& pz,
 		   G4int turnstaken);
 
-private:
-  G4double Evaluate(std::vector<PTCMapTerm>& terms,
-		    G4double x,
-		    G4double px,
-            G4double y,
-		    G4double py,
-		    G4double deltaP) const;
+  /// Apply the map once to n particles in PTC coordinates stored as one array per
+  /// coordinate. The arrays are updated in place.
+  void Apply(std::size_t n,
+             G4double*   x,
+             G4double*   px,
+             G4double*   y,
+             G4double*   py,
+             G4double*   deltaP) const;
+
+  /// Access the compiled map.
+  inline const BDSPTCMapPolynomial& Map() const {return map;}
 
+private:
   G4double initialPrimaryMomentum;
   G4bool   beamOffsetS0;
   G4double referenceMomentum;
@@ -101,11 +98,7 @@ private:
   G4double pyLastTurn;
   G4double deltaPLastTurn;
 
-  std::vector<PTCMapTerm> xTerms;
-  std::vector<PTCMapTerm> yTerms;
-  std::vector<PTCMapTerm> pxTerms;
-  std::vector<PTCMapTerm> pyTerms;
-  std::vector<PTCMapTerm> deltaPTerms;
+  BDSPTCMapPolynomial map; ///< Outputs in the order x, px, y, py, deltaP.
 };
 
 #endif
@@ -28,6 +28,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <map>
 
+class BDSSDImportanceCell;
 class G4UserLimits;
 class G4VisAttributes;
 class G4VPhysicalVolume;
@@ -68,8 +69,14 @@ public:
   /// Create IStore for all importance sampling geometry cells.
   void AddIStore();
 
+  /// Attach a sensitive detector to the cells to accumulate the flux for a pilot
+  /// run if an output importance map file is specified.
   virtual void ConstructSD();
 
+  /// Calculate importance values from the flux accumulated in a pilot run and write
+  /// them in the importance map file format. Does nothing if no output file is specified.
+  void WriteImportanceMap() const;
+
   /// World volume getter required in parallel world utilities.
   inline G4VPhysicalVolume* GetWorldVolume() {return imWorldPV;}
 
@@ -95,6 +102,8 @@ private:
 
   G4String imGeomFile;
   G4String imVolMap;
+  G4String imVolMapOutput;         ///< Importance map file to write from a pilot run.
+  BDSSDImportanceCell* pilotSD;    ///< Flux accumulation for a pilot run.
   const G4String componentName; ///< String preprended to geometry with preprocessGDML
 
   ///@{ Cached global constants values.
@@ -105,6 +114,9 @@ private:
 
   /// Get importance value of a given physical volume name.
   G4double GetCellImportanceValue(const G4String& cellName);
+
+  /// Strip the name prefix added by the geometry loading to get the name as in the map file.
+  G4String PureCellName(const G4String& cellName) const;
 };
 
 #endif
@@ -111,6 +111,8 @@ public:
   inline std::vector<GMAD::ScorerMesh> GetScorerMesh() const {return scorermesh_list.getVector();}
   inline std::vector<GMAD::BLMPlacement> GetBLMs() const {return blm_list.getVector();}
   inline std::vector<GMAD::Modulator> GetModulators() const {return modulator_list.getVector();}
+  inline std::vector<GMAD::KillRule> GetKillRules() const {return killrule_list.getVector();}
+  inline std::vector<GMAD::ProcessSplitting> GetProcessSplitting() const {return processsplitting_list.getVector();}
   inline std::vector<GMAD::Aperture> GetApertures() const {return aperture_list.getVector();}
   /// @}
 
@@ -0,0 +1,81 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSPARTICLECOORDSBATCH_H
+#define BDSPARTICLECOORDSBATCH_H
+
+#include "BDSParticleCoordsFull.hh"
+
+#include "G4Types.hh"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Many sets of particle coordinates stored as one array per coordinate.
+ *
+ * The same coordinates as BDSParticleCoordsFull. Storing each coordinate
+ * contiguously allows a bunch distribution to generate many particles at once
+ * with loops the compiler can vectorise.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSParticleCoordsBatch
+{
+public:
+  BDSParticleCoordsBatch() = default;
+  ~BDSParticleCoordsBatch() = default;
+
+  /// Number of particles stored.
+  inline std::size_t Size() const {return x.size();}
+
+  /// Reserve memory for a total of n particles in every array.
+  void Reserve(std::size_t n);
+
+  /// Change the number of particles in every array. New values are 0.
+  void Resize(std::size_t n);
+
+  /// Remove all particles but keep the memory.
+  void Clear();
+
+  /// Append one set of coordinates.
+  void Append(const BDSParticleCoordsFull& coords);
+
+  /// Get one set of coordinates.
+  BDSParticleCoordsFull Get(std::size_t i) const;
+
+  /// @{ Coordinates.
+  std::vector<G4double> x;
+  std::vector<G4double> y;
+  std::vector<G4double> z;
+  std::vector<G4double> xp;
+  std::vector<G4double> yp;
+  std::vector<G4double> zp;
+  std::vector<G4double> T;
+  std::vector<G4double> s;
+  std::vector<G4double> totalEnergy;
+  std::vector<G4double> weight;
+  /// @}
+
+private:
+  /// Convenience for operations applied to every array.
+  std::vector<std::vector<G4double>*> Arrays();
+};
+
+#endif
@@ -0,0 +1,72 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSPHYSICSPROCESSSPLITTING_H
+#define BDSPHYSICSPROCESSSPLITTING_H
+
+#include "BDSSingleUse.hh"
+#include "BDSWrapperProcessSplitting.hh"
+
+#include "G4String.hh"
+#include "G4Types.hh"
+#include "G4VPhysicsConstructor.hh"
+
+#include <set>
+#include <vector>
+
+namespace GMAD
+{
+  class ProcessSplitting;
+}
+
+/**
+ * @brief Wrap named processes of named particles to split their products.
+ *
+ * Each processsplitting definition from the parser names one or more parent
+ * particles and processes. All definitions that apply to the same process of the
+ * same particle are combined into one BDSWrapperProcessSplitting with one group of
+ * products per definition in the order they were defined.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSPhysicsProcessSplitting: public G4VPhysicsConstructor, public BDSSingleUse
+{
+public:
+  BDSPhysicsProcessSplitting() = delete;
+  /// Convert and check the parser definitions. May throw a BDSException.
+  explicit BDSPhysicsProcessSplitting(const std::vector<GMAD::ProcessSplitting>& definitionsIn);
+  virtual ~BDSPhysicsProcessSplitting(){;}
+
+  /// No particles are constructed here.
+  virtual void ConstructParticle(){;}
+
+  /// Construct and attach the processes to the relevant particles.
+  virtual void ConstructProcess();
+
+private:
+  /// A converted parser definition.
+  struct Definition
+  {
+    std::set<G4String> particles;
+    std::set<G4String> processes;
+    BDSWrapperProcessSplitting::ProductSplitting products;
+  };
+  std::vector<Definition> definitions;
+};
+#endif
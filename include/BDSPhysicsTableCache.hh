@@ -0,0 +1,77 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSPHYSICSTABLECACHE_H
+#define BDSPHYSICSTABLECACHE_H
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+class G4VModularPhysicsList;
+
+/**
+ * @brief Store and retrieve Geant4 physics tables in a cache directory.
+ *
+ * The tables are kept in a subdirectory named by a hash of everything that
+ * determines them: the physics constructors, the Geant4 version and data sets,
+ * the EM parameters, the material table and the regions with their production
+ * cuts. If a complete entry exists, the physics list is told to retrieve the
+ * tables from it instead of building them. Otherwise the tables are stored after
+ * they have been built in the first run. Entries are written to a temporary
+ * directory and renamed so jobs sharing a cache don't see partial entries.
+ *
+ * Geant4 only stores the tables of processes that support it (mainly EM). Any
+ * table that can't be retrieved is built as usual.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSPhysicsTableCache
+{
+public:
+  BDSPhysicsTableCache(const G4String& cacheDirectoryIn,
+                       G4VModularPhysicsList* physicsListIn);
+  ~BDSPhysicsTableCache(){;}
+
+  /// Work out the key and either set the physics list to retrieve the tables or prepare
+  /// to store them. Must be called after G4RunManager::Initialize() and before the first run.
+  void Prepare();
+
+  /// Store the tables if they weren't retrieved. Must be called after the first run has
+  /// started, i.e. once the tables are built. Only does anything once.
+  void StoreIfRequired();
+
+  /// Whether the tables were found in the cache.
+  inline G4bool Retrieved() const {return retrieved;}
+
+private:
+  BDSPhysicsTableCache() = delete;
+
+  /// The full text of all the inputs that determine the physics tables.
+  G4String KeyText() const;
+
+  G4String               cacheDirectory;
+  G4VModularPhysicsList* physicsList; ///< Not owned.
+  G4String               keyText;
+  G4String               entryDirectory;
+  G4bool                 prepared;
+  G4bool                 retrieved;
+  G4bool                 stored;
+};
+
+#endif
@@ -28,6 +28,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 class BDSParticleDefinition;
 class G4DynamicParticle;
@@ -45,6 +46,7 @@ class G4Transportation;
 namespace GMAD
 {
   class Beam;
+  class ProcessSplitting;
 }
 
 namespace BDS
@@ -116,6 +118,11 @@ namespace BDS
   /// Build muon splitting biasing and wrap the various processes in the physics list.
   void BuildMuonBiasing(G4VModularPhysicsList* physicsList);
 
+  /// Build the splitting of the products of any named processes from the parser
+  /// definitions and wrap those processes in the physics list.
+  void BuildProcessSplitting(G4VModularPhysicsList* physicsList,
+                             const std::vector<GMAD::ProcessSplitting>& definitions);
+
 #if G4VERSION_NUMBER > 1039
   /// Build the physics required for channelling to work correctly.
   G4VModularPhysicsList* ChannellingPhysicsComplete(G4bool useEMD  = false,
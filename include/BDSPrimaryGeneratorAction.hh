@@ -20,11 +20,16 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSPRIMARYGENERATORACTION_H
 
 #include "BDSExtent.hh"
+#include "BDSParticleCoordsFullGlobal.hh"
 
 #include "globals.hh"
 #include "G4VUserPrimaryGeneratorAction.hh"
 
+#include <cstddef>
+#include <vector>
+
 class BDSBunch;
+class BDSFastTransport;
 class BDSOutputLoader;
 class BDSPrimaryGeneratorFile;
 class BDSPTCOneTurnMap;
@@ -63,6 +68,10 @@ public:
 private:
   /// For a file-based event generator there are a few checks we have to do - put in a function to keep tidy.
   void GeneratePrimariesFromFile(G4Event* anEvent);
+
+  /// Get the next primary transported through the initial analytic section of the beam line.
+  /// A batch of primaries is generated and transported together when the buffer is empty.
+  BDSParticleCoordsFullGlobal GetNextFastTransportedParticle(G4int eventIndex);
   
   G4ParticleGun* particleGun;     ///< Geant4 particle gun that creates single particles.
   BDSBunch* bunch;                ///< BDSIM particle generator.
@@ -85,6 +94,14 @@ private:
   BDSPTCOneTurnMap* oneTurnMap;
 
   BDSPrimaryGeneratorFile* generatorFromFile;
+
+  /// @{ Optional analytic transport of primaries through the vacuum at the start of the beam line.
+  G4bool            useFastTransport;
+  G4int             fastTransportBatchSize;
+  BDSFastTransport* fastTransport;
+  std::vector<BDSParticleCoordsFullGlobal> fastTransportBuffer; ///< Transported primaries in order.
+  std::size_t       fastTransportBufferIndex;                   ///< Next primary to use from the buffer.
+  /// @}
 };
 
 #endif
@@ -19,7 +19,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSPRIMARYGENERATORFILESAMPLER_H
 #define BDSPRIMARYGENERATORFILESAMPLER_H
 
+#include "BDSParticleCoordsFull.hh"
 #include "BDSPrimaryGeneratorFile.hh"
+#include "BDSSamplerEventPrefetcher.hh"
 
 #include "G4RotationMatrix.hh"
 #include "G4String.hh"
@@ -30,6 +32,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 class BDSBunchEventGenerator;
 class BDSOutputLoaderSampler;
+template <class T> class BDSOutputROOTEventSampler;
 class G4Event;
 class G4PrimaryParticle;
 class G4PrimaryVertex;
@@ -82,16 +85,31 @@ protected:
   /// Conversion from HepMC::GenEvent to G4Event.
   //void HepMC2G4(const HepMC3::GenEvent* hepmcevt, G4Event* g4event);
   
-  void ReadPrimaryParticlesFloat(G4long index);
-  void ReadPrimaryParticlesDouble(G4long index);
+  /// Load the particles of one event from the file into plain data. Optionally, apply
+  /// the filters of the bunch that don't need the Geant4 particle table so this may be
+  /// used on a separate thread.
+  void LoadEvent(G4long index, BDSSamplerEvent& event, G4bool applyFilters);
+
+  /// Make primary particles from a loaded event and put them in vertices.
+  void ReadPrimaryParticles(const BDSSamplerEvent& event);
+
+  /// Convert the sampler data of either precision. The momentum unit is required as
+  /// float and double precision output are stored in different units.
+  template <typename T>
+  void LoadParticles(const BDSOutputROOTEventSampler<T>* sampler,
+                     G4double         momentumUnit,
+                     BDSSamplerEvent& event,
+                     G4bool           applyFilters) const;
 
 private:
   BDSOutputLoaderSampler*   reader;
+  BDSSamplerEventPrefetcher* prefetcher; ///< Optional read ahead on a separate thread.
   G4String                  fileName;
   G4String                  samplerName;
   G4bool                    removeUnstableWithoutDecay;
   G4bool                    warnAboutSkippedParticles;
   G4RotationMatrix          referenceBeamMomentumOffset;
+  BDSParticleCoordsFull     centralCoords; ///< Cache of reference coordinates from the bunch.
   
   /// Used for transiently loading information.
   std::vector<DisplacedVertex> vertices;
@@ -0,0 +1,75 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSSDIMPORTANCECELL_H
+#define BDSSDIMPORTANCECELL_H
+
+#include "globals.hh"
+#include "G4VSensitiveDetector.hh"
+
+#include <map>
+
+class G4HCofThisEvent;
+class G4ParticleDefinition;
+class G4Step;
+class G4TouchableHistory;
+class G4VPhysicalVolume;
+
+/**
+ * @brief Accumulate the weighted track length of one particle type in each importance cell.
+ *
+ * Attached to the cells of the importance sampling parallel world for a pilot run.
+ * The track length divided by the cell volume is an estimate of the flux in the
+ * cell, from which importance values can be calculated. No hits are made.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSSDImportanceCell: public G4VSensitiveDetector
+{
+public:
+  BDSSDImportanceCell(const G4String& name,
+                      const G4String& particleNameIn);
+  virtual ~BDSSDImportanceCell(){;}
+
+  virtual void Initialize(G4HCofThisEvent* /*HCE*/){;}
+  virtual G4bool ProcessHits(G4Step* step,
+                             G4TouchableHistory* th);
+
+  /// Sum of weight x step length in a cell. 0 if the cell was never reached.
+  G4double TrackLength(const G4VPhysicalVolume* cell) const;
+
+  /// Number of steps in a cell.
+  G4long NSteps(const G4VPhysicalVolume* cell) const;
+
+private:
+  BDSSDImportanceCell() = delete;
+
+  /// Statistics for one cell.
+  struct CellFlux
+  {
+    G4double trackLength = 0;
+    G4long   nSteps      = 0;
+  };
+
+  G4String particleName;
+  const G4ParticleDefinition* particle; ///< Found lazily as the particle table may not be ready.
+  std::map<const G4VPhysicalVolume*, CellFlux> cells;
+};
+
+#endif
@@ -0,0 +1,124 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSSAMPLEREVENTPREFETCHER_H
+#define BDSSAMPLEREVENTPREFETCHER_H
+
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A particle loaded from a sampler in a BDSIM output file.
+ *
+ * Plain data with no Geant4 particle definition so it may be prepared
+ * on any thread.
+ *
+ * @author Laurie Nevay
+ */
+
+struct BDSSamplerParticle
+{
+  G4int         pdgID;
+  G4ThreeVector momentum;      ///< Momentum in Geant4 units.
+  G4ThreeVector localPosition; ///< Local position in the sampler plane.
+  G4double      T;
+  G4double      weight;
+};
+
+/**
+ * @brief All the particles of one event loaded from a sampler.
+ *
+ * @author Laurie Nevay
+ */
+
+struct BDSSamplerEvent
+{
+  G4long index = 0;              ///< Index of the event in the file.
+  G4int  nParticlesFiltered = 0; ///< Number of particles already removed by filters.
+  std::vector<BDSSamplerParticle> particles;
+};
+
+/**
+ * @brief Load events from a file ahead of when they're required on a separate thread.
+ *
+ * A single worker thread calls the supplied loader function for consecutive event
+ * indices (wrapping around at the end of the file) and stores the results in a buffer
+ * of a fixed maximum number of events. Get() takes the next event from the buffer. If an
+ * event other than the next one is requested (e.g. to skip events or for recreation), the
+ * buffer is discarded and reading restarts from the requested index.
+ *
+ * The loader function must only use resources that are not used by any other thread
+ * while the prefetcher exists.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSSamplerEventPrefetcher
+{
+public:
+  typedef std::function<void(G4long, BDSSamplerEvent&)> Loader;
+
+  BDSSamplerEventPrefetcher(Loader       loaderIn,
+                            G4long       nEventsInFileIn,
+                            std::size_t  capacityIn,
+                            G4long       firstIndex = 0);
+  ~BDSSamplerEventPrefetcher();
+
+  BDSSamplerEventPrefetcher() = delete;
+  BDSSamplerEventPrefetcher(const BDSSamplerEventPrefetcher&) = delete;
+  BDSSamplerEventPrefetcher& operator=(const BDSSamplerEventPrefetcher&) = delete;
+
+  /// Get the event with a given index in the file. Waits for the worker if the
+  /// event isn't loaded yet. Any exception thrown by the loader is rethrown here.
+  void Get(G4long index, BDSSamplerEvent& event);
+
+private:
+  /// Start the worker thread reading from firstIndex.
+  void Start(G4long firstIndex);
+
+  /// Stop and join the worker thread and discard the buffer.
+  void Stop();
+
+  /// Worker thread loop.
+  void Run();
+
+  Loader      loader;
+  G4long      nEventsInFile;
+  std::size_t capacity;
+
+  std::deque<BDSSamplerEvent> buffer;
+  std::mutex                  mutex;
+  std::condition_variable     notFull;
+  std::condition_variable     notEmpty;
+  std::thread                 worker;
+  G4bool                      stopRequested;
+  G4long                      nextIndexToLoad; ///< Next index the worker will load.
+  G4long                      nextIndexExpected; ///< Index that will be at the front of the buffer.
+  std::exception_ptr          workerError;
+};
+
+#endif
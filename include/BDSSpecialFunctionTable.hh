@@ -0,0 +1,105 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSSPECIALFUNCTIONTABLE_H
+#define BDSSPECIALFUNCTIONTABLE_H
+
+#include "G4Types.hh"
+
+#include <cmath>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief A tabulated function of one variable with a bounded error.
+ *
+ * The function is evaluated on a uniform grid and interpolated with a cubic
+ * through the 4 nearest points. The number of points is doubled until the
+ * maximum absolute difference between the interpolation and the function,
+ * checked at 5 points between every pair of grid points, is below the requested
+ * tolerance. An exception is thrown if the tolerance can't be reached with the
+ * maximum number of points.
+ * Points outside the range are clamped to the edge of the table, so the caller
+ * should use InRange() if the function is needed outside it.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSSpecialFunctionTable
+{
+public:
+  typedef std::function<G4double(G4double)> Function;
+
+  BDSSpecialFunctionTable(const Function& function,
+                          G4double        xMinIn,
+                          G4double        xMaxIn,
+                          G4double        tolerance,
+                          G4int           nPointsInitial = 65,
+                          G4int           nPointsMaximum = 1048577);
+  ~BDSSpecialFunctionTable(){;}
+
+  BDSSpecialFunctionTable() = delete;
+
+  /// Interpolated value of the function.
+  inline G4double operator()(G4double x) const
+  {
+    G4double u = (x - xMin) * stepInverse;
+    G4int i = (G4int)std::floor(u);
+    // keep the 4 points inside the table - extrapolate at the ends
+    if (i < 1)
+      {i = 1;}
+    else if (i > nPoints - 3)
+      {i = nPoints - 3;}
+    G4double t = u - (G4double)i;
+    if (t < -1)
+      {t = -1;}
+    else if (t > 2)
+      {t = 2;}
+    // Lagrange cubic through the points i-1, i, i+1, i+2
+    G4double tp1 = t + 1;
+    G4double tm1 = t - 1;
+    G4double tm2 = t - 2;
+    const G4double* v = values.data() + i - 1;
+    return (-t*tm1*tm2*v[0] + 3*tp1*tm1*tm2*v[1] - 3*tp1*t*tm2*v[2] + tp1*t*tm1*v[3]) / 6.0;
+  }
+
+  /// Whether x is within the range of the table.
+  inline G4bool InRange(G4double x) const {return x >= xMin && x <= xMax;}
+
+  /// @{ Accessor.
+  G4double XMin()         const {return xMin;}
+  G4double XMax()         const {return xMax;}
+  G4int    NPoints()      const {return nPoints;}
+  G4double MaximumError() const {return maximumError;}
+  /// @}
+
+private:
+  /// Fill the table with a number of points and calculate the maximum error.
+  void Build(const Function& function,
+             G4int           nPointsIn);
+
+  G4double xMin;
+  G4double xMax;
+  G4int    nPoints;
+  G4double step;
+  G4double stepInverse;
+  G4double maximumError;
+  std::vector<G4double> values;
+};
+
+#endif
@@ -21,6 +21,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "G4Types.hh"
 
+class BDSSpecialFunctionTable;
+
 namespace BDS
 {
   /// Generalised Complete Elliptical Integral. This uses the algorithm for the
@@ -33,6 +35,26 @@ namespace BDS
                G4double c,
                G4double s,
                G4int nIterationLimit = 1000);
+
+  /// @{ Bessel function of the first kind.
+  G4double BesselJ0(G4double x);
+  G4double BesselJ1(G4double x);
+  /// @}
+
+  /// @{ Shared tables of J0 and J1 from 0 to the first zero of J0 (the range used in a
+  /// pill box cavity) with a maximum absolute error of tolerance. Built on first use for
+  /// each tolerance and never deleted. Thread safe.
+  const BDSSpecialFunctionTable* BesselJ0Table(G4double tolerance);
+  const BDSSpecialFunctionTable* BesselJ1Table(G4double tolerance);
+  /// @}
+
+  /// Shared table of CEL(kc, 1, 1, -1) for kc from CELRadialTableKcMinimum to 1 - the
+  /// form used for the radial field of a solenoid sheet. As above.
+  const BDSSpecialFunctionTable* CELRadialTable(G4double tolerance);
+  const G4double CELRadialTableKcMinimum = 0.01;
+
+  /// First zero of the Bessel function J0.
+  const G4double besselJ0FirstZero = 2.404825557695772768622;
 };
 
 #endif
@@ -25,8 +25,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <set>
 
+class BDSEventBudget;
 class BDSGlobalConstants;
+class BDSTrackKillRules;
+class BDSWeightWindowMesh;
 class G4Track;
+class G4VPhysicalVolume;
 
 /**
  * @brief BDSIM's Geant4 stacking action.
@@ -45,6 +49,20 @@ public:
   virtual void NewStage(); ///< We don't do anything here.
   virtual void PrepareNewEvent(); ///< We don't do anything here.
 
+  /// Set the (optional) weight windows used to roulette new tracks below their window. Not owned.
+  void SetWeightWindows(const BDSWeightWindowMesh* weightWindowsIn) {weightWindows = weightWindowsIn;}
+
+  /// Set the (optional) user defined rules for killing new tracks. Not owned.
+  void SetKillRules(BDSTrackKillRules* killRulesIn) {killRules = killRulesIn;}
+
+  /// Set the (optional) per-event budget. All new tracks are killed once an event is truncated. Not owned.
+  void SetEventBudget(const BDSEventBudget* eventBudgetIn) {eventBudget = eventBudgetIn;}
+
+  /// Record the energy of a track that is artificially killed in a volume as energy
+  /// deposition if the volume is sensitive, or else add it to energyKilled.
+  static void RecordKilledTrackEnergy(const G4Track* track,
+                                      G4VPhysicalVolume* pv);
+
   static G4double energyKilled;
 
 private:
@@ -56,6 +74,9 @@ private:
   G4long maxTracksPerEvent; ///< Maximum number of tracks before start killing.
   G4double minimumEK;
   std::set<G4int> particlesToExcludeFromCuts;
+  const BDSWeightWindowMesh* weightWindows;
+  BDSTrackKillRules* killRules;
+  const BDSEventBudget* eventBudget;
  };
 
 #endif
@@ -22,8 +22,18 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4UserSteppingAction.hh"
 #include "G4Types.hh"
 
+class BDSEventBudget;
+class BDSEventProfiler;
+class BDSTrackKillRules;
+class BDSWeightWindowMesh;
+
 /**
  * @brief Provide extra output for Geant4 through a verbose stepping action.
+ *
+ * Optionally, apply weight windows defined on a mesh - tracks above the window
+ * are split and tracks below it are subject to Russian roulette. Optionally, kill
+ * tracks entering a volume according to user defined rules. Optionally, count
+ * steps against a per-event budget and truncate the event when it's exceeded.
  */
 
 class BDSSteppingAction: public G4UserSteppingAction
@@ -39,13 +49,40 @@ public:
   /// for this step.
   virtual void UserSteppingAction(const G4Step* step);
 
+  /// Set the (optional) weight windows to apply at each step. Not owned.
+  void SetWeightWindows(const BDSWeightWindowMesh* weightWindowsIn) {weightWindows = weightWindowsIn;}
+
+  /// Set the (optional) user defined rules for killing tracks as they enter a volume. Not owned.
+  void SetKillRules(BDSTrackKillRules* killRulesIn) {killRules = killRulesIn;}
+
+  /// Set the (optional) step and CPU time budget for each event. Not owned.
+  void SetEventBudget(BDSEventBudget* eventBudgetIn) {eventBudget = eventBudgetIn;}
+
+  /// Set the (optional) profiler to count each step in. Not owned.
+  void SetEventProfiler(BDSEventProfiler* eventProfilerIn) {eventProfiler = eventProfilerIn;}
+
 private:
   /// The implementation of the print out.
   void VerboseSteppingAction(const G4Step* step);
+
+  /// Split or roulette the track according to the weight window at the post step point.
+  void ApplyWeightWindow(const G4Step* step);
+
+  /// Kill the track if it has entered a new volume and is selected by a kill rule.
+  void ApplyKillRules(const G4Step* step);
+
+  /// Kill the current track and all tracks waiting to be tracked in this event. Their
+  /// energy is recorded in the same way as tracks killed in the stacking action.
+  void TruncateEvent(const G4Step* step);
   
   const G4bool verboseStep;
   const G4bool verboseEventStart;
   const G4bool verboseEventStop;
+
+  const BDSWeightWindowMesh* weightWindows;
+  BDSTrackKillRules*         killRules;
+  BDSEventBudget*            eventBudget;
+  BDSEventProfiler*          eventProfiler;
 };
 
 #endif
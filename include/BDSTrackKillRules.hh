@@ -0,0 +1,90 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSTRACKKILLRULES_H
+#define BDSTRACKKILLRULES_H
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <set>
+#include <vector>
+
+class BDSAuxiliaryNavigator;
+class G4Region;
+class G4Track;
+class G4VPhysicalVolume;
+
+namespace GMAD
+{
+  class KillRule;
+}
+
+/**
+ * @brief A set of user defined rules for killing tracks to save tracking time.
+ *
+ * Each rule selects tracks by particle, kinetic energy, range in S along the main beam line,
+ * beam line element and region. A condition that isn't specified selects all tracks. The
+ * first rule that selects a track is counted for it. The cheap conditions are checked first
+ * and the S position and beam line element are only found if required.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSTrackKillRules
+{
+public:
+  explicit BDSTrackKillRules(const std::vector<GMAD::KillRule>& parserRules);
+  ~BDSTrackKillRules();
+
+  /// Index of the first rule that selects a track in a given volume, or -1 if none.
+  G4int Match(const G4Track* track, G4VPhysicalVolume* pv) const;
+
+  /// Count a track killed by a rule.
+  void RecordKill(G4int ruleIndex, const G4Track* track);
+
+  /// Print the number of tracks and energy killed by each rule.
+  void PrintSummary() const;
+
+private:
+  BDSTrackKillRules() = delete;
+
+  struct Rule
+  {
+    G4String        name;
+    std::set<G4int> pdgIDs;          ///< Empty for all particles.
+    G4double        kineticEnergy;   ///< Tracks below this are selected - 0 for any energy.
+    G4bool          useS;
+    G4double        sBegin;
+    G4double        sEnd;
+    std::set<G4String> elements;     ///< Empty for all beam line elements.
+    const G4Region* region;          ///< nullptr for all regions.
+    G4bool          secondariesOnly;
+    G4long          nKilled;
+    G4double        energyKilled;
+  };
+
+  /// Find the S position and beam line element name for a track. Returns false if
+  /// the track isn't inside the curvilinear world of the main beam line.
+  G4bool Locate(const G4Track* track, G4double& s, G4String& element) const;
+
+  std::vector<Rule>      rules;
+  BDSAuxiliaryNavigator* auxNavigator;
+};
+
+#endif
@@ -0,0 +1,70 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSTRACKINGACTIONPRIMARYONLY_H
+#define BDSTRACKINGACTIONPRIMARYONLY_H
+
+#include "BDSTrajectoryOptions.hh"
+
+#include "G4Types.hh"
+#include "G4UserTrackingAction.hh"
+
+#include <set>
+
+class BDSEventAction;
+class G4LogicalVolume;
+class G4Track;
+
+/**
+ * @brief Minimal tracking action for when only primaries are tracked.
+ *
+ * Used with the option trackPrimariesOnly in batch mode. Only a BDSTrajectoryPrimary
+ * without trajectory points is made for each primary, so only the first hit and last
+ * point are stored. No trajectory is made for any other track and there is no verbose
+ * stepping control.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSTrackingActionPrimaryOnly: public G4UserTrackingAction
+{
+public:
+  BDSTrackingActionPrimaryOnly(const BDS::TrajectoryOptions& storeTrajectoryOptionsIn,
+                               BDSEventAction* eventActionIn);
+  virtual ~BDSTrackingActionPrimaryOnly(){;}
+
+  /// Make a primary trajectory for primaries only.
+  virtual void PreUserTrackingAction(const G4Track* track);
+
+  /// Detect whether a primary ended in a collimator.
+  virtual void PostUserTrackingAction(const G4Track* track);
+
+private:
+  /// No default constructor required.
+  BDSTrackingActionPrimaryOnly() = delete;
+
+  const BDS::TrajectoryOptions storeTrajectoryOptions; ///< Cache of trajectory options.
+
+  /// Cache of event action to communicate whether a primary stopped in a collimator or not.
+  BDSEventAction* eventAction;
+
+  /// Cache of the set of collimator volumes. The set is filled when the geometry is built.
+  std::set<G4LogicalVolume*>* collimators;
+};
+
+#endif
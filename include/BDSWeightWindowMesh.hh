@@ -0,0 +1,112 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSWEIGHTWINDOWMESH_H
+#define BDSWEIGHTWINDOWMESH_H
+
+#include "G4String.hh"
+#include "G4ThreeVector.hh"
+#include "G4Transform3D.hh"
+#include "G4Types.hh"
+
+#include <vector>
+
+class BDSScorerMeshInfo;
+
+/**
+ * @brief Weight windows defined on a box or cylindrical mesh independent of the geometry.
+ *
+ * The mesh is the same as a scoring mesh and is defined by a parser scorermesh. Each cell
+ * of the mesh and energy group (the energy bins of the mesh) has a lower weight bound loaded
+ * from a file. The upper bound and the weight given to tracks surviving Russian roulette are
+ * fixed multiples of the lower bound. A lower bound of 0 means there is no window for that
+ * cell and energy group.
+ *
+ * The file is ASCII with one line per cell: the 3 cell indices (x, y, z for a box or r, phi, z
+ * for a cylinder, counting from 0) followed by the lower bound for each energy group. Lines
+ * starting with '#' are ignored. Cells not in the file have no window.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSWeightWindowMesh
+{
+public:
+  BDSWeightWindowMesh(const BDSScorerMeshInfo& recipe,
+                      const G4Transform3D&     placement,
+                      const G4String&          windowFileName,
+                      G4double                 upperRatioIn,
+                      G4double                 survivalRatioIn,
+                      G4int                    maximumSplitIn);
+  ~BDSWeightWindowMesh(){;}
+
+  /// Lower weight bound for a global position and kinetic energy. 0 if outside the
+  /// mesh or there is no window for that cell and energy group.
+  G4double LowerBound(const G4ThreeVector& globalPosition,
+                      G4double             kineticEnergy) const;
+
+  /// Number of tracks (including the original) a track of weight should be split into to
+  /// bring it below the upper bound given the lower bound. 1 means no splitting.
+  G4int NSplit(G4double weight, G4double lowerBound) const;
+
+  /// @{ Accessor.
+  inline G4double UpperBound(G4double lowerBound)    const {return upperRatio * lowerBound;}
+  inline G4double SurvivalWeight(G4double lowerBound) const {return survivalRatio * lowerBound;}
+  inline G4int    MaximumSplit() const {return maximumSplit;}
+  /// @}
+
+private:
+  BDSWeightWindowMesh() = delete;
+
+  /// Load the lower bounds from the file.
+  void Load(const G4String& fileName);
+
+  /// Index of the cell in the lowerBounds vector for a local position. -1 if outside the mesh.
+  G4int CellIndex(const G4ThreeVector& localPosition) const;
+
+  /// Energy group for a kinetic energy. Energies outside the range are in the first or last group.
+  G4int EnergyGroup(G4double kineticEnergy) const;
+
+  G4String      name;
+  G4bool        cylindrical;
+  G4Transform3D globalToLocal;
+
+  /// @{ Number of bins for each mesh dimension. i, j, k are x, y, z or r, phi, z.
+  G4int nI;
+  G4int nJ;
+  G4int nK;
+  /// @}
+  /// @{ Lower edge and inverse bin width of each dimension.
+  G4double lowI;
+  G4double lowJ;
+  G4double lowK;
+  G4double invWidthI;
+  G4double invWidthJ;
+  G4double invWidthK;
+  /// @}
+
+  std::vector<G4double> energyEdges; ///< Edges of the energy groups - empty if only one group.
+  G4int                 nGroups;
+  std::vector<G4double> lowerBounds; ///< Lower bound for each cell and energy group.
+
+  G4double upperRatio;
+  G4double survivalRatio;
+  G4int    maximumSplit;
+};
+
+#endif
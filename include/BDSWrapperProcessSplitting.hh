@@ -0,0 +1,86 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSWRAPPERPROCESSSPLITTING_H
+#define BDSWRAPPERPROCESSSPLITTING_H
+#include "BDSPhysicsVectorLinear.hh"
+#include "BDSWrapperProcess.hh"
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <set>
+#include <vector>
+
+class G4Step;
+class G4Track;
+class G4VParticleChange;
+class G4VProcess;
+
+/**
+ * @brief Wrapper process to split the products of any process by resampling it.
+ *
+ * Wrap a process. Each group of products (a set of PDG IDs, or all products if
+ * the set is empty) has a splitting factor as a function of the parent kinetic
+ * energy. For a given interaction, the factor n for each group is evaluated and
+ * rounded to the nearest integer and the process post-step do-it is resampled up
+ * to N-1 times, where N is the largest factor. The resamples are done before the
+ * original interaction so that the parent final state returned is the original one.
+ * The original secondaries are always kept. The products of a group are kept from the first n-1 resamples only and
+ * every kept product of a group is weighted by w_i * 1/n. All other products of
+ * the resamples are deleted. As the process is resampled regardless of what was
+ * produced originally, the splitting is unbiased.
+ *
+ * A product matches the first group whose PDG IDs include it.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSWrapperProcessSplitting: public BDSWrapperProcess
+{
+public:
+  /// A group of products and their splitting factor vs parent kinetic energy.
+  struct ProductSplitting
+  {
+    G4String name;             ///< Name of the definition for feedback.
+    std::set<G4int> pdgIDs;    ///< PDG IDs to split - empty for all products.
+    BDSPhysicsVectorLinear factor;
+  };
+  
+  BDSWrapperProcessSplitting() = delete;
+  BDSWrapperProcessSplitting(G4VProcess* originalProcess,
+                             const std::vector<ProductSplitting>& productsIn);
+  virtual ~BDSWrapperProcessSplitting(){;}
+  
+  /// Do the splitting operation.
+  virtual G4VParticleChange* PostStepDoIt(const G4Track& track,
+                                          const G4Step& step);
+  
+  /// Number of times this wrapper has split an interaction.
+  inline G4long NSplitInteractions() const {return nSplitInteractions;}
+  
+private:
+  /// Index of the group of products a PDG ID belongs to or -1 if none.
+  G4int Group(G4int pdgID) const;
+  
+  std::vector<ProductSplitting> products;
+  std::vector<G4int> nSplit; ///< Cache of the splitting factor per group for the current interaction.
+  G4long nSplitInteractions;
+};
+
+#endif
@@ -171,6 +171,7 @@ void Beam::PublishMembers()
   publish("distrFileMatchLength", &Beam::distrFileMatchLength);
   publish("distrFileLoop",        &Beam::distrFileLoop);
   publish("distrFileLoopNTimes",  &Beam::distrFileLoopNTimes);
+  publish("distrFileIndexFile",   &Beam::distrFileIndexFile);
   publish("removeUnstableWithoutDecay", &Beam::removeUnstableWithoutDecay);
   publish("nlinesIgnore",         &Beam::nlinesIgnore);
   publish("nLinesIgnore",         &Beam::nlinesIgnore); // for consistency
@@ -310,6 +311,7 @@ void Beam::PublishMembers()
   publish("offsetSampleMean",      &Beam::offsetSampleMean);
 
   publish("eventGeneratorNEventsSkip", &Beam::eventGeneratorNEventsSkip);
+  publish("eventGeneratorPrefetchNEvents", &Beam::eventGeneratorPrefetchNEvents);
   publish("eventGeneratorMinX",      &Beam::eventGeneratorMinX);
   publish("eventGeneratorMaxX",      &Beam::eventGeneratorMaxX);
   publish("eventGeneratorMinY",      &Beam::eventGeneratorMinY);
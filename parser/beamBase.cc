@@ -42,6 +42,7 @@ BeamBase::BeamBase()
   distrFileMatchLength = true;
   distrFileLoop        = false;
   distrFileLoopNTimes  = 1;
+  distrFileIndexFile   = false;
   removeUnstableWithoutDecay = true;
   nlinesIgnore         = 0;
   nlinesSkip           = 0;
@@ -133,6 +134,7 @@ BeamBase::BeamBase()
   offsetSampleMean = false;
   
   eventGeneratorNEventsSkip = 0;
+  eventGeneratorPrefetchNEvents = 0;
   eventGeneratorMinX  = -1e6;
   eventGeneratorMaxX  =  1e6;
   eventGeneratorMinY  = -1e6;
@@ -55,6 +55,7 @@ namespace GMAD
       bool        distrFileMatchLength;
       bool        distrFileLoop;
       int         distrFileLoopNTimes;
+      bool        distrFileIndexFile; ///< Whether to use a sidecar index file of valid lines for userfile.
       bool        removeUnstableWithoutDecay;
       ///@}
       int         nlinesIgnore; ///< Ignore first lines in the input bunch file.
@@ -141,6 +142,7 @@ namespace GMAD
 
       /// @{ Event generator file filter.
       int    eventGeneratorNEventsSkip;
+      int    eventGeneratorPrefetchNEvents;
       double eventGeneratorMinX;
       double eventGeneratorMaxX;
       double eventGeneratorMinY;
@@ -0,0 +1,64 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "killrule.h"
+
+using namespace GMAD;
+
+KillRule::KillRule()
+{
+  clear();
+  PublishMembers();
+}
+
+void KillRule::clear()
+{
+  name = "";
+  particles = "";
+  kineticEnergy = 0;
+  sBegin = 0;
+  sEnd = 0;
+  elements = "";
+  region = "";
+  secondariesOnly = true;
+}
+
+void KillRule::PublishMembers()
+{
+  publish("name",            &KillRule::name);
+  publish("particles",       &KillRule::particles);
+  publish("kineticEnergy",   &KillRule::kineticEnergy);
+  publish("sBegin",          &KillRule::sBegin);
+  publish("sEnd",            &KillRule::sEnd);
+  publish("elements",        &KillRule::elements);
+  publish("region",          &KillRule::region);
+  publish("secondariesOnly", &KillRule::secondariesOnly);
+}
+
+void KillRule::print()const
+{
+  std::cout << "killrule: "
+	    << "name "            << name            << std::endl
+	    << "particles "       << particles       << std::endl
+	    << "kineticEnergy "   << kineticEnergy   << std::endl
+	    << "sBegin "          << sBegin          << std::endl
+	    << "sEnd "            << sEnd            << std::endl
+	    << "elements "        << elements        << std::endl
+	    << "region "          << region          << std::endl
+	    << "secondariesOnly " << secondariesOnly << std::endl;
+}
@@ -0,0 +1,80 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef KILLRULE_H
+#define KILLRULE_H
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "published.h"
+
+namespace GMAD
+{
+  /**
+   * @brief Rule for killing tracks to reduce tracking time.
+   * 
+   * @author Laurie Nevay
+   */
+  
+  class KillRule: public Published<KillRule>
+  {
+  public:
+    std::string name;
+    std::string particles;  ///< White space separated PDG IDs - empty for all particles.
+    double kineticEnergy;   ///< Tracks below this kinetic energy (GeV) are killed - 0 for any energy.
+    double sBegin;          ///< Start of range in S (m) along the main beam line.
+    double sEnd;            ///< End of range in S (m) - no S range if not greater than sBegin.
+    std::string elements;   ///< White space separated beam line element names.
+    std::string region;     ///< Name of region.
+    bool   secondariesOnly; ///< Whether to leave primaries alone.
+    
+    /// Constructor
+    KillRule();
+    /// Reset
+    void clear();
+    /// Print some properties
+    void print()const;
+    /// Set methods by property name and value
+    template <typename T>
+    void set_value(std::string property, T value);
+
+  private:
+    /// publish members
+    void PublishMembers();
+  };
+  
+  template <typename T>
+  void KillRule::set_value(std::string property, T value)
+  {
+#ifdef BDSDEBUG
+    std::cout << "killrule> setting value " << std::setw(25) << std::left << property << value << std::endl;
+#endif
+    // member method can throw runtime_error, catch and exit gracefully
+    try
+      {set(this,property,value);}
+    catch(const std::runtime_error&)
+      {
+        std::cerr << "Error: killrule> unknown parameter \"" << property << "\" with value " << value  << std::endl;
+        exit(1);
+      }
+  }
+}
+
+#endif
@@ -221,6 +221,7 @@ void Options::PublishMembers()
   publish("physicsEnergyLimitHigh",         &Options::physicsEnergyLimitHigh);
   publish("g4PhysicsUseBDSIMRangeCuts",     &Options::g4PhysicsUseBDSIMRangeCuts);
   publish("g4PhysicsUseBDSIMCutsAndLimits", &Options::g4PhysicsUseBDSIMCutsAndLimits);
+  publish("physicsTableCacheDir",           &Options::physicsTableCacheDir);
 
   // reproducibility
   publish("eventOffset",       &Options::eventOffset);
@@ -263,6 +264,7 @@ void Options::PublishMembers()
   publish("scalingFieldOuter",    &Options::scalingFieldOuter);
   publish("integrateKineticEnergyAlongBeamline", &Options::integrateKineticEnergyAlongBeamline);
   publish("cavityFieldType",      &Options::cavityFieldType);
+  publish("specialFunctionTolerance", &Options::specialFunctionTolerance);
   publish("includeFringeFields",  &Options::includeFringeFields);
   publish("includeFringeFieldsCavities", &Options::includeFringeFieldsCavities);
   publish("beampipeRadius",       &Options::aper1);
@@ -280,7 +282,13 @@ void Options::PublishMembers()
   publish("worldGeometryFile",    &Options::worldGeometryFile);
   publish("autoColourWorldGeometryFile",    &Options::autoColourWorldGeometryFile);
   publish("importanceWorldGeometryFile",    &Options::importanceWorldGeometryFile);
-  publish("importanceVolumeMap",  &Options::importanceVolumeMap);
+  publish("importanceVolumeMap",            &Options::importanceVolumeMap);
+  publish("importanceVolumeMapOutput",      &Options::importanceVolumeMapOutput);
+  publish("weightWindowMesh",               &Options::weightWindowMesh);
+  publish("weightWindowFile",               &Options::weightWindowFile);
+  publish("weightWindowUpperRatio",         &Options::weightWindowUpperRatio);
+  publish("weightWindowSurvivalRatio",      &Options::weightWindowSurvivalRatio);
+  publish("weightWindowMaximumSplit",       &Options::weightWindowMaximumSplit);
   publish("worldVolumeMargin",    &Options::worldVolumeMargin);
   publish("dontSplitSBends",      &Options::dontSplitSBends);
   publish("thinElementLength",    &Options::thinElementLength);
@@ -326,6 +334,8 @@ void Options::PublishMembers()
   publish("maximumPhotonsPerStep",       &Options::maximumPhotonsPerStep);
   publish("maximumBetaChangePerStep",    &Options::maximumBetaChangePerStep);
   publish("maximumTracksPerEvent",       &Options::maximumTracksPerEvent);
+  publish("maximumStepsPerEvent",        &Options::maximumStepsPerEvent);
+  publish("maximumCPUTimePerEvent",      &Options::maximumCPUTimePerEvent);
   publish("minimumKineticEnergy",        &Options::minimumKineticEnergy);
   publish("minimumKineticEnergyTunnel",  &Options::minimumKineticEnergyTunnel);
   publish("minimumRange",                &Options::minimumRange);
@@ -367,6 +377,9 @@ void Options::PublishMembers()
   // options which influence tracking
   publish("integratorSet",            &Options::integratorSet);
   publish("fieldModulator",           &Options::fieldModulator);
+  publish("fieldAutoScaleCacheFile",  &Options::fieldAutoScaleCacheFile);
+  publish("fieldMapStorageType",      &Options::fieldMapStorageType);
+  publish("fieldMapLayout",           &Options::fieldMapLayout);
   publish("lengthSafety",             &Options::lengthSafety);
   publish("lengthSafetyLarge",        &Options::lengthSafetyLarge);
   publish("maximumTrackingTime",      &Options::maximumTrackingTime);
@@ -390,6 +403,9 @@ void Options::PublishMembers()
   publish("teleporterFullTransform",  &Options::teleporterFullTransform);
   publish("dEThresholdForScattering", &Options::dEThresholdForScattering);
   publish("backupStepperMomLimit",    &Options::backupStepperMomLimit);
+  publish("fastTransportPrimaries",   &Options::fastTransportPrimaries);
+  publish("fastTransportBatchSize",   &Options::fastTransportBatchSize);
+  publish("trackPrimariesOnly",       &Options::trackPrimariesOnly);
 
   // hit generation
   publish("sensitiveOuter",              &Options::sensitiveOuter);
@@ -455,6 +471,7 @@ void Options::PublishMembers()
   publish("storeELossModelID",              &Options::storeElossModelID);
   publish("storeElossPhysicsProcesses",     &Options::storeElossPhysicsProcesses);
   publish("storeELossPhysicsProcesses",     &Options::storeElossPhysicsProcesses);
+  publish("storeEventProfile",              &Options::storeEventProfile);
   publish("storeParticleData",              &Options::storeParticleData);
   publish("storeGeant4Data",                &Options::storeParticleData); // backwards compatibility
   publish("storePrimaries",                 &Options::storePrimaries);
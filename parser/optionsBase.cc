@@ -92,6 +92,7 @@ OptionsBase::OptionsBase()
   physicsEnergyLimitHigh         = 0;
   g4PhysicsUseBDSIMRangeCuts     = true;
   g4PhysicsUseBDSIMCutsAndLimits = true;
+  physicsTableCacheDir           = "";
   
   eventOffset           = 0;
   recreateSeedState     = true;
@@ -148,6 +149,7 @@ OptionsBase::OptionsBase()
   integrateKineticEnergyAlongBeamline = true;
   
   cavityFieldType = "constantinz";
+  specialFunctionTolerance = 0;
   
   // beam pipe / aperture
   beampipeThickness    = 0.0025;
@@ -166,6 +168,12 @@ OptionsBase::OptionsBase()
   autoColourWorldGeometryFile = true;
   importanceWorldGeometryFile = "";
   importanceVolumeMap  = "";
+  importanceVolumeMapOutput = "";
+  weightWindowMesh          = "";
+  weightWindowFile          = "";
+  weightWindowUpperRatio    = 5;
+  weightWindowSurvivalRatio = 3;
+  weightWindowMaximumSplit  = 5;
   worldVolumeMargin = 5; //m
 
   vacuumPressure       = 1e-12;
@@ -202,6 +210,8 @@ OptionsBase::OptionsBase()
   maximumPhotonsPerStep    = -1;  ///< -1 -> no action taken (could want 0)
   maximumBetaChangePerStep = 10;
   maximumTracksPerEvent    = 0;   ///< 0 -> no action taken
+  maximumStepsPerEvent     = 0;   ///< 0 -> no action taken
+  maximumCPUTimePerEvent   = 0;   ///< 0 -> no action taken
   minimumKineticEnergy     = 0;
   minimumKineticEnergyTunnel = 0;
   minimumRange             = 0;
@@ -243,6 +253,9 @@ OptionsBase::OptionsBase()
   // tracking options
   integratorSet            = "bdsimmatrix";
   fieldModulator           = "";
+  fieldAutoScaleCacheFile  = "";
+  fieldMapStorageType      = "full";
+  fieldMapLayout           = "linear";
   lengthSafety             = 1e-9;   // be very careful adjusting this as it affects all the geometry
   lengthSafetyLarge        = 1e-6;   // be very careful adjusting this as it affects all the geometry
   maximumTrackingTime      = -1;      // s, nonsensical - used for testing
@@ -256,6 +269,9 @@ OptionsBase::OptionsBase()
   teleporterFullTransform  = true;
   dEThresholdForScattering = 1e-11; // GeV
   backupStepperMomLimit    = 0.1;   // fraction of unit momentum
+  fastTransportPrimaries   = false;
+  fastTransportBatchSize   = 1;
+  trackPrimariesOnly       = false;
 
   // default value in Geant4, old value 0 - error must be greater than this
   minimumEpsilonStep       = 1e-12;   // used to be 1e-25 but since v11.1 this has to be greater than double precision
@@ -308,6 +324,7 @@ OptionsBase::OptionsBase()
   storeElossPreStepKineticEnergy = false;
   storeElossModelID          = false;
   storeElossPhysicsProcesses = false;
+  storeEventProfile          = false;
   storeParticleData          = true;
   storePrimaries             = true;
   storePrimaryHistograms     = true;
@@ -120,6 +120,7 @@ namespace GMAD
     double      physicsEnergyLimitHigh;
     bool        g4PhysicsUseBDSIMRangeCuts;
     bool        g4PhysicsUseBDSIMCutsAndLimits;
+    std::string physicsTableCacheDir; ///< Directory to store and retrieve physics tables in.
     
     int eventOffset;  ///< Event number to start from when recreating from a root file.
     bool recreateSeedState; ///< Load seed state when recreating events.
@@ -177,6 +178,7 @@ namespace GMAD
     bool      integrateKineticEnergyAlongBeamline;
     
     std::string cavityFieldType;
+    double      specialFunctionTolerance;
 
     bool        includeFringeFields;
     bool        includeFringeFieldsCavities;
@@ -199,6 +201,12 @@ namespace GMAD
     bool        autoColourWorldGeometryFile;
     std::string importanceWorldGeometryFile;
     std::string importanceVolumeMap;
+    std::string importanceVolumeMapOutput; ///< Importance map file to write from a pilot run.
+    std::string weightWindowMesh;          ///< Name of scorer mesh whose cells are the weight windows.
+    std::string weightWindowFile;          ///< Lower weight bound for each mesh cell and energy group.
+    double      weightWindowUpperRatio;    ///< Upper bound of window as a multiple of the lower bound.
+    double      weightWindowSurvivalRatio; ///< Weight after roulette as a multiple of the lower bound.
+    int         weightWindowMaximumSplit;  ///< Maximum number of tracks one track may be split into.
     // see verboseImportance
 
     double    worldVolumeMargin; ///< Padding margin for world volume size.
@@ -241,6 +249,8 @@ namespace GMAD
     int      maximumPhotonsPerStep;
     int      maximumBetaChangePerStep;
     long     maximumTracksPerEvent;
+    long     maximumStepsPerEvent;   ///< Maximum number of steps before an event is truncated.
+    double   maximumCPUTimePerEvent; ///< Maximum CPU time [s] before an event is truncated.
     double   minimumKineticEnergy;
     double   minimumKineticEnergyTunnel;
     double   minimumRange;
@@ -283,6 +293,9 @@ namespace GMAD
     // tracking related parameters
     std::string integratorSet;
     std::string fieldModulator;
+    std::string fieldAutoScaleCacheFile; ///< File to store field map autoScale strengths in.
+    std::string fieldMapStorageType;     ///< How field map values are stored in memory.
+    std::string fieldMapLayout;          ///< Order of field map values in memory.
     double   lengthSafety;
     double   lengthSafetyLarge;
     double   maximumTrackingTime; ///< Maximum tracking time per track [s].
@@ -305,6 +318,9 @@ namespace GMAD
     bool     teleporterFullTransform;     ///< Whether to use the new Transform3D method for the teleporter.
     double   dEThresholdForScattering;
     double   backupStepperMomLimit;    ///< Fractional momentum limit for reverting to backup steppers.
+    bool     fastTransportPrimaries;   ///< Transport primaries analytically through the initial vacuum elements.
+    int      fastTransportBatchSize;   ///< Number of primaries generated and transported together.
+    bool     trackPrimariesOnly;       ///< Minimal user actions to track only primaries.
 
     // hit generation - only two parts that go in the same collection / branch
     bool      sensitiveOuter;
@@ -346,6 +362,7 @@ namespace GMAD
     bool        storeElossPreStepKineticEnergy;
     bool        storeElossModelID;
     bool        storeElossPhysicsProcesses;
+    bool        storeEventProfile;
     bool        storeParticleData;
     bool        storePrimaries;
     bool        storePrimaryHistograms;
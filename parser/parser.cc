@@ -66,6 +66,8 @@ namespace GMAD {
   template void Parser::Add<CavityModel, FastList<CavityModel> >(bool unique, const std::string& className);
   template void Parser::Add<BLMPlacement, FastList<BLMPlacement> >(bool unique, const std::string& className);
   template void Parser::Add<Modulator, FastList<Modulator> >(bool unique, const std::string& className);
+  template void Parser::Add<KillRule, FastList<KillRule> >(bool unique, const std::string& className);
+  template void Parser::Add<ProcessSplitting, FastList<ProcessSplitting> >(bool unique, const std::string& className);
   template void Parser::Add<SamplerPlacement, FastList<SamplerPlacement> >(bool unique, const std::string& className);
   template void Parser::Add<Atom, FastList<Atom> >(bool unique, const std::string& className);
   template void Parser::Add<Field, FastList<Field> >(bool unique, const std::string& className);
@@ -742,7 +744,8 @@ void Parser::Overwrite(const std::string& objectName)
 
   // possible object types are:
   // element, atom, colour, crystal, coolingchannel, field, material, physicsbiasing, placement,
-  // query, region, tunnel, cavitymodel, samplerplacement, aperture, scorer, scorermesh, blm
+  // query, region, tunnel, cavitymodel, samplerplacement, aperture, scorer, scorermesh, blm,
+  // modulator, killrule, processsplitting
   bool extended = false;
   auto element_it = element_list.find(objectName);
   if (element_it != element_list.end())
@@ -778,6 +781,8 @@ void Parser::Overwrite(const std::string& objectName)
     else if ( (extended = FindAndExtend<Aperture>   (objectName)) ) {}
     else if ( (extended = FindAndExtend<BLMPlacement> (objectName)) ) {}
     else if ( (extended = FindAndExtend<Modulator>  (objectName)) ) {}
+    else if ( (extended = FindAndExtend<KillRule>   (objectName)) ) {}
+    else if ( (extended = FindAndExtend<ProcessSplitting>(objectName)) ) {}
   }
 
   if (!extended)
@@ -901,6 +906,12 @@ bool Parser::TryPrintingObject(const std::string& objectName) const
   auto searchModulator = std::find_if(modulator_list.begin(), modulator_list.end(), [&on](const Modulator& obj) {return obj.name == on;});
   if (searchModulator != modulator_list.end())
     {searchModulator->print(); return true;}
+  auto searchKillRule = std::find_if(killrule_list.begin(), killrule_list.end(), [&on](const KillRule& obj) {return obj.name == on;});
+  if (searchKillRule != killrule_list.end())
+    {searchKillRule->print(); return true;}
+  auto searchProcessSplitting = std::find_if(processsplitting_list.begin(), processsplitting_list.end(), [&on](const ProcessSplitting& obj) {return obj.name == on;});
+  if (searchProcessSplitting != processsplitting_list.end())
+    {searchProcessSplitting->print(); return true;}
   
   return false;
 }
@@ -1024,6 +1035,18 @@ namespace GMAD {
   template<>
   FastList<Modulator>& Parser::GetList<Modulator>() {return modulator_list;}
 
+  template<>
+  KillRule& Parser::GetGlobal() {return killrule;}
+
+  template<>
+  FastList<KillRule>& Parser::GetList<KillRule>() {return killrule_list;}
+
+  template<>
+  ProcessSplitting& Parser::GetGlobal() {return processsplitting;}
+
+  template<>
+  FastList<ProcessSplitting>& Parser::GetList<ProcessSplitting>() {return processsplitting_list;}
+
   template<>
   Aperture& Parser::GetGlobal() {return aperture;}
 
@@ -36,6 +36,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "element.h"
 #include "elementtype.h"
 #include "field.h"
+#include "killrule.h"
+#include "processsplitting.h"
 #include "fastlist.h"
 #include "material.h"
 #include "modulator.h"
@@ -249,6 +251,8 @@ namespace GMAD
     FastList<Aperture> aperture_list;
     FastList<BLMPlacement> blm_list;
     FastList<Modulator> modulator_list;
+    FastList<KillRule> killrule_list;
+    FastList<ProcessSplitting> processsplitting_list;
     /// @}
 
   private:
@@ -285,6 +289,8 @@ namespace GMAD
     Aperture aperture;
     BLMPlacement blm;
     Modulator modulator;
+    KillRule killrule;
+    ProcessSplitting processsplitting;
     /// @}
     
     /// Find object by name in list
@@ -96,7 +96,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 %token <ival> VKICKER HKICKER KICKER TKICKER THINRMATRIX PARALLELTRANSPORTER
 %token <ival> RMATRIX UNDULATOR USERCOMPONENT DUMP CT TARGET RFX RFY MUONCOOLER
 %token ALL ATOM MATERIAL PERIOD XSECBIAS REGION PLACEMENT NEWCOLOUR SAMPLERPLACEMENT
-%token SCORER SCORERMESH BLM MODULATOR
+%token SCORER SCORERMESH BLM MODULATOR KILLRULE PROCESSSPLITTING
 %token CRYSTAL FIELD CAVITYMODEL QUERY TUNNEL APERTURE COOLINGCHANNEL
 %token BEAM OPTION PRINT RANGE STOP USE SAMPLE CSAMPLE
 %token IF ELSE BEGN END LE GE NE EQ FOR
@@ -283,6 +283,22 @@ decl : VARIABLE ':' component_with_params
              Parser::Instance()->Add<Modulator>(true, "modulator");
          }
      }
+     | VARIABLE ':' killrule
+     {
+         if(execute) {
+             if(ECHO_GRAMMAR) std::cout << "decl -> VARIABLE " << *($1) << " : killrule" << std::endl;
+             Parser::Instance()->SetValue<KillRule>("name", *($1));
+             Parser::Instance()->Add<KillRule>(true, "killrule");
+         }
+     }
+     | VARIABLE ':' processsplitting
+     {
+         if(execute) {
+             if(ECHO_GRAMMAR) std::cout << "decl -> VARIABLE " << *($1) << " : processsplitting" << std::endl;
+             Parser::Instance()->SetValue<ProcessSplitting>("name", *($1));
+             Parser::Instance()->Add<ProcessSplitting>(true, "processsplitting");
+         }
+     }
      | VARIABLE ':' query
      {
          if(execute) {
@@ -434,6 +450,8 @@ scorermesh  : SCORERMESH  ',' scorermesh_options
 aperture    : APERTURE    ',' aperture_options
 blm         : BLM         ',' blm_options
 modulator   : MODULATOR   ',' modulator_options
+killrule    : KILLRULE    ',' killrule_options
+processsplitting : PROCESSSPLITTING ',' processsplitting_options
 
 // every object needs parameters
 object_noparams : MATERIAL
@@ -454,6 +472,8 @@ object_noparams : MATERIAL
                 | APERTURE
                 | BLM
                 | MODULATOR
+                | KILLRULE
+                | PROCESSSPLITTING
 
 newinstance : VARIABLE ',' parameters
             {
@@ -922,6 +942,22 @@ command : STOP         { if(execute) Parser::Instance()->quit(); }
               Parser::Instance()->Add<Modulator>(true, "modulator");
             }
         }
+        | KILLRULE ',' killrule_options // killrule
+        {
+          if(execute)
+            {
+              if(ECHO_GRAMMAR) std::cout << "command -> KILLRULE" << std::endl;
+              Parser::Instance()->Add<KillRule>(true, "killrule");
+            }
+        }
+        | PROCESSSPLITTING ',' processsplitting_options // processsplitting
+        {
+          if(execute)
+            {
+              if(ECHO_GRAMMAR) std::cout << "command -> PROCESSSPLITTING" << std::endl;
+              Parser::Instance()->Add<ProcessSplitting>(true, "processsplitting");
+            }
+        }
         | NEWCOLOUR ',' colour_options // colour
         {
           if(execute)
@@ -1165,6 +1201,24 @@ modulator_options : paramassign '=' aexpr modulator_options_extend
                   | paramassign '=' string modulator_options_extend
                     { if(execute) Parser::Instance()->SetValue<Modulator>(*$1,*$3);}
 
+killrule_options_extend : /* nothing */
+                        | ',' killrule_options
+
+killrule_options : paramassign '=' aexpr killrule_options_extend
+                   { if(execute) Parser::Instance()->SetValue<KillRule>((*$1),$3);}
+                 | paramassign '=' string killrule_options_extend
+                   { if(execute) Parser::Instance()->SetValue<KillRule>(*$1,*$3);}
+
+processsplitting_options_extend : /* nothing */
+                                | ',' processsplitting_options
+
+processsplitting_options : paramassign '=' aexpr processsplitting_options_extend
+                           { if(execute) Parser::Instance()->SetValue<ProcessSplitting>((*$1),$3);}
+                         | paramassign '=' string processsplitting_options_extend
+                           { if(execute) Parser::Instance()->SetValue<ProcessSplitting>(*$1,*$3);}
+                         | paramassign '=' vecexpr processsplitting_options_extend
+                           { if(execute) Parser::Instance()->SetValue<ProcessSplitting>(*($1),$3);}
+
 query_options_extend : /* nothing */
                      | ',' query_options
 
@@ -0,0 +1,63 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "processsplitting.h"
+
+using namespace GMAD;
+
+ProcessSplitting::ProcessSplitting()
+{
+  clear();
+  PublishMembers();
+}
+
+void ProcessSplitting::clear()
+{
+  name = "";
+  particle = "";
+  process = "";
+  products = "";
+  kineticEnergy.clear();
+  factor.clear();
+}
+
+void ProcessSplitting::PublishMembers()
+{
+  publish("name",          &ProcessSplitting::name);
+  publish("particle",      &ProcessSplitting::particle);
+  publish("process",       &ProcessSplitting::process);
+  publish("products",      &ProcessSplitting::products);
+  publish("kineticEnergy", &ProcessSplitting::kineticEnergy);
+  publish("factor",        &ProcessSplitting::factor);
+}
+
+void ProcessSplitting::print()const
+{
+  std::cout << "processsplitting: "
+	    << "name "     << name     << std::endl
+	    << "particle " << particle << std::endl
+	    << "process "  << process  << std::endl
+	    << "products " << products << std::endl
+	    << "kineticEnergy ";
+  for (const auto& v : kineticEnergy)
+    {std::cout << v << " ";}
+  std::cout << std::endl << "factor ";
+  for (const auto& v : factor)
+    {std::cout << v << " ";}
+  std::cout << std::endl;
+}
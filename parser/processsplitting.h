@@ -0,0 +1,79 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef PROCESSSPLITTING_H
+#define PROCESSSPLITTING_H
+
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <string>
+
+#include "published.h"
+
+namespace GMAD
+{
+  /**
+   * @brief Splitting of the products of a physics process for parser.
+   * 
+   * @author Laurie Nevay
+   */
+  
+  class ProcessSplitting: public Published<ProcessSplitting>
+  {
+  public:
+    std::string name;
+    std::string particle;             ///< Parent particle name(s) separated by white space.
+    std::string process;              ///< Process name(s) separated by white space.
+    std::string products;             ///< PDG IDs of products to split separated by white space - empty for all.
+    std::list<double> kineticEnergy;  ///< Parent kinetic energies (GeV) the factors are given at.
+    std::list<double> factor;         ///< Splitting factor at each parent kinetic energy.
+    
+    /// Constructor
+    ProcessSplitting();
+    /// Reset
+    void clear();
+    /// Print some properties
+    void print()const;
+    /// Set methods by property name and value
+    template <typename T>
+    void set_value(std::string property, T value);
+
+  private:
+    /// publish members
+    void PublishMembers();
+  };
+  
+  template <typename T>
+  void ProcessSplitting::set_value(std::string property, T value)
+  {
+#ifdef BDSDEBUG
+    std::cout << "processsplitting> setting value " << std::setw(25) << std::left << property << value << std::endl;
+#endif
+    // member method can throw runtime_error, catch and exit gracefully
+    try
+      {set(this,property,value);}
+    catch(const std::runtime_error&)
+      {
+        std::cerr << "Error: processsplitting> unknown parameter \"" << property << "\" with value " << value  << std::endl;
+        exit(1);
+      }
+  }
+}
+
+#endif
@@ -74,14 +74,7 @@ void BDSArray3DCoords::ExtractSection2x2x2(G4double x,
   yFrac = yArrayCoords - y1;
   zFrac = zArrayCoords - z1;
   
-  for (G4int i = 0; i < 2; i++)
-    {
-      for (G4int j = 0; j < 2; j++)
-	{
-	  for (G4int k = 0; k < 2; k++)
-	    {localData[i][j][k] = GetConst(x1+i, y1+j, z1+k);}
-	}
-    }
+  ExtractCube(x1, y1, z1, 0, 2, &localData[0][0][0]);
 }
 
 void BDSArray3DCoords::ExtractSection4x4x4(G4double x,
@@ -101,16 +94,7 @@ void BDSArray3DCoords::ExtractSection4x4x4(G4double x,
   yFrac = yArrayCoords - y1;
   zFrac = zArrayCoords - z1;
   
-  for (G4int i = 0; i < 4; i++)
-    {
-      for (G4int j = 0; j < 4; j++)
-	{
-	  for (G4int k = 0; k < 4; k++)
-	    {
-	      localData[i][j][k] = GetConst(x1-1+i, y1-1+j, z1-1+k);
-	    }
-	}
-    }
+  ExtractCube(x1-1, y1-1, z1-1, 0, 4, &localData[0][0][0]);
 }
 
 BDSFieldValue BDSArray3DCoords::ExtractNearest(G4double x,
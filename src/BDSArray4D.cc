@@ -17,21 +17,112 @@ You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSArray4D.hh"
+#include "BDSArrayStorageType.hh"
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSFieldValue.hh"
 
 #include "globals.hh" // geant4 types / globals
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <string>
 #include <vector>
 
+namespace
+{
+  /// IEEE 754 binary16 from a float with rounding to nearest even.
+  uint16_t FloatToHalf(G4float value)
+  {
+    uint32_t f;
+    std::memcpy(&f, &value, sizeof(f));
+    uint32_t sign     = (f >> 16) & 0x8000u;
+    uint32_t exponent = (f >> 23) & 0xffu;
+    uint32_t mantissa = f & 0x7fffffu;
+    if (exponent == 0xffu) // inf or nan
+      {return (uint16_t)(sign | 0x7c00u | (mantissa ? 0x200u : 0u));}
+    G4int e = (G4int)exponent - 127 + 15;
+    if (e >= 31) // too large - inf
+      {return (uint16_t)(sign | 0x7c00u);}
+    if (e <= 0)
+      {// subnormal in half precision
+        if (e < -10)
+          {return (uint16_t)sign;}
+        mantissa |= 0x800000u; // implicit leading bit
+        uint32_t shift     = (uint32_t)(14 - e);
+        uint32_t result    = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway   = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (result & 1u)))
+          {result++;}
+        return (uint16_t)(sign | result);
+      }
+    uint32_t result    = sign | ((uint32_t)e << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1fffu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (result & 1u)))
+      {result++;} // a carry into the exponent is still correct
+    return (uint16_t)result;
+  }
+
+  G4float HalfToFloat(uint16_t h)
+  {
+    uint32_t sign     = (uint32_t)(h & 0x8000u) << 16;
+    uint32_t exponent = (h >> 10) & 0x1fu;
+    uint32_t mantissa = h & 0x3ffu;
+    uint32_t f;
+    if (exponent == 0x1fu)
+      {f = sign | 0x7f800000u | (mantissa << 13);}
+    else if (exponent != 0)
+      {f = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);}
+    else if (mantissa == 0)
+      {f = sign;}
+    else
+      {// subnormal - normalise
+        exponent = 127 - 15 + 1;
+        while (!(mantissa & 0x400u))
+          {mantissa <<= 1; exponent--;}
+        f = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+      }
+    G4float result;
+    std::memcpy(&result, &f, sizeof(result));
+    return result;
+  }
+
+  /// Upper 16 bits of a float with rounding to nearest even.
+  uint16_t FloatToBFloat16(G4float value)
+  {
+    uint32_t f;
+    std::memcpy(&f, &value, sizeof(f));
+    if ((f & 0x7fffffffu) > 0x7f800000u) // nan
+      {return (uint16_t)((f >> 16) | 0x40u);}
+    f += 0x7fffu + ((f >> 16) & 1u);
+    return (uint16_t)(f >> 16);
+  }
+
+  G4float BFloat16ToFloat(uint16_t b)
+  {
+    uint32_t f = (uint32_t)b << 16;
+    G4float result;
+    std::memcpy(&result, &f, sizeof(result));
+    return result;
+  }
+}
 
 BDSArray4D::BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn):
   nX(nXIn), nY(nYIn), nZ(nZIn), nT(nTIn),
   defaultValue(BDSFieldValue()),
-  data(std::vector<BDSFieldValue>(nTIn*nZIn*nYIn*nXIn))
+  data(std::vector<BDSFieldValue>(nTIn*nZIn*nYIn*nXIn)),
+  storageType(BDSArrayStorageType::full),
+  returnValue(BDSFieldValue()),
+  layout(BDSArrayLayoutType::linear),
+  bricked(false),
+  brickShiftX(0), brickShiftY(0), brickShiftZ(0), brickShift(0),
+  brickMaskX(0),  brickMaskY(0),  brickMaskZ(0),
+  nXBricks(nXIn), nYBricks(nYIn), nZBricks(nZIn)
 {;}
 
 BDSFieldValue& BDSArray4D::operator()(G4int x,
@@ -40,7 +131,9 @@ BDSFieldValue& BDSArray4D::operator()(G4int x,
 				      G4int t)
 {
   OutsideWarn(x,y,z,t); // keep as a warning as can't assign to invalid index
-  return data[t*nZ*nY*nX + z*nY*nX + y*nX + x];
+  if (storageType != BDSArrayStorageType::full)
+    {throw BDSException(__METHOD_NAME__, "values cannot be set once converted to \"" + storageType.ToString() + "\" storage");}
+  return data[Index(x,y,z,t)];
 }
 
 const BDSFieldValue& BDSArray4D::GetConst(G4int x,
@@ -50,7 +143,234 @@ const BDSFieldValue& BDSArray4D::GetConst(G4int x,
 {
   if (Outside(x,y,z,t))
     {return defaultValue;}
-  return data[t*nZ*nY*nX + z*nY*nX + y*nX + x];
+  std::size_t index = Index(x,y,z,t);
+  if (storageType == BDSArrayStorageType::full)
+    {return data[index];}
+  returnValue = Decode(index);
+  return returnValue;
+}
+
+void BDSArray4D::ExtractCube(G4int x,
+                             G4int y,
+                             G4int z,
+                             G4int t,
+                             G4int n,
+                             BDSFieldValue* out) const
+{
+  G4bool inside = x >= 0 && x + n <= nX && y >= 0 && y + n <= nY && z >= 0 && z + n <= nZ && t >= 0 && t < nT;
+  if (!inside)
+    {
+      for (G4int i = 0; i < n; i++)
+        {
+          for (G4int j = 0; j < n; j++)
+            {
+              for (G4int k = 0; k < n; k++)
+                {out[(i*n + j)*n + k] = BDSArray4D::GetConst(x+i, y+j, z+k, t);}
+            }
+        }
+      return;
+    }
+
+  G4bool full = storageType == BDSArrayStorageType::full;
+  for (G4int j = 0; j < n; j++)
+    {
+      for (G4int k = 0; k < n; k++)
+        {
+          // values along x are consecutive in memory - in a brick layout until the next brick
+          std::size_t index = Index(x, y+j, z+k, t);
+          for (G4int i = 0; i < n; i++)
+            {
+              if (i > 0)
+                {
+                  if (bricked && ((x+i) & brickMaskX) == 0)
+                    {index = Index(x+i, y+j, z+k, t);}
+                  else
+                    {index++;}
+                }
+              out[(i*n + j)*n + k] = full ? data[index] : Decode(index);
+            }
+        }
+    }
+}
+
+BDSFieldValue BDSArray4D::Decode(std::size_t index) const
+{
+  const uint16_t* v = &compactData[3*index];
+  switch (storageType.underlying())
+    {
+    case BDSArrayStorageType::half:
+      {return BDSFieldValue((FIELDTYPET)HalfToFloat(v[0]), (FIELDTYPET)HalfToFloat(v[1]), (FIELDTYPET)HalfToFloat(v[2]));}
+    case BDSArrayStorageType::bfloat16:
+      {return BDSFieldValue((FIELDTYPET)BFloat16ToFloat(v[0]), (FIELDTYPET)BFloat16ToFloat(v[1]), (FIELDTYPET)BFloat16ToFloat(v[2]));}
+    case BDSArrayStorageType::quantised16:
+      {
+        const G4float* scale = &blockScales[3*(index / quantisationBlockSize)];
+        return BDSFieldValue((FIELDTYPET)((G4float)(int16_t)v[0] * scale[0]),
+                             (FIELDTYPET)((G4float)(int16_t)v[1] * scale[1]),
+                             (FIELDTYPET)((G4float)(int16_t)v[2] * scale[2]));
+      }
+    default:
+      {return data[index];}
+    }
+}
+
+void BDSArray4D::SetLayout(BDSArrayLayoutType layoutIn)
+{
+  if (layoutIn == layout)
+    {return;}
+  if (storageType != BDSArrayStorageType::full)
+    {throw BDSException(__METHOD_NAME__, "the layout cannot be changed once the values are converted");}
+
+  // copy the values out in a layout independent way
+  std::vector<BDSFieldValue> values;
+  values.reserve((std::size_t)nX*nY*nZ*nT);
+  for (G4int t = 0; t < nT; t++)
+    {
+      for (G4int z = 0; z < nZ; z++)
+        {
+          for (G4int y = 0; y < nY; y++)
+            {
+              for (G4int x = 0; x < nX; x++)
+                {values.push_back(data[Index(x,y,z,t)]);}
+            }
+        }
+    }
+
+  layout  = layoutIn;
+  bricked = layout == BDSArrayLayoutType::brick;
+  // don't make bricks along dimensions that are only 1 point long, e.g. for 2D arrays
+  brickShiftX = (bricked && nX > 1) ? 2 : 0;
+  brickShiftY = (bricked && nY > 1) ? 2 : 0;
+  brickShiftZ = (bricked && nZ > 1) ? 2 : 0;
+  brickShift  = brickShiftX + brickShiftY + brickShiftZ;
+  brickMaskX  = (1 << brickShiftX) - 1;
+  brickMaskY  = (1 << brickShiftY) - 1;
+  brickMaskZ  = (1 << brickShiftZ) - 1;
+  nXBricks    = (nX + brickMaskX) >> brickShiftX;
+  nYBricks    = (nY + brickMaskY) >> brickShiftY;
+  nZBricks    = (nZ + brickMaskZ) >> brickShiftZ;
+
+  std::size_t size = bricked ? ((std::size_t)nXBricks*nYBricks*nZBricks*nT) << brickShift : values.size();
+  data.assign(size, BDSFieldValue());
+  std::size_t i = 0;
+  for (G4int t = 0; t < nT; t++)
+    {
+      for (G4int z = 0; z < nZ; z++)
+        {
+          for (G4int y = 0; y < nY; y++)
+            {
+              for (G4int x = 0; x < nX; x++)
+                {data[Index(x,y,z,t)] = values[i++];}
+            }
+        }
+    }
+}
+
+void BDSArray4D::SetStorageType(BDSArrayStorageType storageTypeIn,
+                                G4double&           maxError,
+                                G4double&           rmsError,
+                                G4double&           maxValue)
+{
+  maxError = 0;
+  rmsError = 0;
+  maxValue = 0;
+  if (storageType != BDSArrayStorageType::full)
+    {throw BDSException(__METHOD_NAME__, "array values have already been converted");}
+  if (storageTypeIn == BDSArrayStorageType::full || data.empty())
+    {return;}
+
+  std::size_t nPoints = data.size();
+  compactData.resize(3*nPoints);
+  if (storageTypeIn == BDSArrayStorageType::quantised16)
+    {
+      std::size_t nBlocks = (nPoints + quantisationBlockSize - 1) / quantisationBlockSize;
+      blockScales.assign(3*nBlocks, 0);
+      for (std::size_t i = 0; i < nPoints; i++)
+        {
+          G4float* scale = &blockScales[3*(i / quantisationBlockSize)];
+          for (G4int c = 0; c < 3; c++)
+            {scale[c] = std::max(scale[c], (G4float)std::abs(data[i][c]));}
+        }
+      for (auto& scale : blockScales)
+        {scale /= 32767.0f;}
+    }
+
+  storageType = storageTypeIn; // for Decode()
+  G4double sumSquares = 0;
+  for (std::size_t i = 0; i < nPoints; i++)
+    {
+      for (G4int c = 0; c < 3; c++)
+        {
+          auto value = (G4float)data[i][c];
+          uint16_t& result = compactData[3*i + c];
+          switch (storageType.underlying())
+            {
+            case BDSArrayStorageType::half:
+              {result = FloatToHalf(value); break;}
+            case BDSArrayStorageType::bfloat16:
+              {result = FloatToBFloat16(value); break;}
+            case BDSArrayStorageType::quantised16:
+              {
+                G4float scale = blockScales[3*(i / quantisationBlockSize) + c];
+                auto q = scale > 0 ? (G4int)std::lround(value / scale) : 0;
+                q = std::max(-32767, std::min(32767, q));
+                result = (uint16_t)(int16_t)q;
+                break;
+              }
+            default:
+              {break;}
+            }
+        }
+    }
+
+  // only compare the points of the array and not any padding of the brick layout
+  for (G4int t = 0; t < nT; t++)
+    {
+      for (G4int z = 0; z < nZ; z++)
+        {
+          for (G4int y = 0; y < nY; y++)
+            {
+              for (G4int x = 0; x < nX; x++)
+                {
+                  std::size_t i = Index(x,y,z,t);
+                  BDSFieldValue decoded = Decode(i);
+                  for (G4int c = 0; c < 3; c++)
+                    {
+                      G4double original = data[i][c];
+                      if (std::isfinite(original) && !std::isfinite((G4double)decoded[c]))
+                        {
+                          storageType = BDSArrayStorageType::full;
+                          std::vector<uint16_t>().swap(compactData);
+                          std::vector<G4float>().swap(blockScales);
+                          throw BDSException(__METHOD_NAME__, "value " + std::to_string(original) + " cannot be represented with \"" +
+                                             storageTypeIn.ToString() + "\" storage");
+                        }
+                      G4double error = std::abs((G4double)decoded[c] - original);
+                      maxError    = std::max(maxError, error);
+                      maxValue    = std::max(maxValue, std::abs(original));
+                      sumSquares += error*error;
+                    }
+                }
+            }
+        }
+    }
+  rmsError = std::sqrt(sumSquares / (3.0*(G4double)nX*nY*nZ*nT));
+  std::vector<BDSFieldValue>().swap(data); // release the memory
+}
+
+std::size_t BDSArray4D::MemoryUsage() const
+{
+  std::size_t nPoints = (std::size_t)nX*nY*nZ*nT;
+  std::size_t bytesPerPoint = storageType == BDSArrayStorageType::full ? sizeof(BDSFieldValue) : 3*sizeof(uint16_t);
+  return nPoints*bytesPerPoint + blockScales.size()*sizeof(G4float);
+}
+
+std::size_t BDSArray4D::PaddingMemoryUsage() const
+{
+  std::size_t nPoints = (std::size_t)nX*nY*nZ*nT;
+  std::size_t nStored = storageType == BDSArrayStorageType::full ? data.size() : compactData.size() / 3;
+  std::size_t bytesPerPoint = storageType == BDSArrayStorageType::full ? sizeof(BDSFieldValue) : 3*sizeof(uint16_t);
+  return (nStored - nPoints)*bytesPerPoint;
 }
   
 const BDSFieldValue& BDSArray4D::operator()(G4int x,
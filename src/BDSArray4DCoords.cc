@@ -150,14 +150,16 @@ void BDSArray4DCoords::ExtractSection2x2x2x2(G4double x,
   zFrac = zArrayCoords - z1;
   tFrac = tArrayCoords - t1;
   
-  for (G4int i = 0; i < 2; i++)
+  BDSFieldValue cube[2][2][2];
+  for (G4int l = 0; l < 2; l++)
     {
-      for (G4int j = 0; j < 2; j++)
+      ExtractCube(x1, y1, z1, t1+l, 2, &cube[0][0][0]);
+      for (G4int i = 0; i < 2; i++)
 	{
-	  for (G4int k = 0; k < 2; k++)
+	  for (G4int j = 0; j < 2; j++)
 	    {
-	      for (G4int l = 0; l < 2; l++)
-		{localData[i][j][k][l] = GetConst(x1+i, y1+j, z1+k, t1+l);}
+	      for (G4int k = 0; k < 2; k++)
+		{localData[i][j][k][l] = cube[i][j][k];}
 	    }
 	}
     }
@@ -185,14 +187,16 @@ void BDSArray4DCoords::ExtractSection4x4x4x4(G4double x,
   zFrac = zArrayCoords - z1;
   tFrac = tArrayCoords - t1;
   
-  for (G4int i = 0; i < 4; i++)
+  BDSFieldValue cube[4][4][4];
+  for (G4int l = 0; l < 4; l++)
     {
-      for (G4int j = 0; j < 4; j++)
+      ExtractCube(x1-1, y1-1, z1-1, t1-1+l, 4, &cube[0][0][0]);
+      for (G4int i = 0; i < 4; i++)
 	{
-	  for (G4int k = 0; k < 4; k++)
+	  for (G4int j = 0; j < 4; j++)
 	    {
-	      for (G4int l = 0; l < 4; l++)
-		{localData[i][j][k][l] = GetConst(x1-1+i, y1-1+j, z1-1+k, t1-1+l);}
+	      for (G4int k = 0; k < 4; k++)
+		{localData[i][j][k][l] = cube[i][j][k];}
 	    }
 	}
     }
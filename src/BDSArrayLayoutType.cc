@@ -0,0 +1,59 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArrayLayoutType.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSUtilities.hh"
+
+#include "globals.hh"
+#include "G4String.hh"
+
+#include <map>
+#include <string>
+
+template<>
+std::map<BDSArrayLayoutType, std::string>* BDSArrayLayoutType::dictionary =
+  new std::map<BDSArrayLayoutType, std::string> ({
+      {BDSArrayLayoutType::linear, "linear"},
+      {BDSArrayLayoutType::brick,  "brick"}
+});
+
+BDSArrayLayoutType BDS::DetermineArrayLayoutType(G4String layoutType)
+{
+  std::map<G4String, BDSArrayLayoutType> types;
+  types["linear"] = BDSArrayLayoutType::linear;
+  types["brick"]  = BDSArrayLayoutType::brick;
+
+  layoutType = BDS::LowerCase(layoutType);
+
+  auto result = types.find(layoutType);
+  if (result == types.end())
+    {// it's not a valid key
+      G4String msg = "\"" + layoutType + "\" is not a valid field map layout\n";
+      msg += "Available layouts are:\n";
+      for (const auto& it : types)
+        {msg += "\"" + it.first + "\"\n";}
+      throw BDSException(__METHOD_NAME__, msg);
+    }
+
+#ifdef BDSDEBUG
+  G4cout << __METHOD_NAME__ << "determined layout to be " << result->second << G4endl;
+#endif
+  return result->second;
+}
@@ -0,0 +1,63 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArrayStorageType.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSUtilities.hh"
+
+#include "globals.hh"
+#include "G4String.hh"
+
+#include <map>
+#include <string>
+
+template<>
+std::map<BDSArrayStorageType, std::string>* BDSArrayStorageType::dictionary =
+  new std::map<BDSArrayStorageType, std::string> ({
+      {BDSArrayStorageType::full,        "full"},
+      {BDSArrayStorageType::half,        "half"},
+      {BDSArrayStorageType::bfloat16,    "bfloat16"},
+      {BDSArrayStorageType::quantised16, "quantised16"}
+});
+
+BDSArrayStorageType BDS::DetermineArrayStorageType(G4String storageType)
+{
+  std::map<G4String, BDSArrayStorageType> types;
+  types["full"]        = BDSArrayStorageType::full;
+  types["half"]        = BDSArrayStorageType::half;
+  types["bfloat16"]    = BDSArrayStorageType::bfloat16;
+  types["quantised16"] = BDSArrayStorageType::quantised16;
+
+  storageType = BDS::LowerCase(storageType);
+
+  auto result = types.find(storageType);
+  if (result == types.end())
+    {// it's not a valid key
+      G4String msg = "\"" + storageType + "\" is not a valid field map storage type\n";
+      msg += "Available storage types are:\n";
+      for (const auto& it : types)
+        {msg += "\"" + it.first + "\"\n";}
+      throw BDSException(__METHOD_NAME__, msg);
+    }
+
+#ifdef BDSDEBUG
+  G4cout << __METHOD_NAME__ << "determined storage type to be " << result->second << G4endl;
+#endif
+  return result->second;
+}
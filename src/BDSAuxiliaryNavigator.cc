@@ -17,23 +17,30 @@ You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSAuxiliaryNavigator.hh"
+#include "BDSBeamline.hh"
+#include "BDSBeamlineElement.hh"
 #include "BDSDebug.hh"
 #include "BDSStep.hh"
 #include "BDSUtilities.hh"
 
+#include "G4LogicalVolume.hh"
 #include "G4Navigator.hh"
 #include "G4Step.hh"
 #include "G4StepPoint.hh"
 #include "G4StepStatus.hh"
 #include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
 
 G4Navigator*       BDSAuxiliaryNavigator::auxNavigator             = new G4Navigator();
 G4Navigator*       BDSAuxiliaryNavigator::auxNavigatorCL           = new G4Navigator();
 G4Navigator*       BDSAuxiliaryNavigator::auxNavigatorCLB          = new G4Navigator();
 G4int              BDSAuxiliaryNavigator::numberOfInstances        = 0;
+G4long             BDSAuxiliaryNavigator::geometryGeneration       = 0;
 G4VPhysicalVolume* BDSAuxiliaryNavigator::worldPV                  = nullptr;
 G4VPhysicalVolume* BDSAuxiliaryNavigator::curvilinearWorldPV       = nullptr;
 G4VPhysicalVolume* BDSAuxiliaryNavigator::curvilinearBridgeWorldPV = nullptr;
+const BDSBeamline* BDSAuxiliaryNavigator::curvilinearBeamline      = nullptr;
 
 BDSAuxiliaryNavigator::BDSAuxiliaryNavigator():
   globalToLocal(G4AffineTransform()),
@@ -41,6 +48,7 @@ BDSAuxiliaryNavigator::BDSAuxiliaryNavigator():
   globalToLocalCL(G4AffineTransform()),
   localToGlobalCL(G4AffineTransform()),
   bridgeVolumeWasUsed(false),
+  placementTableHint(-1),
   volumeMargin(0.1*CLHEP::mm)
 {
   numberOfInstances++;
@@ -63,6 +71,7 @@ void BDSAuxiliaryNavigator::ResetNavigatorStates()
   auxNavigator->ResetStackAndState();
   auxNavigatorCL->ResetStackAndState();
   auxNavigatorCLB->ResetStackAndState();
+  geometryGeneration++;
 }
 
 G4VPhysicalVolume* BDSAuxiliaryNavigator::LocateGlobalPointAndSetup(const G4ThreeVector& point,
@@ -166,14 +175,19 @@ G4VPhysicalVolume* BDSAuxiliaryNavigator::LocateGlobalPointAndSetup(G4Step const
 BDSStep BDSAuxiliaryNavigator::ConvertToLocal(G4Step const* const step,
 					      G4bool useCurvilinear) const
 {
-  auto selectedVol = LocateGlobalPointAndSetup(step, useCurvilinear);
+  G4ThreeVector midPoint = (step->GetPreStepPoint()->GetPosition() + step->GetPostStepPoint()->GetPosition()) / 2.0;
+  G4VPhysicalVolume* selectedVol = FindWithoutNavigator(midPoint, useCurvilinear);
+  if (!selectedVol)
+    {
+      selectedVol = LocateGlobalPointAndSetup(step, useCurvilinear);
+      useCurvilinear ? InitialiseTransform(false, true) : InitialiseTransform(true, false);
+      UpdateCache(selectedVol, useCurvilinear, bridgeVolumeWasUsed);
+    }
 
 #ifdef BDSDEBUGNAV
   G4cout << __METHOD_NAME__ << selectedVol->GetName() << G4endl;
 #endif
 
-  useCurvilinear ? InitialiseTransform(false, true) : InitialiseTransform(true, false);
-
   G4ThreeVector pre = GlobalToLocal(useCurvilinear).TransformPoint(step->GetPreStepPoint()->GetPosition());
   G4ThreeVector pos = GlobalToLocal(useCurvilinear).TransformPoint(step->GetPostStepPoint()->GetPosition());
   return BDSStep(pre, pos, selectedVol);
@@ -199,16 +213,21 @@ BDSStep BDSAuxiliaryNavigator::ConvertToLocal(const G4ThreeVector& globalPositio
     {point += globalDirUnit * (stepLength * 0.5);}
   // else pass: point = globalPosition
   
-  auto selectedVol = LocateGlobalPointAndSetup(point,
-                                               &globalDirection,
-                                               true,  // relative search
-                                               false, // don't ignore direction, ie use it
-                                               useCurvilinear);
+  G4VPhysicalVolume* selectedVol = FindWithoutNavigator(point, useCurvilinear);
+  if (!selectedVol)
+    {
+      selectedVol = LocateGlobalPointAndSetup(point,
+                                              &globalDirection,
+                                              true,  // relative search
+                                              false, // don't ignore direction, ie use it
+                                              useCurvilinear);
+      useCurvilinear ? InitialiseTransform(false, true) : InitialiseTransform(true, false);
+      UpdateCache(selectedVol, useCurvilinear, bridgeVolumeWasUsed);
+    }
 #ifdef BDSDEBUGNAV
   G4cout << __METHOD_NAME__ << selectedVol->GetName() << G4endl;
 #endif
   
-  useCurvilinear ? InitialiseTransform(false, true) : InitialiseTransform(true, false);
   const G4AffineTransform& aff = GlobalToLocal(useCurvilinear);
   G4ThreeVector localPos = aff.TransformPoint(globalPosition);
   G4ThreeVector localDir = aff.TransformAxis(globalDirection);
@@ -492,12 +511,83 @@ void BDSAuxiliaryNavigator::InitialiseTransform(const G4bool massWorld,
 
 void BDSAuxiliaryNavigator::InitialiseTransform(const G4ThreeVector& globalPosition) const
 {
-  auxNavigator->LocateGlobalPointAndSetup(globalPosition);
-  auxNavigatorCL->LocateGlobalPointAndSetup(globalPosition);
-  globalToLocal = auxNavigator->GetGlobalToLocalTransform();
-  localToGlobal = auxNavigator->GetLocalToGlobalTransform();
-  globalToLocalCL = auxNavigatorCL->GetGlobalToLocalTransform();
-  localToGlobalCL = auxNavigatorCL->GetLocalToGlobalTransform();
+  if (!FindWithoutNavigator(globalPosition, false))
+    {
+      G4VPhysicalVolume* vol = auxNavigator->LocateGlobalPointAndSetup(globalPosition);
+      globalToLocal = auxNavigator->GetGlobalToLocalTransform();
+      localToGlobal = auxNavigator->GetLocalToGlobalTransform();
+      UpdateCache(vol, false, false);
+    }
+  if (!FindWithoutNavigator(globalPosition, true))
+    {
+      G4VPhysicalVolume* vol = auxNavigatorCL->LocateGlobalPointAndSetup(globalPosition);
+      globalToLocalCL = auxNavigatorCL->GetGlobalToLocalTransform();
+      localToGlobalCL = auxNavigatorCL->GetLocalToGlobalTransform();
+      UpdateCache(vol, true, false);
+    }
+}
+
+G4VPhysicalVolume* BDSAuxiliaryNavigator::FindInCache(const G4ThreeVector& globalPoint,
+                                                      G4bool curvilinear) const
+{
+  const FrameCache& cache = curvilinear ? frameCacheCL : frameCache;
+  if (!cache.volume || cache.generation != geometryGeneration)
+    {return nullptr;}
+  // strictly inside only - anything on a surface is left to the navigator
+  if (cache.solid->Inside(cache.globalToLocal.TransformPoint(globalPoint)) != kInside)
+    {return nullptr;}
+  if (curvilinear)
+    {
+      globalToLocalCL = cache.globalToLocal;
+      localToGlobalCL = cache.localToGlobal;
+    }
+  else
+    {
+      globalToLocal = cache.globalToLocal;
+      localToGlobal = cache.localToGlobal;
+    }
+  return cache.volume;
+}
+
+G4VPhysicalVolume* BDSAuxiliaryNavigator::FindWithoutNavigator(const G4ThreeVector& globalPoint,
+                                                               G4bool curvilinear) const
+{
+  G4VPhysicalVolume* vol = FindInCache(globalPoint, curvilinear);
+  if (vol || !curvilinear || !curvilinearBeamline)
+    {return vol;}
+
+  const BDSBeamlineElement* element = curvilinearBeamline->FindPlacedElement(globalPoint,
+                                                                             placementTableHint,
+                                                                             globalToLocalCL,
+                                                                             localToGlobalCL);
+  if (!element)
+    {return nullptr;}
+  vol = element->GetPlacedVolume();
+  bridgeVolumeWasUsed = false;
+  UpdateCache(vol, true, false);
+  return vol;
+}
+
+void BDSAuxiliaryNavigator::UpdateCache(G4VPhysicalVolume* volume,
+                                        G4bool curvilinear,
+                                        G4bool fromBridgeWorld) const
+{
+  FrameCache& cache = curvilinear ? frameCacheCL : frameCache;
+  cache.volume = nullptr;
+  // the bridge world is only a fall back for the curvilinear world so the curvilinear
+  // world must always be searched first
+  if (!volume || fromBridgeWorld || volume == worldPV || volume == curvilinearWorldPV)
+    {return;}
+  if (volume->IsReplicated())
+    {return;} // same volume with different transforms
+  const G4LogicalVolume* lv = volume->GetLogicalVolume();
+  if (lv->GetNoDaughters() > 0)
+    {return;} // a point inside could be in a daughter
+  cache.volume        = volume;
+  cache.solid         = lv->GetSolid();
+  cache.globalToLocal = GlobalToLocal(curvilinear);
+  cache.localToGlobal = LocalToGlobal(curvilinear);
+  cache.generation    = geometryGeneration;
 }
 
 void BDSAuxiliaryNavigator::InitialiseTransform(const G4ThreeVector &globalPosition,
@@ -34,14 +34,20 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSWarning.hh"
 
 #include "globals.hh" // geant4 globals / types
+#include "G4AffineTransform.hh"
+#include "G4LogicalVolume.hh"
 #include "G4RotationMatrix.hh"
 #include "G4ThreeVector.hh"
 #include "G4Transform3D.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
 
 #include "CLHEP/Vector/AxisAngle.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <limits>
 #include <ostream>
 #include <set>
 #include <vector>
@@ -58,7 +64,8 @@ BDSBeamline::BDSBeamline(const G4ThreeVector& initialGlobalPosition,
   totalAngle(0),
   previousReferencePositionEnd(initialGlobalPosition),
   previousSPositionEnd(sInitial),
-  transformHasJustBeenApplied(false)
+  transformHasJustBeenApplied(false),
+  sortAxis(2)
 {
   // initialise extents
   maximumExtentPositive = G4ThreeVector(0,0,0);
@@ -981,3 +988,147 @@ std::vector<G4int> BDSBeamline::GetIndicesOfCollimators() const
   std::set<G4String> collimatorTypes = {"ecol", "rcol", "jcol", "crystalcol", "element-collimator"};
   return GetIndicesOfElementsOfType(collimatorTypes);
 }
+
+void BDSBeamline::BuildPlacementTable()
+{
+  placedElements.clear();
+  placedSolids.clear();
+  placedGlobalToLocal.clear();
+  placedLocalToGlobal.clear();
+  placedCentreX.clear();
+  placedCentreY.clear();
+  placedCentreZ.clear();
+  placedRadiusSq.clear();
+  sortedRows.clear();
+  sortedMin.clear();
+  sortedMax.clear();
+  sortedMaxSoFar.clear();
+
+  for (const auto element : beamline)
+    {
+      const G4VPhysicalVolume* pv = element->GetPlacedVolume();
+      if (!pv || pv->IsReplicated())
+        {continue;}
+      const G4LogicalVolume* lv = pv->GetLogicalVolume();
+      if (lv->GetNoDaughters() > 0)
+        {continue;} // a point inside could be in a daughter
+      const G4VSolid* solid = lv->GetSolid();
+
+      // same as the navigator builds for a volume placed in a world
+      G4AffineTransform localToGlobal(pv->GetRotation(), pv->GetTranslation());
+
+      G4ThreeVector pMin;
+      G4ThreeVector pMax;
+      solid->BoundingLimits(pMin, pMax);
+      G4double dx = std::max(std::abs(pMin.x()), std::abs(pMax.x()));
+      G4double dy = std::max(std::abs(pMin.y()), std::abs(pMax.y()));
+      G4double dz = std::max(std::abs(pMin.z()), std::abs(pMax.z()));
+      G4ThreeVector centre = pv->GetTranslation();
+
+      placedElements.push_back(element);
+      placedSolids.push_back(solid);
+      placedGlobalToLocal.push_back(localToGlobal.Inverse());
+      placedLocalToGlobal.push_back(localToGlobal);
+      placedCentreX.push_back(centre.x());
+      placedCentreY.push_back(centre.y());
+      placedCentreZ.push_back(centre.z());
+      placedRadiusSq.push_back(dx*dx + dy*dy + dz*dz);
+    }
+
+  const G4int nRows = (G4int)placedElements.size();
+  if (nRows == 0)
+    {return;}
+
+  // sort along the global axis the centres span most - usually the beam direction
+  std::vector<const std::vector<G4double>*> centres = {&placedCentreX, &placedCentreY, &placedCentreZ};
+  G4double largestRange = -1;
+  for (G4int axis = 0; axis < 3; axis++)
+    {
+      auto minMax = std::minmax_element(centres[axis]->begin(), centres[axis]->end());
+      G4double range = *minMax.second - *minMax.first;
+      if (range > largestRange)
+        {
+          largestRange = range;
+          sortAxis = axis;
+        }
+    }
+
+  const std::vector<G4double>& centre = *centres[sortAxis];
+  std::vector<G4double> rowMin((std::size_t)nRows);
+  std::vector<G4double> rowMax((std::size_t)nRows);
+  for (G4int row = 0; row < nRows; row++)
+    {
+      G4double radius = std::sqrt(placedRadiusSq[row]);
+      rowMin[row] = centre[row] - radius;
+      rowMax[row] = centre[row] + radius;
+    }
+
+  sortedRows.resize((std::size_t)nRows);
+  for (G4int row = 0; row < nRows; row++)
+    {sortedRows[row] = row;}
+  std::sort(sortedRows.begin(), sortedRows.end(),
+            [&rowMin](G4int a, G4int b){return rowMin[a] < rowMin[b];});
+
+  G4double maxSoFar = -std::numeric_limits<G4double>::max();
+  for (auto row : sortedRows)
+    {
+      sortedMin.push_back(rowMin[row]);
+      sortedMax.push_back(rowMax[row]);
+      maxSoFar = std::max(maxSoFar, rowMax[row]);
+      sortedMaxSoFar.push_back(maxSoFar);
+    }
+}
+
+G4bool BDSBeamline::PlacedVolumeContains(std::size_t row, const G4ThreeVector& globalPoint) const
+{
+  // strictly inside only - anything on a surface is left to the navigator
+  G4ThreeVector localPoint = placedGlobalToLocal[row].TransformPoint(globalPoint);
+  return placedSolids[row]->Inside(localPoint) == kInside;
+}
+
+const BDSBeamlineElement* BDSBeamline::FindPlacedElement(const G4ThreeVector& globalPoint,
+                                                         G4int&               hint,
+                                                         G4AffineTransform&   globalToLocal,
+                                                         G4AffineTransform&   localToGlobal) const
+{
+  const G4int nRows = (G4int)placedElements.size();
+  if (nRows == 0)
+    {return nullptr;}
+
+  G4int found = -1;
+  // try the last row found and its neighbours first as points are typically close
+  if (hint >= 0 && hint < nRows)
+    {
+      for (G4int row : {hint, hint + 1, hint - 1})
+        {
+          if (row >= 0 && row < nRows && PlacedVolumeContains((std::size_t)row, globalPoint))
+            {found = row; break;}
+        }
+    }
+
+  if (found < 0)
+    {
+      // the volumes that may contain the point are those with a minimum extent below it,
+      // searched backwards from the last one until no earlier volume can reach the point
+      const G4double p = globalPoint[sortAxis];
+      G4int i = (G4int)std::distance(sortedMin.begin(), std::upper_bound(sortedMin.begin(), sortedMin.end(), p)) - 1;
+      for (; i >= 0 && sortedMaxSoFar[i] >= p; i--)
+        {
+          if (sortedMax[i] < p)
+            {continue;}
+          G4int row = sortedRows[i];
+          G4double dx = globalPoint.x() - placedCentreX[row];
+          G4double dy = globalPoint.y() - placedCentreY[row];
+          G4double dz = globalPoint.z() - placedCentreZ[row];
+          if (dx*dx + dy*dy + dz*dz <= placedRadiusSq[row] && PlacedVolumeContains((std::size_t)row, globalPoint))
+            {found = row; break;}
+        }
+    }
+
+  if (found < 0)
+    {return nullptr;}
+  hint          = found;
+  globalToLocal = placedGlobalToLocal[(std::size_t)found];
+  localToGlobal = placedLocalToGlobal[(std::size_t)found];
+  return placedElements[(std::size_t)found];
+}
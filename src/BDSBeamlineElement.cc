@@ -76,7 +76,8 @@ BDSBeamlineElement::BDSBeamlineElement(BDSAcceleratorComponent* componentIn,
   tiltOffset(tiltOffsetIn),
   samplerInfo(samplerInfoIn),
   samplerPlacementTransform(nullptr),
-  index(indexIn)
+  index(indexIn),
+  placedVolume(nullptr)
 {
   componentIn->IncrementCopyNumber(); // increase copy number (starts at -1)
   copyNumber = componentIn->GetCopyNumber();
@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSGlobalConstants.hh"
 #include "BDSIonDefinition.hh"
 #include "BDSParticleCoords.hh"
+#include "BDSParticleCoordsBatch.hh"
 #include "BDSParticleCoordsFull.hh"
 #include "BDSParticleCoordsFullGlobal.hh"
 #include "BDSParticleDefinition.hh"
@@ -45,6 +46,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <limits>
 #include <set>
 #include <string>
+#include <vector>
 
 
 BDSBunch::BDSBunch():
@@ -259,6 +261,49 @@ BDSParticleCoordsFullGlobal BDSBunch::GetNextParticleValid(G4int maxTries)
   return coords;
 }
 
+void BDSBunch::GetNextParticlesValid(G4int nParticles,
+                                     std::vector<BDSParticleCoordsFullGlobal>& particles,
+                                     G4int maxTries)
+{
+  if (nParticles <= 0)
+    {return;}
+  particles.reserve(particles.size() + (std::size_t)nParticles);
+  if (!CanGenerateInBatches())
+    {
+      for (G4int i = 0; i < nParticles; i++)
+        {particles.push_back(GetNextParticleValid(maxTries));}
+      return;
+    }
+
+  // A particle that fails the energy check in GetNextParticleValid is simply replaced by
+  // the next one from the distribution, so taking the valid ones in order from a batch and
+  // generating more for any that fail gives the same particles.
+  particleDefinitionHasBeenUpdated = false;
+  const G4double mass = particleDefinition->Mass();
+  const std::size_t target = particles.size() + (std::size_t)nParticles;
+  BDSParticleCoordsBatch batch;
+  G4int n = 0; // number of attempts for the current particle as in GetNextParticleValid
+  while (particles.size() < target)
+    {
+      batch.Clear();
+      GetNextParticlesLocal((G4int)(target - particles.size()), batch);
+      for (std::size_t i = 0; i < batch.Size(); i++)
+        {
+          ++n;
+          if ((batch.totalEnergy[i] - mass) > 0 && n < maxTries)
+            {
+              BDSParticleCoordsFull local = batch.Get(i);
+              if (finiteTilt)
+                {ApplyTilt(local);}
+              particles.push_back(ApplyTransform(local));
+              n = 0;
+            }
+          else if (n >= maxTries)
+            {throw BDSException(__METHOD_NAME__, "unable to generate coordinates above rest mass after 100 attempts.");}
+        }
+    }
+}
+
 BDSParticleCoordsFullGlobal BDSBunch::GetNextParticle()
 {
   particleDefinitionHasBeenUpdated = false; // reset flag
@@ -277,6 +322,16 @@ BDSParticleCoordsFull BDSBunch::GetNextParticleLocal()
   return local;
 }
 
+void BDSBunch::GetNextParticlesLocal(G4int nParticles,
+                                     BDSParticleCoordsBatch& batch)
+{
+  if (nParticles <= 0)
+    {return;}
+  batch.Reserve(batch.Size() + (std::size_t)nParticles);
+  for (G4int i = 0; i < nParticles; i++)
+    {batch.Append(GetNextParticleLocal());}
+}
+
 void BDSBunch::RecreateAdvanceToEvent(G4int eventOffset)
 {
   CalculateBunchIndex(eventOffset);
@@ -0,0 +1,391 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSBunchBinaryFile.hh"
+#include "BDSBunchBinaryFileFormat.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSGlobalConstants.hh"
+#include "BDSIonDefinition.hh"
+#include "BDSParticleCoordsFull.hh"
+#include "BDSParticleCoordsFullGlobal.hh"
+#include "BDSParticleDefinition.hh"
+#include "BDSUtilities.hh"
+
+#include "parser/beam.h"
+
+#include "G4IonTable.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4String.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+BDSBunchBinaryFile::BDSBunchBinaryFile():
+  BDSBunchFileBased("binaryfile"),
+  nlinesSkip(0),
+  matchDistrFileLength(false),
+  ffact(1),
+  fileDescriptor(-1),
+  mappedData(nullptr),
+  mappedSize(0),
+  nParticles(0),
+  currentIndex(0),
+  endOfFileReached(false),
+  anEnergyCoordinateInUse(false),
+  changingParticleType(false)
+{
+  ffact = BDSGlobalConstants::Instance()->FFact();
+  Column empty = {nullptr, BDSBunchBinaryFileColumn::float64, 1.0};
+  x = y = z = xp = yp = zp = t = S = E = Ek = P = pdgid = weight = empty;
+}
+
+BDSBunchBinaryFile::~BDSBunchBinaryFile()
+{
+  UnmapFile();
+}
+
+void BDSBunchBinaryFile::SetOptions(const BDSParticleDefinition* beamParticle,
+                                    const GMAD::Beam& beam,
+                                    const BDSBunchType& distrType,
+                                    G4Transform3D beamlineTransformIn,
+                                    const G4double beamlineSIn)
+{
+  BDSBunchFileBased::SetOptions(beamParticle, beam, distrType, beamlineTransformIn, beamlineSIn);
+  distrFile     = beam.distrFile;
+  distrFilePath = BDS::GetFullPath(beam.distrFile);
+  nlinesSkip    = (G4long)beam.nlinesSkip;
+  matchDistrFileLength = beam.distrFileMatchLength;
+}
+
+void BDSBunchBinaryFile::CheckParameters()
+{
+  BDSBunch::CheckParameters();
+  if (distrFile.empty())
+    {throw BDSException("BDSBunchBinaryFile::CheckParameters", "No input file specified for binaryfile distribution");}
+}
+
+void BDSBunchBinaryFile::MapFile()
+{
+  G4cout << "BDSBunchBinaryFile::MapFile> opening " << distrFilePath << G4endl;
+  fileDescriptor = open(distrFilePath.c_str(), O_RDONLY);
+  if (fileDescriptor < 0)
+    {throw BDSException(__METHOD_NAME__, "Cannot open bunch file " + distrFilePath);}
+
+  struct stat fileInfo;
+  if (fstat(fileDescriptor, &fileInfo) != 0 || (std::size_t)fileInfo.st_size < sizeof(BDSBunchBinaryFileHeader))
+    {
+      UnmapFile();
+      throw BDSException(__METHOD_NAME__, "File \"" + distrFilePath + "\" is too small to be a binary bunch file");
+    }
+  mappedSize = (std::size_t)fileInfo.st_size;
+  void* mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+  if (mapped == MAP_FAILED)
+    {
+      mappedSize = 0;
+      UnmapFile();
+      throw BDSException(__METHOD_NAME__, "Unable to memory map file \"" + distrFilePath + "\"");
+    }
+  mappedData = static_cast<const char*>(mapped);
+  // we read sequentially so ask the kernel to read ahead aggressively
+  madvise(mapped, mappedSize, MADV_SEQUENTIAL);
+
+  BDSBunchBinaryFileHeader header;
+  std::memcpy(&header, mappedData, sizeof(header));
+  if (std::memcmp(header.magic, "BDSBUNCH", 8) != 0)
+    {throw BDSException(__METHOD_NAME__, "File \"" + distrFilePath + "\" is not a binary bunch file");}
+  if (header.version != BDS::bunchBinaryFileVersion)
+    {throw BDSException(__METHOD_NAME__, "Unsupported binary bunch file version " + std::to_string(header.version));}
+  nParticles = header.nParticles;
+  ParseColumns();
+}
+
+void BDSBunchBinaryFile::UnmapFile()
+{
+  if (mappedData)
+    {munmap(const_cast<char*>(mappedData), mappedSize);}
+  mappedData = nullptr;
+  mappedSize = 0;
+  if (fileDescriptor >= 0)
+    {close(fileDescriptor);}
+  fileDescriptor = -1;
+}
+
+void BDSBunchBinaryFile::ParseColumns()
+{
+  BDSBunchBinaryFileHeader header;
+  std::memcpy(&header, mappedData, sizeof(header));
+  std::size_t descriptionsEnd = sizeof(header) + header.nColumns * sizeof(BDSBunchBinaryFileColumn);
+  if (descriptionsEnd > mappedSize)
+    {throw BDSException(__METHOD_NAME__, "File \"" + distrFilePath + "\" is truncated");}
+
+  G4bool zSet = false;
+  G4bool SSet = false;
+  G4int nEnergyColumns = 0;
+  for (uint32_t i = 0; i < header.nColumns; i++)
+    {
+      BDSBunchBinaryFileColumn description;
+      std::memcpy(&description, mappedData + sizeof(header) + i * sizeof(description), sizeof(description));
+      description.name[sizeof(description.name) - 1] = '\0';
+      G4String name = G4String(description.name);
+
+      std::size_t typeSize = BDS::BunchBinaryFileTypeSize(description.dataType);
+      if (description.offset + nParticles * typeSize > mappedSize)
+        {throw BDSException(__METHOD_NAME__, "Column \"" + name + "\" extends beyond the end of file \"" + distrFilePath + "\"");}
+
+      Column col = {mappedData + description.offset, description.dataType, description.unit};
+      if (name == "x")
+        {x = col; x.unit *= CLHEP::m;}
+      else if (name == "y")
+        {y = col; y.unit *= CLHEP::m;}
+      else if (name == "z")
+        {z = col; z.unit *= CLHEP::m; zSet = true;}
+      else if (name == "S")
+        {
+          S = col; S.unit *= CLHEP::m;
+          useCurvilinear = true;
+          SSet = true;
+        }
+      else if (name == "xp")
+        {xp = col; xp.unit *= CLHEP::radian;}
+      else if (name == "yp")
+        {yp = col; yp.unit *= CLHEP::radian;}
+      else if (name == "zp")
+        {zp = col; zp.unit *= CLHEP::radian;}
+      else if (name == "t")
+        {t = col; t.unit *= CLHEP::s;}
+      else if (name == "E")
+        {E = col; E.unit *= CLHEP::GeV; nEnergyColumns++;}
+      else if (name == "Ek")
+        {Ek = col; Ek.unit *= CLHEP::GeV; nEnergyColumns++;}
+      else if (name == "P")
+        {P = col; P.unit *= CLHEP::GeV; nEnergyColumns++;}
+      else if (name == "pdgid")
+        {pdgid = col; changingParticleType = true;}
+      else if (name == "w")
+        {weight = col;}
+      else
+        {throw BDSException(__METHOD_NAME__, "Unknown column \"" + name + "\" in file \"" + distrFilePath + "\"");}
+    }
+  if (zSet && SSet)
+    {throw BDSException(__METHOD_NAME__, "both \"z\" and \"S\" columns in file \"" + distrFilePath + "\" - only one is allowed");}
+  if (nEnergyColumns > 1)
+    {throw BDSException(__METHOD_NAME__, "More than one of E, Ek, P columns in file \"" + distrFilePath + "\"");}
+  anEnergyCoordinateInUse = nEnergyColumns > 0;
+}
+
+void BDSBunchBinaryFile::Initialise()
+{
+  MapFile();
+
+  if ((G4long)nParticles <= nlinesSkip)
+    {
+      G4String msg = "nlinesSkip is greater than or equal to the number of entries (" + std::to_string(nParticles);
+      msg += ") in the binary file \"" + distrFilePath + "\"";
+      throw BDSException("BDSBunchBinaryFile::Initialise>", msg);
+    }
+
+  auto g = BDSGlobalConstants::Instance();
+  G4int nEventsPerLoop = (G4int)(nParticles - (uint64_t)nlinesSkip);
+  nEventsInFile = nEventsPerLoop;
+  G4int nAvailable = nEventsPerLoop * distrFileLoopNTimes;
+  G4int nGenerate  = g->NGenerate();
+  if (matchDistrFileLength)
+    {
+      if (!g->NGenerateSet())
+        {
+          g->SetNumberToGenerate(nAvailable);
+          G4cout << "BDSBunchBinaryFile::Initialise> distrFileMatchLength is true -> simulating " << nEventsPerLoop << " events";
+          if (distrFileLoopNTimes > 1)
+            {G4cout << " " << distrFileLoopNTimes << " times";}
+          G4cout << G4endl;
+          if (g->Recreate())
+            {
+              G4int nEventsRemaining = nAvailable - g->StartFromEvent();
+              g->SetNumberToGenerate(nEventsRemaining);
+            }
+        }
+      else if (nGenerate > nAvailable)
+        {
+          G4String msg = "ngenerate (" + std::to_string(nGenerate) + ") is greater than the number of entries (";
+          msg += std::to_string(nParticles) + ") and distrFileMatchLength is on.\nChange ngenerate to <= # entries";
+          msg += ", or don't specify ngenerate.\nThis includes nlinesSkip.";
+          throw BDSException("BDSBunchBinaryFile::Initialise>", msg);
+        }
+    }
+  else if ((nGenerate > nEventsPerLoop) && !distrFileLoop)
+    {
+      G4String msg = "ngenerate (" + std::to_string(nGenerate) + ") is greater than the number of entries (";
+      msg += std::to_string(nParticles) + ") but distrFileLoop is false in the beam command";
+      throw BDSException("BDSBunchBinaryFile::Initialise>", msg);
+    }
+
+  currentIndex = (uint64_t)nlinesSkip;
+  if (nlinesSkip > 0)
+    {
+      G4cout << "BDSBunchBinaryFile> skipping " << nlinesSkip << " entries" << G4endl;
+      IncrementNEventsInFileSkipped((unsigned long long int)nlinesSkip);
+    }
+}
+
+void BDSBunchBinaryFile::EndOfFileAction()
+{
+  G4cout << "BDSBunchBinaryFile> End of file reached." << G4endl;
+  if (distrFileLoop)
+    {
+      G4cout << "BDSBunchBinaryFile> Returning to beginning of file (including nlinesSkip) for next event." << G4endl;
+      currentIndex = (uint64_t)nlinesSkip;
+      endOfFileReached = false;
+    }
+  else
+    {
+      endOfFileReached = true;
+      throw BDSException(__METHOD_NAME__, "distrFileLoop off but requesting another set of coordinates.");
+    }
+}
+
+void BDSBunchBinaryFile::RecreateAdvanceToEvent(G4int eventOffset)
+{
+  BDSBunch::RecreateAdvanceToEvent(eventOffset);
+  G4cout << "BDSBunchBinaryFile::RecreateAdvanceToEvent> Advancing file to event: " << eventOffset << G4endl;
+  uint64_t nEventsPerLoop = nParticles - (uint64_t)nlinesSkip;
+  if ((uint64_t)eventOffset >= nEventsPerLoop)
+    {
+      if (distrFileLoop)
+        {eventOffset = (G4int)((uint64_t)eventOffset % nEventsPerLoop);}
+      else
+        {
+          G4String msg = "eventOffset (" + std::to_string(eventOffset) + ") is greater than the number of entries in this file.\n";
+          msg += "This includes nlinesSkip.";
+          throw BDSException("BDSBunchBinaryFile::RecreateAdvanceToEvent>", msg);
+        }
+    }
+  currentIndex = (uint64_t)nlinesSkip + (uint64_t)eventOffset;
+}
+
+BDSParticleCoordsFullGlobal BDSBunchBinaryFile::GetNextParticleValid(G4int /*maxTries*/)
+{
+  // no looping - just read one particle from file
+  return GetNextParticle();
+}
+
+G4double BDSBunchBinaryFile::Value(const Column& column, G4double defaultValue) const
+{
+  if (!column.data)
+    {return defaultValue;}
+  switch (column.dataType)
+    {
+    case BDSBunchBinaryFileColumn::float64:
+      {
+        double v;
+        std::memcpy(&v, column.data + currentIndex * sizeof(double), sizeof(double));
+        return v * column.unit;
+      }
+    case BDSBunchBinaryFileColumn::float32:
+      {
+        float v;
+        std::memcpy(&v, column.data + currentIndex * sizeof(float), sizeof(float));
+        return (G4double)v * column.unit;
+      }
+    case BDSBunchBinaryFileColumn::int32:
+      {
+        int32_t v;
+        std::memcpy(&v, column.data + currentIndex * sizeof(int32_t), sizeof(int32_t));
+        return (G4double)v * column.unit;
+      }
+    default:
+      {return defaultValue;}
+    }
+}
+
+BDSParticleCoordsFull BDSBunchBinaryFile::GetNextParticleLocal()
+{
+  if (currentIndex >= nParticles)
+    {EndOfFileAction();}
+
+  G4double xv  = Value(x);
+  G4double yv  = Value(y);
+  G4double zv  = S.data ? Value(S) : Value(z);
+  G4double xpv = Value(xp) + Xp0;
+  G4double ypv = Value(yp) + Yp0;
+  G4double tv  = Value(t);
+  G4double Ev  = Value(E);
+  G4double Ekv = Value(Ek);
+  G4double Pv  = Value(P);
+  G4double w   = Value(weight, 1.0);
+  G4int type   = (G4int)Value(pdgid);
+  G4double zpv = zp.data ? Value(zp) : CalculateZp(xpv, ypv, 1);
+  currentIndex++;
+
+  G4bool updateParticleDefinition = changingParticleType;
+  if (anEnergyCoordinateInUse)
+    {
+      if (particleDefinition)
+        {
+          particleDefinition->SetEnergies(Ev, Ekv, Pv);
+          Ev = particleDefinition->TotalEnergy();
+        }
+      else
+        {updateParticleDefinition = true;}
+    }
+  else
+    {Ev = E0;}
+
+  if (updateParticleDefinition)
+    {
+      G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+      G4ParticleDefinition* particleDef = nullptr;
+      BDSIonDefinition* ionDef = nullptr;
+      if (type < 1e9) // not a pdg ion
+        {particleDef = particleTable->FindParticle(type);}
+      else
+        {
+          G4IonTable* ionTable = particleTable->GetIonTable();
+          G4int ionA, ionZ, ionLevel;
+          G4double ionE;
+          G4IonTable::GetNucleusByEncoding(type, ionZ, ionA, ionE, ionLevel);
+          ionDef = new BDSIonDefinition(ionA, ionZ, ionZ);
+          particleDef = ionTable->GetIon(ionDef->Z(), ionDef->A(), ionDef->ExcitationEnergy());
+        }
+
+      if (!particleDef)
+        {throw BDSException("BDSBunchBinaryFile> Particle \"" + std::to_string(type) + "\" not found");}
+      delete particleDefinition;
+      try
+        {
+          particleDefinition = new BDSParticleDefinition(particleDef, Ev, Ekv, Pv, ffact, ionDef);
+          Ev = particleDefinition->TotalEnergy();
+          particleDefinitionHasBeenUpdated = true;
+        }
+      catch (const BDSException& e)
+        {// if we throw an exception the object is invalid for the delete on the next loop
+          particleDefinition = nullptr;
+          throw e;
+        }
+    }
+
+  return BDSParticleCoordsFull(X0+xv, Y0+yv, Z0+zv, xpv, ypv, zpv, tv, zv, Ev, w);
+}
@@ -0,0 +1,233 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSBunchBinaryFileFormat.hh"
+#include "BDSBunchUserFile.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSUtilities.hh"
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#ifdef USE_GZSTREAM
+#include "src-external/gzstream/gzstream.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  /// A column to be written with a buffer of values that's flushed periodically.
+  struct ColumnToWrite
+  {
+    BDSBunchBinaryFileColumn description;
+    G4bool skip;
+    std::vector<char> buffer;
+    uint64_t nWritten;
+  };
+
+  /// Convert the userfile format string into column descriptions. Skipped columns
+  /// ("-") are kept with skip = true so that the input columns can be matched.
+  std::vector<ColumnToWrite> ParseFormat(const G4String& format, G4bool singlePrecision)
+  {
+    std::vector<ColumnToWrite> result;
+    for (const auto& column : BDS::ParseUserFileFormat(format))
+      {
+        ColumnToWrite col;
+        std::memset(&col.description, 0, sizeof(col.description));
+        col.skip = column.name == "skip";
+        col.nWritten = 0;
+        col.description.unit = column.unit;
+        if (column.name == "pdgid")
+          {col.description.dataType = BDSBunchBinaryFileColumn::int32;}
+        else
+          {col.description.dataType = singlePrecision ? BDSBunchBinaryFileColumn::float32 : BDSBunchBinaryFileColumn::float64;}
+        // the weight column is called "w" in the binary format as in the format string
+        G4String name = column.name == "weight" ? G4String("w") : column.name;
+        if (!col.skip)
+          {std::strncpy(col.description.name, name.c_str(), sizeof(col.description.name) - 1);}
+        result.push_back(col);
+      }
+    return result;
+  }
+
+  std::unique_ptr<std::istream> OpenInput(const G4String& fileName)
+  {
+    std::unique_ptr<std::istream> result;
+    if (BDS::EndsWith(fileName, ".gz"))
+      {
+#ifdef USE_GZSTREAM
+        result.reset(new igzstream(fileName.c_str()));
+#else
+        throw BDSException(__METHOD_NAME__, fileName + " is a compressed file but BDSIM is compiled without GZIP.");
+#endif
+      }
+    else
+      {result.reset(new std::ifstream(fileName));}
+    if (!result->good())
+      {throw BDSException(__METHOD_NAME__, "Cannot open file \"" + fileName + "\"");}
+    return result;
+  }
+}
+
+std::size_t BDS::BunchBinaryFileTypeSize(uint32_t dataType)
+{
+  switch (dataType)
+    {
+    case BDSBunchBinaryFileColumn::float64:
+      {return sizeof(double);}
+    case BDSBunchBinaryFileColumn::float32:
+      {return sizeof(float);}
+    case BDSBunchBinaryFileColumn::int32:
+      {return sizeof(int32_t);}
+    default:
+      {throw BDSException(__METHOD_NAME__, "unknown column data type " + std::to_string(dataType));}
+    }
+}
+
+G4long BDS::ConvertUserFileToBinaryBunchFile(const G4String& inputFileName,
+                                             const G4String& distrFileFormat,
+                                             const G4String& outputFileName,
+                                             G4int           nlinesIgnore,
+                                             G4bool          singlePrecision)
+{
+  std::vector<ColumnToWrite> columns = ParseFormat(distrFileFormat, singlePrecision);
+  uint32_t nColumnsOut = (uint32_t)std::count_if(columns.begin(), columns.end(), [](const ColumnToWrite& c){return !c.skip;});
+
+  // first pass - count the number of valid lines so we know the size of each column
+  uint64_t nParticles = 0;
+  std::string line;
+  {
+    auto input = OpenInput(inputFileName);
+    for (G4int i = 0; i < nlinesIgnore; i++)
+      {std::getline(*input, line);}
+    while (std::getline(*input, line))
+      {
+        if (!BDS::SkippableUserFileLine(line))
+          {nParticles++;}
+      }
+  }
+
+  // lay out the file
+  uint64_t offset = sizeof(BDSBunchBinaryFileHeader) + nColumnsOut * sizeof(BDSBunchBinaryFileColumn);
+  for (auto& col : columns)
+    {
+      if (col.skip)
+        {continue;}
+      offset = (offset + 7) & ~(uint64_t)7;
+      col.description.offset = offset;
+      offset += nParticles * BDS::BunchBinaryFileTypeSize(col.description.dataType);
+    }
+
+  std::ofstream output(outputFileName, std::ios::binary | std::ios::trunc);
+  if (!output.good())
+    {throw BDSException(__METHOD_NAME__, "Cannot open output file \"" + outputFileName + "\"");}
+
+  BDSBunchBinaryFileHeader header;
+  std::memcpy(header.magic, "BDSBUNCH", 8);
+  header.version    = BDS::bunchBinaryFileVersion;
+  header.nColumns   = nColumnsOut;
+  header.nParticles = nParticles;
+  output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const auto& col : columns)
+    {
+      if (!col.skip)
+        {output.write(reinterpret_cast<const char*>(&col.description), sizeof(col.description));}
+    }
+
+  // write out each column in chunks so we don't hold the whole file in memory
+  const std::size_t chunkSize = 1 << 20;
+  auto flush = [&](ColumnToWrite& col)
+               {
+                 if (col.buffer.empty())
+                   {return;}
+                 std::size_t typeSize = BDS::BunchBinaryFileTypeSize(col.description.dataType);
+                 output.seekp((std::streamoff)(col.description.offset + col.nWritten * typeSize));
+                 output.write(col.buffer.data(), (std::streamsize)col.buffer.size());
+                 col.nWritten += col.buffer.size() / typeSize;
+                 col.buffer.clear();
+               };
+
+  auto input = OpenInput(inputFileName);
+  G4long lineNumber = 0;
+  for (G4int i = 0; i < nlinesIgnore; i++)
+    {std::getline(*input, line); lineNumber++;}
+  uint64_t nRead = 0;
+  while (nRead < nParticles && std::getline(*input, line))
+    {
+      lineNumber++;
+      if (BDS::SkippableUserFileLine(line))
+        {continue;}
+      const char* p   = line.data();
+      const char* end = line.data() + line.size();
+      for (auto& col : columns)
+        {
+          G4double value = 0;
+          if (!BDS::ParseDouble(p, end, value))
+            {
+              G4String msg = "Invalid line at line " + std::to_string(lineNumber) + " in file \"" + inputFileName;
+              msg += "\". Expected " + std::to_string(columns.size()) + " columns.";
+              throw BDSException(__METHOD_NAME__, msg);
+            }
+          if (col.skip)
+            {continue;}
+          switch (col.description.dataType)
+            {
+            case BDSBunchBinaryFileColumn::float64:
+              {
+                const char* v = reinterpret_cast<const char*>(&value);
+                col.buffer.insert(col.buffer.end(), v, v + sizeof(double));
+                break;
+              }
+            case BDSBunchBinaryFileColumn::float32:
+              {
+                float f = (float)value;
+                const char* v = reinterpret_cast<const char*>(&f);
+                col.buffer.insert(col.buffer.end(), v, v + sizeof(float));
+                break;
+              }
+            case BDSBunchBinaryFileColumn::int32:
+              {
+                int32_t iv = (int32_t)value;
+                const char* v = reinterpret_cast<const char*>(&iv);
+                col.buffer.insert(col.buffer.end(), v, v + sizeof(int32_t));
+                break;
+              }
+            default:
+              {break;}
+            }
+          if (col.buffer.size() >= chunkSize)
+            {flush(col);}
+        }
+      nRead++;
+    }
+  for (auto& col : columns)
+    {flush(col);}
+
+  if (!output.good())
+    {throw BDSException(__METHOD_NAME__, "Error writing output file \"" + outputFileName + "\"");}
+  output.close();
+  return (G4long)nParticles;
+}
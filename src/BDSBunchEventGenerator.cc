@@ -41,6 +41,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 BDSBunchEventGenerator::BDSBunchEventGenerator():
   BDSBunchFileBased("eventgenerator"),
   eventGeneratorNEventsSkip(0),
+  eventGeneratorPrefetchNEvents(0),
   eventGeneratorMinX(0),
   eventGeneratorMaxX(0),
   eventGeneratorMinY(0),
@@ -77,6 +78,7 @@ void BDSBunchEventGenerator::SetOptions(const BDSParticleDefinition* beamParticl
   BDSBunchFileBased::SetOptions(beamParticle, beam, distrType, beamlineTransformIn, beamlineSIn);
   
   eventGeneratorNEventsSkip = beam.eventGeneratorNEventsSkip;
+  eventGeneratorPrefetchNEvents = beam.eventGeneratorPrefetchNEvents;
   eventGeneratorMinX  = beam.eventGeneratorMinX * CLHEP::m;
   eventGeneratorMaxX  = beam.eventGeneratorMaxX * CLHEP::m;
   eventGeneratorMinY  = beam.eventGeneratorMinY * CLHEP::m;
@@ -104,6 +106,8 @@ void BDSBunchEventGenerator::CheckParameters()
   BDSBunch::CheckParameters();
   if (eventGeneratorNEventsSkip < 0)
     {throw BDSException(__METHOD_NAME__, "eventGeneratorNEventsSkip < 0");}
+  if (eventGeneratorPrefetchNEvents < 0)
+    {throw BDSException(__METHOD_NAME__, "eventGeneratorPrefetchNEvents < 0");}
   if (eventGeneratorMinX >= eventGeneratorMaxX)
     {throw BDSException(__METHOD_NAME__, "eventGeneratorMinX >= eventGeneratorMaxX");}
   if (eventGeneratorMinY >= eventGeneratorMaxY)
@@ -168,10 +172,22 @@ G4bool BDSBunchEventGenerator::AcceptParticle(const BDSParticleCoordsFull& coord
                                               G4double rpOriginal,
                                               G4double kineticEnergy,
                                               G4int    pdgID)
+{
+  PrepareParticleFilter();
+  G4bool ek = kineticEnergy >= eventGeneratorMinEK && kineticEnergy <= eventGeneratorMaxEK;
+  return ek && AcceptParticleCoordinates(coords, rpOriginal, pdgID);
+}
+
+void BDSBunchEventGenerator::PrepareParticleFilter()
 {
   if (firstTime)
     {ParseAcceptedParticleIDs(); firstTime = false;}
+}
 
+G4bool BDSBunchEventGenerator::AcceptParticleCoordinates(const BDSParticleCoordsFull& coords,
+                                                         G4double rpOriginal,
+                                                         G4int    pdgID) const
+{
   G4bool x  = coords.x  >= eventGeneratorMinX+X0   && coords.x  <= eventGeneratorMaxX+X0;
   G4bool y  = coords.y  >= eventGeneratorMinY+Y0   && coords.y  <= eventGeneratorMaxY+Y0;
   G4bool z  = coords.z  >= eventGeneratorMinZ      && coords.z  <= eventGeneratorMaxZ;
@@ -179,14 +195,13 @@ G4bool BDSBunchEventGenerator::AcceptParticle(const BDSParticleCoordsFull& coord
   G4bool yp = coords.yp >= eventGeneratorMinYp+Yp0 && coords.yp <= eventGeneratorMaxYp+Yp0;
   G4bool zp = coords.zp >= eventGeneratorMinZp     && coords.zp <= eventGeneratorMaxZp;
   G4bool t  = coords.T  >= eventGeneratorMinT      && coords.T+T0  <= eventGeneratorMaxT+T0;
-  G4bool ek = kineticEnergy >= eventGeneratorMinEK && kineticEnergy <= eventGeneratorMaxEK;
   G4bool rp = rpOriginal >= eventGeneratorMinRp && rpOriginal < eventGeneratorMaxRp;
   
   G4bool allowedParticle = true;
   if (testOnParticleType)
     {allowedParticle = acceptedParticles.count(pdgID) == 1;}
   
-  return x && y && z && xp && yp && zp && rp && t && ek && allowedParticle;
+  return x && y && z && xp && yp && zp && rp && t && allowedParticle;
 }
 
 G4RotationMatrix BDSBunchEventGenerator::ReferenceBeamMomentumOffset() const
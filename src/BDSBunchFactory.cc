@@ -17,6 +17,7 @@ You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSBunch.hh"
+#include "BDSBunchBinaryFile.hh"
 #include "BDSBunchBox.hh"
 #include "BDSBunchCircle.hh"
 #include "BDSBunchComposite.hh"
@@ -134,6 +135,8 @@ BDSBunch* BDSBunchFactory::CreateBunch(const BDSParticleDefinition* beamParticle
       {bdsBunch = new BDSBunchBox(); break;}
     case BDSBunchType::halosigma:
       {bdsBunch = new BDSBunchHaloFlatSigma(); break;}
+    case BDSBunchType::binaryfile:
+      {bdsBunch = new BDSBunchBinaryFile(); break;}
     default:
       {bdsBunch = new BDSBunch(); break;}
     }
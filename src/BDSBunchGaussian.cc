@@ -20,6 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSGlobalConstants.hh"
+#include "BDSParticleCoordsBatch.hh"
 
 #include "parser/beam.h"
 
@@ -28,8 +29,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "CLHEP/Matrix/Vector.h"
 #include "CLHEP/RandomObjects/RandMultiGauss.h"
 #include "CLHEP/Units/PhysicalConstants.h"
+#include "CLHEP/Units/SystemOfUnits.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <vector>
 
 /// helper method
@@ -57,10 +61,14 @@ BDSBunchGaussian::BDSBunchGaussian(const G4String& nameIn):
   sigmaGM(CLHEP::HepSymMatrix(6)),
   gaussMultiGen(nullptr),
   offsetSampleMean(false),
+  gaussEngine(nullptr),
+  gaussMu{0,0,0,0,0,0},
+  gaussU{},
+  gaussSigmas{0,0,0,0,0,0},
+  gaussHaveNextNormal(false),
+  gaussNextNormal(0),
   iPartIteration(0)
-{
-  coordinates = {&x0_v, &xp_v, &y0_v, &yp_v, &z0_v, &zp_v, &E_v, &t_v, &weight_v};
-}
+{;}
 
 BDSBunchGaussian::~BDSBunchGaussian()
 {
@@ -101,8 +109,7 @@ void BDSBunchGaussian::BeginOfRunAction(G4int numberOfEvents,
   if (!offsetSampleMean)
     {return;}
   /// clear previous means
-  for (auto& vec : coordinates)
-    {vec->clear();}
+  preGenerated.Clear();
   iPartIteration = 0;
   
   PreGenerateEvents(numberOfEvents);
@@ -158,6 +165,22 @@ CLHEP::RandMultiGauss* BDSBunchGaussian::CreateMultiGauss(CLHEP::HepRandomEngine
          << sigma << G4endl;
 #endif
   G4cout << __METHOD_NAME__ << "confirmed: positive definite matrix" << G4endl;
+
+  // keep the same decomposition as RandMultiGauss for generating many particles at once
+  CLHEP::HepSymMatrix tempS(sigma); // diagonalize does not take a const matrix
+  CLHEP::HepMatrix U = diagonalize(&tempS); // S = U Sdiag U.T()
+  CLHEP::HepSymMatrix D = sigma.similarityT(U);
+  for (G4int i = 0; i < 6; i++)
+    {
+      gaussMu[i] = mu[i];
+      G4double s2 = D(i+1,i+1);
+      gaussSigmas[i] = s2 > 0 ? std::sqrt(s2) : 0;
+      for (G4int j = 0; j < 6; j++)
+        {gaussU[i][j] = U(i+1,j+1);}
+    }
+  gaussEngine = &anEngine;
+  gaussHaveNextNormal = false;
+  
   return new CLHEP::RandMultiGauss(anEngine,mu,sigma); 
 }
 
@@ -165,41 +188,34 @@ void BDSBunchGaussian::PreGenerateEvents(G4int nGenerate)
 {
   G4cout << __METHOD_NAME__ << "Pregenerating " << nGenerate << " events." << G4endl;
   // generate all required primaries first
+  preGenerated.Clear();
+  preGenerated.Reserve((std::size_t)std::max(nGenerate, 0));
+  GetNextParticlesLocalCoords(nGenerate, preGenerated);
+  
   G4double x_a = 0.0, xp_a = 0.0, y_a = 0.0, yp_a = 0.0;
   G4double z_a = 0.0, zp_a = 0.0, E_a  = 0.0, t_a  = 0.0;
 
+  auto& pg = preGenerated;
   for (G4int iParticle = 0; iParticle < nGenerate; ++iParticle)
     {
-      BDSParticleCoordsFull fire = GetNextParticleLocalCoords();
-
       G4double nT = (G4double)iParticle + 1;
       G4double d = 0;
-      d    = fire.x - x_a;
+      d    = pg.x[iParticle] - x_a;
       x_a  = x_a + (d/nT);
-      d    = fire.xp - xp_a;
+      d    = pg.xp[iParticle] - xp_a;
       xp_a = xp_a + (d/nT);
-      d    = fire.y - y_a;
+      d    = pg.y[iParticle] - y_a;
       y_a  = y_a + (d/nT);
-      d    = fire.yp - yp_a;
+      d    = pg.yp[iParticle] - yp_a;
       yp_a = yp_a + (d/nT);
-      d    = fire.z - z_a;
+      d    = pg.z[iParticle] - z_a;
       z_a  = z_a + (d/nT);
-      d    = fire.zp - zp_a;
+      d    = pg.zp[iParticle] - zp_a;
       zp_a = zp_a + (d/nT);
-      d    = fire.totalEnergy - E_a;
+      d    = pg.totalEnergy[iParticle] - E_a;
       E_a  = E_a + (d/nT);
-      d    = fire.T - t_a;
+      d    = pg.T[iParticle] - t_a;
       t_a  = t_a + (d/nT);
-      
-      x0_v.push_back(fire.x);
-      xp_v.push_back(fire.xp);
-      y0_v.push_back(fire.y);
-      yp_v.push_back(fire.yp);
-      z0_v.push_back(fire.z);
-      zp_v.push_back(fire.zp);
-      E_v.push_back(fire.totalEnergy);
-      t_v.push_back(fire.T);
-      weight_v.push_back(fire.weight);
     }
 
   // Compute difference between sample mean and specified means
@@ -215,14 +231,14 @@ void BDSBunchGaussian::PreGenerateEvents(G4int nGenerate)
   // Offset with different w.r.t. central value
   for (G4int iParticle = 0; iParticle < nGenerate; ++iParticle)
     {
-      x0_v[iParticle] -= x_a;
-      xp_v[iParticle] -= xp_a;
-      y0_v[iParticle] -= y_a;
-      yp_v[iParticle] -= yp_a;
-      z0_v[iParticle] -= z_a;
-      zp_v[iParticle] -= zp_a;
-      E_v[iParticle]  -= E_a;
-      t_v[iParticle]  -= t_a;
+      pg.x[iParticle]  -= x_a;
+      pg.xp[iParticle] -= xp_a;
+      pg.y[iParticle]  -= y_a;
+      pg.yp[iParticle] -= yp_a;
+      pg.z[iParticle]  -= z_a;
+      pg.zp[iParticle] -= zp_a;
+      pg.totalEnergy[iParticle] -= E_a;
+      pg.T[iParticle]  -= t_a;
     }
 }
   
@@ -232,15 +248,15 @@ BDSParticleCoordsFull BDSBunchGaussian::GetNextParticleLocal()
     {
       // iPartIteration should never exceed the size of each vector.
       // the units are already correct in the vector of stored coordinates
-      G4double x      = x0_v[iPartIteration];
-      G4double xp     = xp_v[iPartIteration];
-      G4double y      = y0_v[iPartIteration];
-      G4double yp     = yp_v[iPartIteration];
-      G4double z      = z0_v[iPartIteration];
-      G4double zp     = zp_v[iPartIteration];
-      G4double t      = t_v[iPartIteration];
-      G4double E      = E_v[iPartIteration];
-      G4double weight = weight_v[iPartIteration];
+      G4double x      = preGenerated.x[iPartIteration];
+      G4double xp     = preGenerated.xp[iPartIteration];
+      G4double y      = preGenerated.y[iPartIteration];
+      G4double yp     = preGenerated.yp[iPartIteration];
+      G4double z      = preGenerated.z[iPartIteration];
+      G4double zp     = preGenerated.zp[iPartIteration];
+      G4double t      = preGenerated.T[iPartIteration];
+      G4double E      = preGenerated.totalEnergy[iPartIteration];
+      G4double weight = preGenerated.weight[iPartIteration];
       
       iPartIteration++;
       return BDSParticleCoordsFull(x,y,z,xp,yp,zp,t,S0,E,weight);
@@ -273,3 +289,97 @@ BDSParticleCoordsFull BDSBunchGaussian::GetNextParticleLocalCoords()
   
   return BDSParticleCoordsFull(x,y,z,xp,yp,zp,t,S0+dz,E,/*weight=*/1.0);
 }
+
+void BDSBunchGaussian::GetNextParticlesLocal(G4int nParticles,
+                                             BDSParticleCoordsBatch& batch)
+{
+  if (offsetSampleMean)
+    {BDSBunch::GetNextParticlesLocal(nParticles, batch);} // copy from pre-generated ones
+  else
+    {GetNextParticlesLocalCoords(nParticles, batch);}
+}
+
+void BDSBunchGaussian::GetNextParticlesLocalCoords(G4int nParticles,
+                                                   BDSParticleCoordsBatch& batch)
+{
+  if (nParticles <= 0)
+    {return;}
+  if (!gaussEngine)
+    {throw BDSException(__METHOD_NAME__, "multivariate Gaussian generator not created");}
+  
+  // draw the deviates in the same order as RandMultiGauss::fire() (6 per particle),
+  // but store each of the 6 contiguously so the transform below is a simple loop
+  const std::size_t n = (std::size_t)nParticles;
+  normals.resize(6*n);
+  for (std::size_t k = 0; k < n; k++)
+    {
+      for (std::size_t j = 0; j < 6; j++)
+        {normals[j*n + k] = gaussSigmas[j] * NormalDeviate();}
+    }
+
+  const std::size_t offset = batch.Size();
+  batch.Resize(offset + n);
+  // rows of the multivariate Gaussian vector in the order of meansGM
+  G4double* rows[6] = {&batch.x[offset], &batch.xp[offset], &batch.y[offset],
+                       &batch.yp[offset], &batch.T[offset], &batch.totalEnergy[offset]};
+  for (std::size_t i = 0; i < 6; i++)
+    {
+      G4double* out = rows[i];
+      for (std::size_t j = 0; j < 6; j++)
+        {
+          const G4double u = gaussU[i][j];
+          const G4double* nj = &normals[j*n];
+          for (std::size_t k = 0; k < n; k++)
+            {out[k] += u * nj[k];}
+        }
+      const G4double mu = gaussMu[i];
+      for (std::size_t k = 0; k < n; k++)
+        {out[k] = mu + out[k];}
+    }
+
+  // reintroduce units as in GetNextParticleLocalCoords
+  G4double* x  = &batch.x[offset];
+  G4double* xp = &batch.xp[offset];
+  G4double* y  = &batch.y[offset];
+  G4double* yp = &batch.yp[offset];
+  G4double* z  = &batch.z[offset];
+  G4double* zp = &batch.zp[offset];
+  G4double* t  = &batch.T[offset];
+  G4double* s  = &batch.s[offset];
+  G4double* E  = &batch.totalEnergy[offset];
+  G4double* w  = &batch.weight[offset];
+  const G4double tNoSpread = T0 * CLHEP::s;
+  for (std::size_t k = 0; k < n; k++)
+    {
+      x[k] *= CLHEP::m;
+      y[k] *= CLHEP::m;
+      t[k]  = finiteSigmaT ? t[k] * CLHEP::s : tNoSpread;
+      E[k]  = finiteSigmaE ? E0 * E[k] : E0;
+      z[k]  = Z0;
+      s[k]  = S0;
+      w[k]  = 1.0;
+    }
+  for (std::size_t k = 0; k < n; k++)
+    {zp[k] = CalculateZp(xp[k], yp[k], Zp0);}
+}
+
+G4double BDSBunchGaussian::NormalDeviate()
+{
+  if (gaussHaveNextNormal)
+    {
+      gaussHaveNextNormal = false;
+      return gaussNextNormal;
+    }
+  G4double r, v1, v2;
+  do
+    {
+      v1 = 2.0 * gaussEngine->flat() - 1.0;
+      v2 = 2.0 * gaussEngine->flat() - 1.0;
+      r  = v1*v1 + v2*v2;
+    }
+  while (r > 1.0);
+  G4double fac = std::sqrt(-2.0 * std::log(r) / r);
+  gaussNextNormal = v2 * fac;
+  gaussHaveNextNormal = true;
+  return v1 * fac;
+}
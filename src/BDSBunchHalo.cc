@@ -50,7 +50,8 @@ BDSBunchHalo::BDSBunchHalo():
   haloXpCutOuter(0.0),
   haloYpCutOuter(0.0),
   haloPSWeightParameter(0.0),
-  weightFunction(""),  
+  weightFunction(""),
+  weightFunctionType(WeightFunction::flat),  
   emitInnerX(0.0), emitInnerY(0.0),
   emitOuterX(0.0), emitOuterY(0.0),
   xMax(0.0), yMax(0.0),
@@ -87,6 +88,14 @@ void  BDSBunchHalo::SetOptions(const BDSParticleDefinition* beamParticle,
   haloYpCutOuter        = G4double(beam.haloYpCutOuter);
   haloPSWeightParameter = G4double(beam.haloPSWeightParameter);
   weightFunction = G4String(beam.haloPSWeightFunction);
+  if (weightFunction == "oneoverr")
+    {weightFunctionType = WeightFunction::oneoverr;}
+  else if (weightFunction == "oneoverrsqrd")
+    {weightFunctionType = WeightFunction::oneoverrsqrd;}
+  else if (weightFunction == "exp")
+    {weightFunctionType = WeightFunction::exp;}
+  else // "flat", "one" or empty - invalid values are caught in CheckParameters
+    {weightFunctionType = WeightFunction::flat;}
 
   G4double ex,ey; // dummy variables we don't need
   SetEmittances(beamParticle, beam, emitX, emitY, ex, ey);
@@ -152,31 +161,34 @@ BDSParticleCoordsFull BDSBunchHalo::GetNextParticleLocal()
         // determine weight, initialise 1 so always passes
         double wx = 1.0;
         double wy = 1.0;
-        if (weightFunction == "flat" || weightFunction.empty() || weightFunction == "one")
+        switch (weightFunctionType)
           {
-            wx = 1.0;
-            wy = 1.0;
-          }
-        else if (weightFunction == "oneoverr")
-          {
-            //abs because power of double - must be positive
-            wx = std::pow(std::abs(emitInnerX / emitXSp), haloPSWeightParameter);
-            wy = std::pow(std::abs(emitInnerY / emitYSp), haloPSWeightParameter);
-          }
-        else if (weightFunction == "oneoverrsqrd")
-          {
-            //abs because power of double - must be positive
-            double eXsqrd = std::pow(std::abs(emitXSp), 2);
-            double eYsqrd = std::pow(std::abs(emitYSp), 2);
-            double eXInsq = std::pow(std::abs(emitInnerX), 2);
-            double eYInsq = std::pow(std::abs(emitInnerY), 2);
-            wx = std::pow(std::abs(eXInsq / eXsqrd), haloPSWeightParameter);
-            wy = std::pow(std::abs(eYInsq / eYsqrd), haloPSWeightParameter);
-          }
-        else if (weightFunction == "exp")
-          {
-            wx = std::exp(-(emitXSp * haloPSWeightParameter) / (emitInnerX));
-            wy = std::exp(-(emitYSp * haloPSWeightParameter) / (emitInnerY));
+          case WeightFunction::flat:
+            {break;}
+          case WeightFunction::oneoverr:
+            {
+              //abs because power of double - must be positive
+              wx = std::pow(std::abs(emitInnerX / emitXSp), haloPSWeightParameter);
+              wy = std::pow(std::abs(emitInnerY / emitYSp), haloPSWeightParameter);
+              break;
+            }
+          case WeightFunction::oneoverrsqrd:
+            {
+              //abs because power of double - must be positive
+              double eXsqrd = std::pow(std::abs(emitXSp), 2);
+              double eYsqrd = std::pow(std::abs(emitYSp), 2);
+              double eXInsq = std::pow(std::abs(emitInnerX), 2);
+              double eYInsq = std::pow(std::abs(emitInnerY), 2);
+              wx = std::pow(std::abs(eXInsq / eXsqrd), haloPSWeightParameter);
+              wy = std::pow(std::abs(eYInsq / eYsqrd), haloPSWeightParameter);
+              break;
+            }
+          case WeightFunction::exp:
+            {
+              wx = std::exp(-(emitXSp * haloPSWeightParameter) / (emitInnerX));
+              wy = std::exp(-(emitYSp * haloPSWeightParameter) / (emitInnerY));
+              break;
+            }
           }
         
 #ifdef BDSDEBUG
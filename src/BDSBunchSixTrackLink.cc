@@ -23,11 +23,18 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSParticleDefinition.hh"
 
 #include "globals.hh"
+#include "G4Electron.hh"
+#include "G4GenericIon.hh"
 #include "G4IonTable.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4ParticleTable.hh"
 #include "G4String.hh"
 
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <array>
+#include <map>
+#include <string>
 #include <vector>
 
 BDSBunchSixTrackLink::BDSBunchSixTrackLink():
@@ -40,7 +47,11 @@ BDSBunchSixTrackLink::BDSBunchSixTrackLink():
 {;}
 
 BDSBunchSixTrackLink::~BDSBunchSixTrackLink()
-{;}
+{
+  ClearParticles();
+  for (auto& kv : speciesDefinitions)
+    {delete kv.second;}
+}
 
 BDSParticleCoordsFull BDSBunchSixTrackLink::GetNextParticleLocal()
 {
@@ -53,16 +64,16 @@ BDSParticleCoordsFull BDSBunchSixTrackLink::GetNextParticleLocal()
   G4int ci = currentIndex;
   currentIndex++;
   
-  auto particle = particles[ci];
-  currentParticleDefinition = particle->particleDefinition;
+  const Particle& particle = particles[ci];
+  currentParticleDefinition = particle.particleDefinition;
   particleDefinitionHasBeenUpdated = true;
   //UpdateGeant4ParticleDefinition(particleDefinition->PDGID()); // TBC
   UpdateIonDefinition();
   
-  currentExternalParticleID = particle->externalParticleID;
-  currentExternalParentID   = particle->externalParentID;
+  currentExternalParticleID = particle.externalParticleID;
+  currentExternalParentID   = particle.externalParentID;
   
-  return particle->coords;
+  return particle.coords;
 }
 
 void BDSBunchSixTrackLink::AddParticle(BDSParticleDefinition*       particleDefinitionIn,
@@ -70,17 +81,104 @@ void BDSBunchSixTrackLink::AddParticle(BDSParticleDefinition*       particleDefi
                                        int   externalParticleID,
                                        int   externalParentID)
 {
-  particles.emplace_back(new BDSParticleExternal(particleDefinitionIn, coordsIn, externalParticleID, externalParentID));
+  ownedDefinitions.push_back(particleDefinitionIn);
+  particles.push_back({particleDefinitionIn, coordsIn, externalParticleID, externalParentID});
   size = (G4int)particles.size();
 }
 
+G4int BDSBunchSixTrackLink::AddParticles(const BDSLinkParticlesIn& in)
+{
+  if (in.n <= 0)
+    {return 0;}
+  if (!in.x || !in.y || !in.xp || !in.yp || !in.totalEnergy || !in.pdgID)
+    {throw BDSException(__METHOD_NAME__, "x, y, xp, yp, totalEnergy and pdgID arrays are required");}
+
+  particles.reserve(particles.size() + (std::size_t)in.n);
+
+  // cache the last species as a bunch is mostly one species
+  BDSParticleDefinition* lastDefinition = nullptr;
+  std::array<G4int,4> lastKey = {0,0,0,0};
+  for (G4int i = 0; i < in.n; i++)
+    {
+      G4int pdgID = (G4int)in.pdgID[i];
+      std::array<G4int,4> key = {pdgID, 0, 0, 0};
+      if (pdgID > 1000000000) // nucleus PDG code 10LZZZAAAI
+        {
+          G4int z = in.Z ? (G4int)in.Z[i] : (pdgID / 10000) % 1000;
+          G4int a = in.A ? (G4int)in.A[i] : (pdgID / 10) % 1000;
+          key = {pdgID, z, a, in.charge ? (G4int)in.charge[i] : z};
+        }
+      if (!lastDefinition || key != lastKey)
+        {
+          lastDefinition = SpeciesDefinition(key[0], key[1], key[2], key[3]);
+          lastKey = key;
+        }
+
+      G4double xp = in.xp[i];
+      G4double yp = in.yp[i];
+      BDSParticleCoordsFull coords(in.x[i] * CLHEP::m,
+                                   in.y[i] * CLHEP::m,
+                                   0,
+                                   xp,
+                                   yp,
+                                   BDSBunch::CalculateZp(xp, yp, 1),
+                                   in.t ? in.t[i] * CLHEP::s : 0,
+                                   0,
+                                   in.totalEnergy[i] * CLHEP::GeV,
+                                   in.weight ? in.weight[i] : 1.0);
+      particles.push_back({lastDefinition,
+                           coords,
+                           in.particleID ? (G4int)in.particleID[i] : i,
+                           in.parentID   ? (G4int)in.parentID[i]   : 0});
+    }
+  size = (G4int)particles.size();
+  return in.n;
+}
+
+BDSParticleDefinition* BDSBunchSixTrackLink::SpeciesDefinition(G4int pdgID,
+                                                               G4int Z,
+                                                               G4int A,
+                                                               G4int charge)
+{
+  std::array<G4int,4> key = {pdgID, Z, A, charge};
+  auto search = speciesDefinitions.find(key);
+  if (search != speciesDefinitions.end())
+    {return search->second;}
+
+  // The energy of a shared definition is nominal - only the species information is used
+  // in the link as the energy of each particle is in its coordinates.
+  const G4double nominalEk = 1*CLHEP::GeV;
+  BDSParticleDefinition* result = nullptr;
+  if (Z > 0)
+    {
+      G4GenericIon::GenericIonDefinition();
+      BDSIonDefinition ionDef(A, Z, (G4double)charge);
+      G4IonTable* ionTable = G4ParticleTable::GetParticleTable()->GetIonTable();
+      G4double mass = ionTable->GetIonMass(Z, A);
+      mass += ionDef.NElectrons()*G4Electron::Definition()->GetPDGMass();
+      G4String name = "ion " + std::to_string(Z) + " " + std::to_string(A) + " " + std::to_string(charge);
+      result = new BDSParticleDefinition(name, mass, ionDef.Charge(), 0, nominalEk, 0, 1, &ionDef, pdgID);
+    }
+  else
+    {
+      G4ParticleDefinition* particleDef = G4ParticleTable::GetParticleTable()->FindParticle(pdgID);
+      if (!particleDef)
+        {throw BDSException(__METHOD_NAME__, "PDG ID \"" + std::to_string(pdgID) + "\" not found in particle table");}
+      result = new BDSParticleDefinition(particleDef, 0, nominalEk, 0, 1);
+    }
+  speciesDefinitions[key] = result;
+  return result;
+}
+
 void BDSBunchSixTrackLink::ClearParticles()
 {
   currentIndex = 0;
   size = 0;
-  for (auto p : particles)
-    {delete p;}
-  particles.clear();
+  currentParticleDefinition = nullptr;
+  for (auto def : ownedDefinitions)
+    {delete def;}
+  ownedDefinitions.clear();
+  particles.clear(); // keeps capacity for the next bunch
 }
 
 void BDSBunchSixTrackLink::UpdateGeant4ParticleDefinition(G4int pdgID)
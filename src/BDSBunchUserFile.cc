@@ -37,13 +37,20 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 
 #include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
 #include <fstream>
-#include <regex>
 #include <set>
 #include <string>
 #include <sstream>
 #include <vector>
 
+#include <sys/stat.h>
+
+template <class T>
+const G4long BDSBunchUserFile<T>::indexStride = 1000;
+
 template <class T>
 BDSBunchUserFile<T>::BDSBunchUserFile():
   BDSBunchFileBased("userfile"),
@@ -56,10 +63,13 @@ BDSBunchUserFile<T>::BDSBunchUserFile():
   anEnergyCoordinateInUse(false),
   changingParticleType(false),
   endOfFileReached(false),
+  useIndexFile(false),
+  currentOffset(0),
+  validLineCounter(0),
+  haveBufferedLine(false),
   matchDistrFileLength(false)
 {
   ffact = BDSGlobalConstants::Instance()->FFact();
-  comment = std::regex("^\\s*\\#|\\!.*");
 }
 
 template<class T>
@@ -86,6 +96,9 @@ void BDSBunchUserFile<T>::OpenBunchFile()
       printedOutFirstTime = true;
     }
   lineCounter = 0;
+  currentOffset = 0;
+  validLineCounter = 0;
+  haveBufferedLine = false;
   InputBunchFile.open(distrFilePath);
   if (!InputBunchFile.good())
     {throw BDSException("BDSBunchUserFile::OpenBunchFile>", "Cannot open bunch file " + distrFilePath);}
@@ -102,156 +115,159 @@ void BDSBunchUserFile<T>::CloseBunchFile()
 template<class T>
 void BDSBunchUserFile<T>::ParseFileFormat()
 {
-  struct BDSBunchUserFile::Doublet sd;
-
-  std::regex colons(":");
-  std::vector<std::string> results;
-  std::sregex_token_iterator iter(bunchFormat.begin(), bunchFormat.end(), colons, -1);
-  std::sregex_token_iterator end;
-  for (; iter != end; ++iter)
+  for (const auto& column : BDS::ParseUserFileFormat(bunchFormat))
     {
-      std::string res = (*iter).str();
-      results.push_back(res);
+      if (column.name == "E" || column.name == "Ek" || column.name == "P")
+        {anEnergyCoordinateInUse = true;}
+      else if (column.name == "S")
+        {useCurvilinear = true;}
+      else if (column.name == "pdgid")
+        {changingParticleType = true;}
+      fields.push_back({column.name, column.unit});
+    }
+}
+
+template<class T>
+G4bool BDSBunchUserFile<T>::ReadLine(std::string& line)
+{
+  if (haveBufferedLine)
+    {// offset and line counter were already advanced when this was read
+      line.swap(bufferedLine);
+      haveBufferedLine = false;
+      return true;
     }
-  for (auto const& token : results)
+  if (!std::getline(InputBunchFile, line))
+    {return false;}
+  currentOffset += (std::streamoff)line.size() + 1; // +1 for the new line character
+  lineCounter++;
+  return true;
+}
+
+template<class T>
+G4bool BDSBunchUserFile<T>::NoMoreLines() const
+{
+  return !haveBufferedLine && (InputBunchFile.eof() || InputBunchFile.fail());
+}
+
+template<class T>
+void BDSBunchUserFile<T>::SeekToByte(std::streamoff offset)
+{
+  haveBufferedLine = false;
+  // generic implementation for streams that can't seek - read forward without parsing
+  if (offset < currentOffset || InputBunchFile.eof() || InputBunchFile.fail())
     {
-      G4String vari = "";
-      G4String rest = "";
-      if(token.substr(0,1)=="E" || token.substr(0,1)=="P")
-        {
-          anEnergyCoordinateInUse = true;
-          if (token.substr(0,2)=="Ek")
-            {//Kinetic energy (longer name).
-              vari = token.substr(0,2);
-              rest = token.substr(2);
-            }
-          else
-            {
-              vari = token.substr(0,1);
-              rest = token.substr(1);
-            }
-          CheckAndParseUnits(vari, rest, BDS::ParseEnergyUnit);
-        }
-      else if (token.substr(0,1)=="t")
-        {
-          vari = token.substr(0, 1);
-          rest = token.substr(1);
-          CheckAndParseUnits(vari, rest, BDS::ParseTimeUnit);
-        }
-      else if ( ( token.substr(0,1)=="x" && token.substr(1,1)!="p" ) ||
-                ( token.substr(0,1)=="y" && token.substr(1,1)!="p" ) ||
-                ( token.substr(0,1)=="z" && token.substr(1,1)!="p" ) )
-        {
-          vari = token.substr(0,1);
-          rest = token.substr(1);
-          CheckAndParseUnits(vari, rest, BDS::ParseLengthUnit);
-        }
-      else if ( (token.substr(0,2)=="xp") ||
-                (token.substr(0,2)=="yp") ||
-                (token.substr(0,2)=="zp") )
-        {
-          vari = token.substr(0,2);
-          rest = token.substr(2);
-          CheckAndParseUnits(vari, rest, BDS::ParseAngleUnit);
-        }
-      else if (token.substr(0, 1) == "S")
-        {
-          vari = token.substr(0, 1);
-          rest = token.substr(1);
-          CheckAndParseUnits(vari, rest, BDS::ParseLengthUnit);
-          useCurvilinear = true;
-        }
-      else if(token.substr(0,5)=="pdgid")
-        {
-          changingParticleType = true;
-          sd.name="pdgid";
-          sd.unit=1;
-          fields.push_back(sd);
-        }
-      else if(token.substr(0,1)=="w")
-        {
-          sd.name="weight";
-          sd.unit=1;
-          fields.push_back(sd);
-        }
-      else if (token.substr(0,1)=="-")
-        {
-          // skip
-          sd.name="skip";
-          sd.unit=1;
-          fields.push_back(sd);
-        }
-      else
-        {
-          G4String message = "Cannot determine bunch data format. Failed at token: " + token;
-          throw BDSException(__METHOD_NAME__, message);
-        }
+      InputBunchFile.clear();
+      InputBunchFile.close();
+      InputBunchFile.open(distrFilePath);
+      currentOffset = 0;
     }
-  
-  std::set<G4String> energyKeys = {"E", "Ek", "P"};
-  CheckConflictingParameters(energyKeys);
-  
-  std::set<G4String> zKeys = {"z", "S"};
-  CheckConflictingParameters(zKeys);
+  InputBunchFile.ignore(offset - currentOffset);
+  currentOffset = offset;
+}
+
+template<>
+void BDSBunchUserFile<std::ifstream>::SeekToByte(std::streamoff offset)
+{
+  haveBufferedLine = false;
+  InputBunchFile.clear();
+  InputBunchFile.seekg(offset);
+  currentOffset = offset;
 }
 
-template <typename T>
-void BDSBunchUserFile<T>::CheckConflictingParameters(const std::set<G4String>& s) const
+template<class T>
+void BDSBunchUserFile<T>::SeekToValidLine(G4long iValidLine)
 {
-  auto inSet  = [=](const G4String& v){return s.find(v) != s.end();};
-  auto inSetD = [=](const BDSBunchUserFile::Doublet& v){return inSet(v.name);};
-  int  count  = std::count_if(fields.begin(), fields.end(), inSetD);
-  if (count > 1)
+  if (lineIndex.empty())
+    {throw BDSException("BDSBunchUserFile::SeekToValidLine>", "no valid lines in file \"" + distrFilePath + "\"");}
+  G4long iEntry = std::min(iValidLine / indexStride, (G4long)lineIndex.size() - 1);
+  endOfFileReached = false;
+  G4bool readForward = !NoMoreLines() && iValidLine >= validLineCounter && iEntry * indexStride <= validLineCounter;
+  if (!readForward)
+    {// only jump with the index if it's not possible to read forward from the current position
+      const IndexEntry& entry = lineIndex[(std::size_t)iEntry];
+      SeekToByte(entry.offset);
+      lineCounter = entry.lineNumber;
+      validLineCounter = iEntry * indexStride;
+    }
+
+  // read forward the remaining lines up to and including the target valid line and keep
+  // it so it's returned by the next ReadLine
+  std::string line;
+  while (ReadLine(line))
     {
-      G4String message = "More than one of the following set in user file columns (\"distrFileFormat\") ";
-      for (const auto& st : s)
+      if (BDS::SkippableUserFileLine(line))
+        {continue;}
+      if (validLineCounter == iValidLine)
         {
-          message += st;
-          message += ", ";
+          bufferedLine.swap(line);
+          haveBufferedLine = true;
+          return;
         }
-      message += "\nPossibly conflicting information. Ensure only one by skipping others with \"-\" symbol";
-      throw BDSException("BDSBunchUserFile::CheckConflictingParameters>", message);
+      validLineCounter++;
     }
 }
 
-template <typename T>
-template <typename U>
-void BDSBunchUserFile<T>::CheckAndParseUnits(const G4String& uName,
-                                             const G4String& rest,
-                                             U unitParser)
+template<class T>
+std::string BDSBunchUserFile<T>::FileSignature() const
+{
+  struct stat buffer;
+  if (stat(distrFilePath.c_str(), &buffer) != 0)
+    {return "";}
+  return std::to_string((long long)buffer.st_size) + " " + std::to_string((long long)buffer.st_mtime);
+}
+
+template<class T>
+G4bool BDSBunchUserFile<T>::LoadIndexFile()
 {
-  struct BDSBunchUserFile::Doublet sd;
-  if (rest.empty())
+  std::ifstream indexFile(IndexFileName());
+  if (!indexFile.good())
+    {return false;}
+
+  std::string signature;
+  std::getline(indexFile, signature);
+  G4long nlinesIgnoreInFile = 0;
+  G4long strideInFile = 0;
+  G4long nLinesValid = 0;
+  std::size_t nEntries = 0;
+  indexFile >> nlinesIgnoreInFile >> strideInFile >> nLinesValid >> nEntries;
+  if (signature != FileSignature() || nlinesIgnoreInFile != nlinesIgnore || strideInFile != indexStride || !indexFile.good())
     {
-      sd.name = uName;
-      sd.unit = 1.0;
-      fields.push_back(sd);
-      return;
+      G4cout << "BDSBunchUserFile> index file \"" << IndexFileName() << "\" does not match distribution file -> rebuilding" << G4endl;
+      return false;
     }
   
-  G4int pos1 = (G4int)rest.find("[");
-  G4int pos2 = (G4int)rest.find("]");
-  if (pos1 < 0 || pos2 < 0)
+  lineIndex.clear();
+  lineIndex.reserve(nEntries);
+  IndexEntry entry;
+  for (std::size_t i = 0; i < nEntries; i++)
     {
-      G4String message = "Missing bracket [] in units of \"distrFileFormat\"\n";
-      message += "variable : \"" + uName + "\" and unit \"" + rest + "\"";
-      throw BDSException("BDSBunchUserFile::CheckAndParseUnits>", message);
+      indexFile >> entry.offset >> entry.lineNumber;
+      lineIndex.push_back(entry);
     }
-  else
+  if (indexFile.fail())
     {
-      G4String fmt = rest.substr(pos1 + 1, pos2 - 1);
-      sd.name = uName;
-      sd.unit = unitParser(fmt);
-      fields.push_back(sd);
+      lineIndex.clear();
+      return false;
     }
+  nLinesValidData = nLinesValid;
+  G4cout << "BDSBunchUserFile> using index file \"" << IndexFileName() << "\"" << G4endl;
+  return true;
 }
 
 template<class T>
-void BDSBunchUserFile<T>::skip(std::stringstream& ss, G4int nValues)
+void BDSBunchUserFile<T>::WriteIndexFile() const
 {
-  G4double dummyValue;
-  for (G4int i = 0; i < nValues; i++)
-    {ReadValue(ss, dummyValue);}
+  std::ofstream indexFile(IndexFileName());
+  if (!indexFile.good())
+    {
+      BDS::Warning("BDSBunchUserFile::WriteIndexFile>", "unable to write index file \"" + IndexFileName() + "\"");
+      return;
+    }
+  indexFile << FileSignature() << "\n";
+  indexFile << nlinesIgnore << " " << indexStride << " " << nLinesValidData << " " << lineIndex.size() << "\n";
+  for (const auto& entry : lineIndex)
+    {indexFile << entry.offset << " " << entry.lineNumber << "\n";}
+  G4cout << "BDSBunchUserFile> wrote index file \"" << IndexFileName() << "\"" << G4endl;
 }
 
 template<class T>
@@ -262,10 +278,9 @@ void BDSBunchUserFile<T>::SkipNLinesIgnoreIntoFile(G4bool usualPrintOut)
       if (usualPrintOut)
         {G4cout << "BDSBunchUserFile> ignoring " << nlinesIgnore << " lines" << G4endl;}
       std::string line;
-      for (G4int i = 0; i < (G4int)nlinesIgnore; i++)
+      for (G4long i = 0; i < nlinesIgnore; i++)
         {
-          std::getline(InputBunchFile, line);
-          lineCounter++;
+          ReadLine(line);
           // we must check explicitly if we've gone past the end of the file
           if (InputBunchFile.eof())
             {
@@ -285,18 +300,9 @@ void BDSBunchUserFile<T>::SkipNLinesSkip(G4bool usualPrintOut)
       if (usualPrintOut)
         {G4cout << "BDSBunchUserFile> skipping " << nlinesSkip << " valid lines" << G4endl;}
       
-      // We can read into the file safely without checking eof() because we know from earlier
-      // counting of the number of valid lines in the file that nlinesSkip is not beyond the
-      // end of the file (including nlinesIgnore).
-      std::string line;
-      G4int nLinesValidRead = 0;
-      while (nLinesValidRead < nlinesSkip)
-        {
-          std::getline(InputBunchFile, line);
-          if (SkippableLine(line))
-            {continue;}
-          nLinesValidRead++;
-        }
+      // We know from earlier counting of the number of valid lines in the file that nlinesSkip
+      // is not beyond the end of the file (including nlinesIgnore).
+      SeekToValidLine(nlinesSkip);
       IncrementNEventsInFileSkipped((unsigned long long int)nlinesSkip);
     }
 }
@@ -316,30 +322,42 @@ void BDSBunchUserFile<T>::SetOptions(const BDSParticleDefinition* beamParticle,
   nlinesIgnore  = (G4long)beam.nlinesIgnore;
   nlinesSkip    = (G4long)beam.nlinesSkip;
   matchDistrFileLength = beam.distrFileMatchLength;
+  useIndexFile  = beam.distrFileIndexFile;
   ParseFileFormat();
 }
 
-template<class T>
-G4bool BDSBunchUserFile<T>::SkippableLine(const std::string& line) const
-{
-  return std::all_of(line.begin(), line.end(), isspace) || std::regex_search(line, comment);
-}
-
 template<class T>
 G4long BDSBunchUserFile<T>::CountNLinesValidDataInFile()
 {
+  if (useIndexFile && LoadIndexFile())
+    {return nLinesValidData;}
+  
   OpenBunchFile();
   SkipNLinesIgnoreIntoFile(false);
 
+  lineIndex.clear();
   std::string line;
   G4long nLinesValid = 0;
-  while ( std::getline(InputBunchFile, line) )
+  std::streamoff lineStart = currentOffset;
+  G4long lineStartNumber = lineCounter;
+  while (ReadLine(line))
     {
-      if (SkippableLine(line))
-        {continue;} // don't count it
-      nLinesValid++;
+      if (!BDS::SkippableUserFileLine(line))
+        {
+          if (nLinesValid % indexStride == 0)
+            {lineIndex.push_back({lineStart, lineStartNumber});}
+          nLinesValid++;
+        }
+      lineStart = currentOffset;
+      lineStartNumber = lineCounter;
     }
   CloseBunchFile();
+
+  if (useIndexFile)
+    {
+      nLinesValidData = nLinesValid;
+      WriteIndexFile();
+    }
   return nLinesValid;
 }
 
@@ -414,16 +432,16 @@ void BDSBunchUserFile<T>::EndOfFileAction()
   // If the end of the file is reached go back to the beginning of the file.
   // this re-reads the same file again - must always print warning
   G4cout << "BDSBunchUserFile> End of file reached." << G4endl;
-  CloseBunchFile();
   if (distrFileLoop)
     {
       G4cout << "BDSBunchUserFile> Returning to beginning of file (including nlinesIgnore & nlinesSkip) for next event." << G4endl;
-      OpenBunchFile();
-      SkipNLinesIgnoreIntoFile(false);
-      SkipNLinesSkip(false);
+      SeekToValidLine(nlinesSkip); // uses the index so no need to read through nlinesIgnore again
     }
   else
-    {throw BDSException(__METHOD_NAME__, "distrFileLoop off but requesting another set of coordinates.");}
+    {
+      CloseBunchFile();
+      throw BDSException(__METHOD_NAME__, "distrFileLoop off but requesting another set of coordinates.");
+    }
 }
 
 template<class T>
@@ -462,16 +480,7 @@ void BDSBunchUserFile<T>::RecreateAdvanceToEvent(G4int eventOffset)
   // generator action in the start of the event after BeamOn(nEvents) has been called
   // therefore this adjustment for recreation + match is done earlier in this class
 
-  // we should now be completely safe to read into the file ignoring comment lines and
-  // without checking eof()
-  std::string line;
-  for (G4int i = 0; i < eventOffset; i++)
-    {
-      std::getline(InputBunchFile, line);
-      if (SkippableLine(line))
-        {continue;}
-      lineCounter++;
-    }
+  SeekToValidLine(nlinesSkip + (G4long)eventOffset);
 }
 
 template<class T>
@@ -484,7 +493,7 @@ BDSParticleCoordsFullGlobal BDSBunchUserFile<T>::GetNextParticleValid(G4int /*ma
 template<class T>
 BDSParticleCoordsFull BDSBunchUserFile<T>::GetNextParticleLocal()
 {
-  if (InputBunchFile.eof() || InputBunchFile.fail())
+  if (NoMoreLines())
     {EndOfFileAction();}
 
   G4double E = 0, Ek = 0, P = 0, x = 0, y = 0, z = 0, xp = 0, yp = 0, zp = 0, t = 0;
@@ -499,85 +508,67 @@ BDSParticleCoordsFull BDSBunchUserFile<T>::GetNextParticleLocal()
 
   // read a whole line at a time for safety - no partially read lines
   std::string line;
-  std::getline(InputBunchFile, line);
-  lineCounter++;
+  ReadLine(line);
   
   // skip empty lines and comment lines (starting with # or !)
-  G4bool lineIsBad = true;
-  while (lineIsBad)
+  while (BDS::SkippableUserFileLine(line))
     {
-      if (SkippableLine(line))
-        {
-          if (InputBunchFile.eof() || InputBunchFile.fail())
-            {EndOfFileAction();}
-          else
-            {
-              std::getline(InputBunchFile, line);
-              lineCounter++;
-              continue;
-            }
-        }
-      else
-        {lineIsBad = false;}
+      if (NoMoreLines())
+        {EndOfFileAction();}
+      ReadLine(line);
     }
+  validLineCounter++;
   
-  // no check the line has the right number of 'words' in it ->
-  // split line on white space - doesn't inspect words themselves
-  // checks number of words, ie number of columns is correct
-  std::vector<std::string> results;
-  std::regex wspace("\\s+"); // any whitepsace
-  // -1 here makes it point to the suffix, ie the word rather than the wspace
-  std::sregex_token_iterator iter(line.begin(), line.end(), wspace, -1);
-  std::sregex_token_iterator end;
-  for (; iter != end; ++iter)
-    {
-      std::string res = (*iter).str();
-      results.push_back(res);
-    }
-  
-  if (results.size() < fields.size())
-    {// ensure enough columns
-      std::string message = "Invalid line at line " + std::to_string(lineCounter) +
-        ".  Expected " + std::to_string(fields.size()) +
-        " columns , but got " + std::to_string(results.size()) +
-        ".";
-      throw BDSException(__METHOD_NAME__, message);
-    }
-  
-  std::stringstream ss(line);
-  for (auto it=fields.begin();it!=fields.end();it++)
+  // read each column in turn directly from the line - if we run out of
+  // numbers before the end of the fields, there aren't enough columns
+  const char* p   = line.data();
+  const char* end = line.data() + line.size();
+  G4int nColumnsRead = 0;
+  G4bool ok = true;
+  for (auto it = fields.begin(); it != fields.end() && ok; it++)
     {
       if(it->name=="skip")
-        {double dummy; ReadValue(ss, dummy);}
+        {double dummy; ok = ReadValue(p, end, dummy);}
       else if(it->name=="Ek")
-        {ReadValue(ss, Ek); Ek *= (CLHEP::GeV * it->unit);}
+        {ok = ReadValue(p, end, Ek); Ek *= (CLHEP::GeV * it->unit);}
       else if(it->name=="E")
-        {ReadValue(ss, E); E *= (CLHEP::GeV * it->unit);}
+        {ok = ReadValue(p, end, E); E *= (CLHEP::GeV * it->unit);}
       else if(it->name=="P")
-        {ReadValue(ss, P); P *= (CLHEP::GeV * it->unit);}
+        {ok = ReadValue(p, end, P); P *= (CLHEP::GeV * it->unit);}
       else if(it->name=="t")
-        {ReadValue(ss, t); t *= (CLHEP::s * it->unit); tdef = true;}
+        {ok = ReadValue(p, end, t); t *= (CLHEP::s * it->unit); tdef = true;}
       else if(it->name=="x")
-        {ReadValue(ss, x); x *= (CLHEP::m * it->unit);}
+        {ok = ReadValue(p, end, x); x *= (CLHEP::m * it->unit);}
       else if(it->name=="y")
-        {ReadValue(ss, y); y *= (CLHEP::m * it->unit);}
+        {ok = ReadValue(p, end, y); y *= (CLHEP::m * it->unit);}
       else if(it->name=="z")
-        {ReadValue(ss, z); z *= (CLHEP::m * it->unit);}
-      else if(it->name=="xp") {ReadValue(ss, xp); xp *= ( CLHEP::radian * it->unit );}
-      else if(it->name=="yp") {ReadValue(ss, yp); yp *= ( CLHEP::radian * it->unit );}
-      else if(it->name=="zp") {ReadValue(ss, zp); zp *= ( CLHEP::radian * it->unit ); zpdef = true;}
+        {ok = ReadValue(p, end, z); z *= (CLHEP::m * it->unit);}
+      else if(it->name=="xp") {ok = ReadValue(p, end, xp); xp *= ( CLHEP::radian * it->unit );}
+      else if(it->name=="yp") {ok = ReadValue(p, end, yp); yp *= ( CLHEP::radian * it->unit );}
+      else if(it->name=="zp") {ok = ReadValue(p, end, zp); zp *= ( CLHEP::radian * it->unit ); zpdef = true;}
       else if(it->name=="pdgid")
         {// particle type
-          ReadValue(ss, type);
+          ok = ReadValue(p, end, type);
           updateParticleDefinition = true; // update particle definition after finished reading line
         }
       else if (it->name == "S")
         {
-          ReadValue(ss, z);
+          ok = ReadValue(p, end, z);
           z *= CLHEP::m * it->unit;
         }
       else if(it->name=="weight")
-        {ReadValue(ss, weight);}
+        {ok = ReadValue(p, end, weight);}
+      if (ok)
+        {nColumnsRead++;}
+    }
+  
+  if (!ok)
+    {// ensure enough columns
+      std::string message = "Invalid line at line " + std::to_string(lineCounter) +
+        ".  Expected " + std::to_string(fields.size()) +
+        " columns , but could only read " + std::to_string(nColumnsRead) +
+        ".";
+      throw BDSException(__METHOD_NAME__, message);
     }
 
   // coordinate checks
@@ -643,10 +634,18 @@ BDSParticleCoordsFull BDSBunchUserFile<T>::GetNextParticleLocal()
 }
 
 template <class T>
-template <typename Type>
-void BDSBunchUserFile<T>::ReadValue(std::stringstream& stream, Type& value)
+G4bool BDSBunchUserFile<T>::ReadValue(const char*& p, const char* end, G4double& value) const
 {
-  stream >> value;
+  return BDS::ParseDouble(p, end, value);
+}
+
+template <class T>
+G4bool BDSBunchUserFile<T>::ReadValue(const char*& p, const char* end, G4int& value) const
+{
+  long long v = 0;
+  G4bool ok = BDS::ParseLong(p, end, v);
+  value = (G4int)v;
+  return ok;
 }
 
 template class BDSBunchUserFile<std::ifstream>;
@@ -657,6 +656,89 @@ template class BDSBunchUserFile<igzstream>;
 
 namespace BDS
 {
+std::vector<UserFileColumn> ParseUserFileFormat(const G4String& format)
+{
+  std::vector<std::string> tokens;
+  std::string token;
+  for (char c : format)
+    {
+      if (c == ':')
+        {
+          tokens.push_back(token);
+          token.clear();
+        }
+      else
+        {token += c;}
+    }
+  tokens.push_back(token);
+
+  std::vector<UserFileColumn> result;
+  for (const auto& tok : tokens)
+    {
+      G4String name;
+      G4double (*unitParser)(const G4String&) = nullptr;
+      if (tok.substr(0,2) == "Ek")
+        {name = "Ek"; unitParser = BDS::ParseEnergyUnit;}
+      else if (tok.substr(0,1) == "E" || tok.substr(0,1) == "P")
+        {name = tok.substr(0,1); unitParser = BDS::ParseEnergyUnit;}
+      else if (tok.substr(0,1) == "t")
+        {name = "t"; unitParser = BDS::ParseTimeUnit;}
+      else if (tok.substr(0,2) == "xp" || tok.substr(0,2) == "yp" || tok.substr(0,2) == "zp")
+        {name = tok.substr(0,2); unitParser = BDS::ParseAngleUnit;}
+      else if (tok.substr(0,1) == "x" || tok.substr(0,1) == "y" || tok.substr(0,1) == "z" || tok.substr(0,1) == "S")
+        {name = tok.substr(0,1); unitParser = BDS::ParseLengthUnit;}
+      else if (tok.substr(0,5) == "pdgid")
+        {name = "pdgid";}
+      else if (tok.substr(0,1) == "w")
+        {name = "weight";}
+      else if (tok.substr(0,1) == "-")
+        {name = "skip";}
+      else
+        {throw BDSException(__METHOD_NAME__, "Cannot determine bunch data format. Failed at token: " + tok);}
+
+      G4double unit = 1.0;
+      std::string rest = unitParser ? tok.substr(name.size()) : "";
+      if (!rest.empty())
+        {
+          std::size_t pos1 = rest.find('[');
+          std::size_t pos2 = rest.find(']');
+          if (pos1 == std::string::npos || pos2 == std::string::npos)
+            {
+              G4String message = "Missing bracket [] in units of \"distrFileFormat\"\n";
+              message += "variable : \"" + name + "\" and unit \"" + rest + "\"";
+              throw BDSException(__METHOD_NAME__, message);
+            }
+          unit = unitParser(rest.substr(pos1 + 1, pos2 - pos1 - 1));
+        }
+      result.push_back({name, unit});
+    }
+
+  // check for conflicting columns after all are known so the order doesn't matter
+  for (const std::set<G4String>& keys : {std::set<G4String>{"E", "Ek", "P"}, std::set<G4String>{"z", "S"}})
+    {
+      auto count = std::count_if(result.begin(), result.end(),
+                                 [&keys](const UserFileColumn& c){return keys.count(c.name) > 0;});
+      if (count > 1)
+        {
+          G4String message = "More than one of the following set in user file columns (\"distrFileFormat\") ";
+          for (const auto& key : keys)
+            {message += key + ", ";}
+          message += "\nPossibly conflicting information. Ensure only one by skipping others with \"-\" symbol";
+          throw BDSException(__METHOD_NAME__, message);
+        }
+    }
+  return result;
+}
+
+G4bool SkippableUserFileLine(const std::string& line)
+{
+  // all white space or a comment starting with '#' or containing '!'
+  auto firstChar = std::find_if(line.begin(), line.end(), [](char c){return !std::isspace((unsigned char)c);});
+  if (firstChar == line.end() || *firstChar == '#')
+    {return true;}
+  return line.find('!') != std::string::npos;
+}
+
 G4double ParseEnergyUnit(const G4String& fmt)
 {
   G4double unit= 1.0;
@@ -728,5 +810,108 @@ G4double ParseTimeUnit(const G4String& fmt)
     {throw BDSException(__METHOD_NAME__, "Unrecognised time unit! " + fmt);}
   return unit;
 }
+G4bool ParseDouble(const char*& p, const char* end, G4double& value)
+{
+  while (p < end && std::isspace((unsigned char)*p))
+    {p++;}
+  if (p == end)
+    {return false;}
+
+  // exact powers of 10 representable in a double
+  static const G4double powersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                        1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                        1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  const char* start = p;
+  const char* c = p;
+  G4bool negative = false;
+  if (*c == '-' || *c == '+')
+    {negative = *c == '-'; c++;}
+
+  unsigned long long mantissa = 0;
+  G4int nDigits = 0;
+  G4int exponent = 0;
+  G4bool anyDigits = false;
+  while (c < end && std::isdigit((unsigned char)*c))
+    {
+      if (nDigits > 0 || *c != '0')
+        {mantissa = mantissa * 10 + (unsigned long long)(*c - '0'); nDigits++;}
+      anyDigits = true;
+      c++;
+    }
+  if (c < end && *c == '.')
+    {
+      c++;
+      while (c < end && std::isdigit((unsigned char)*c))
+        {
+          if (nDigits > 0 || *c != '0')
+            {mantissa = mantissa * 10 + (unsigned long long)(*c - '0'); nDigits++;}
+          exponent--;
+          anyDigits = true;
+          c++;
+        }
+    }
+  G4bool fastPath = anyDigits && nDigits <= 15;
+  if (anyDigits && c < end && (*c == 'e' || *c == 'E'))
+    {
+      const char* e = c + 1;
+      G4bool negativeExponent = false;
+      if (e < end && (*e == '-' || *e == '+'))
+        {negativeExponent = *e == '-'; e++;}
+      if (e < end && std::isdigit((unsigned char)*e))
+        {
+          G4int exp10 = 0;
+          while (e < end && std::isdigit((unsigned char)*e))
+            {
+              if (exp10 < 10000)
+                {exp10 = exp10 * 10 + (*e - '0');}
+              e++;
+            }
+          exponent += negativeExponent ? -exp10 : exp10;
+          c = e;
+        }
+    }
+  // the number must be followed by white space or the end of the line
+  fastPath = fastPath && (c == end || std::isspace((unsigned char)*c)) && std::abs(exponent) <= 22;
+
+  if (fastPath)
+    {// both the mantissa and the power of 10 are exact so the single operation is correctly rounded
+      G4double result = (G4double)mantissa;
+      result = exponent < 0 ? result / powersOf10[-exponent] : result * powersOf10[exponent];
+      value = negative ? -result : result;
+      p = c;
+      return true;
+    }
+
+  // general case (many digits, large exponents, nan, inf...) - copy the word for strtod
+  // as the line isn't necessarily null terminated at the end of the word
+  const char* wordEnd = start;
+  while (wordEnd < end && !std::isspace((unsigned char)*wordEnd))
+    {wordEnd++;}
+  std::string word(start, wordEnd);
+  char* parseEnd = nullptr;
+  value = std::strtod(word.c_str(), &parseEnd);
+  if (parseEnd == word.c_str())
+    {return false;}
+  p = start + (parseEnd - word.c_str());
+  return true;
+}
+
+G4bool ParseLong(const char*& p, const char* end, long long& value)
+{
+  while (p < end && std::isspace((unsigned char)*p))
+    {p++;}
+  const char* c = p;
+  G4bool negative = false;
+  if (c < end && (*c == '-' || *c == '+'))
+    {negative = *c == '-'; c++;}
+  if (c == end || !std::isdigit((unsigned char)*c))
+    {return false;}
+  long long result = 0;
+  while (c < end && std::isdigit((unsigned char)*c))
+    {result = result * 10 + (*c - '0'); c++;}
+  value = negative ? -result : result;
+  p = c;
+  return true;
+}
 
 }
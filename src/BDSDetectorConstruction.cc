@@ -828,6 +828,8 @@ void BDSDetectorConstruction::PlaceBeamlineInWorld(BDSBeamline*          beamlin
       G4String placementName = element->GetPlacementName() + "_pv";
       std::set<G4VPhysicalVolume*> pvs = element->PlaceElement(placementName, containerPV, useCLPlacementTransform,
                                                                copyNumber, checkOverlaps);
+      if (pvs.size() == 1)
+        {element->SetPlacedVolume(*pvs.begin());}
       
       if (registerInfo)
         {
@@ -1350,8 +1352,13 @@ void BDSDetectorConstruction::ConstructScoringMeshes()
 
   // construct meshes
   BDSScorerFactory scorerFactory;
+  G4String weightWindowMeshName = BDSGlobalConstants::Instance()->WeightWindowMesh();
   for (const auto& mesh : scoringMeshes)
     {
+      // a mesh only used to define weight windows doesn't need any scoring geometry
+      if (mesh.scoreQuantity.empty() && mesh.name == weightWindowMeshName)
+        {continue;}
+      
       // convert to recipe class as this checks parameters
       BDSScorerMeshInfo meshRecipe = BDSScorerMeshInfo(mesh);
       
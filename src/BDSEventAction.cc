@@ -19,6 +19,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSAuxiliaryNavigator.hh"
 #include "BDSDebug.hh"
 #include "BDSEventAction.hh"
+#include "BDSEventBudget.hh"
+#include "BDSEventProfiler.hh"
 #include "BDSEventInfo.hh"
 #include "BDSGlobalConstants.hh"
 #include "BDSHitEnergyDeposition.hh"
@@ -27,6 +29,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSHitSampler.hh"
 #include "BDSHitThinThing.hh"
 #include "BDSOutput.hh"
+#include "BDSOutputROOTEventInfo.hh"
 #include "BDSModulator.hh"
 #include "BDSNavigatorPlacements.hh"
 #include "BDSSamplerRegistry.hh"
@@ -70,6 +73,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <bitset>
 #include <chrono>
 #include <ctime>
+#include <fstream>
 #include <map>
 #include <string>
 #include <vector>
@@ -101,7 +105,9 @@ BDSEventAction::BDSEventAction(BDSOutput* outputIn):
   primaryAbsorbedInCollimator(false),
   currentEventIndex(0),
   eventInfo(nullptr),
-  nTracks(0)
+  nTracks(0),
+  eventBudget(nullptr),
+  eventProfiler(nullptr)
 {
   BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
   verboseEventBDSIM         = globals->VerboseEventBDSIM();
@@ -223,6 +229,10 @@ void BDSEventAction::BeginOfEventAction(const G4Event* evt)
   FireLaserCompton=true;
 
   cpuStartTime = std::clock();
+  if (eventBudget)
+    {eventBudget->BeginEvent();}
+  if (eventProfiler)
+    {eventProfiler->BeginEvent();}
   // get the current time - last thing before we hand off to geant4
   startTime = time(nullptr);
   eventInfo->SetStartTime(startTime);
@@ -249,6 +259,12 @@ void BDSEventAction::EndOfEventAction(const G4Event* evt)
 
   // Record if event was aborted - ie whether it's usable for analyses.
   eventInfo->SetAborted(evt->IsAborted());
+  if (eventBudget && eventBudget->Truncated())
+    {
+      eventInfo->SetTruncated(true);
+      G4cout << __METHOD_NAME__ << "event #" << event_number << " truncated: " << eventBudget->Reason() << G4endl;
+      WriteTruncatedEventSeedState(event_number);
+    }
   eventInfo->SetNTracks(nTracks);
 
   // Calculate the elapsed CPU time for the event.
@@ -699,6 +715,21 @@ void BDSEventAction::ConnectTrajectory(std::map<BDSTrajectory*, bool>& interesti
     {return;}
 }
 
+void BDSEventAction::WriteTruncatedEventSeedState(G4int eventIndex) const
+{
+  G4String seedStateFileName = BDSGlobalConstants::Instance()->OutputFileName();
+  seedStateFileName += "_event" + std::to_string(eventIndex) + ".seedstate.txt";
+  std::ofstream ofseedstate(seedStateFileName);
+  if (!ofseedstate.is_open())
+    {
+      G4cout << __METHOD_NAME__ << "unable to write seed state to \"" << seedStateFileName << "\"" << G4endl;
+      return;
+    }
+  ofseedstate << eventInfo->GetInfo()->seedStateAtStart;
+  ofseedstate.close();
+  G4cout << __METHOD_NAME__ << "seed state at the start of the event written to \"" << seedStateFileName << "\"" << G4endl;
+}
+
 void BDSEventAction::RegisterPrimaryTrajectory(const BDSTrajectoryPrimary* trajectoryIn)
 {
   G4int trackID = trajectoryIn->GetTrackID();
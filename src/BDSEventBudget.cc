@@ -0,0 +1,73 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSEventBudget.hh"
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <ctime>
+#include <sstream>
+
+BDSEventBudget::BDSEventBudget(G4long   maximumStepsIn,
+                               G4double maximumCPUTimeIn):
+  maximumSteps(maximumStepsIn),
+  maximumCPUTime(maximumCPUTimeIn),
+  nSteps(0),
+  truncated(false),
+  exceededCPUTime(false),
+  cpuStartTime(std::clock())
+{;}
+
+void BDSEventBudget::BeginEvent()
+{
+  nSteps          = 0;
+  truncated       = false;
+  exceededCPUTime = false;
+  cpuStartTime    = std::clock();
+}
+
+G4bool BDSEventBudget::Step()
+{
+  if (truncated)
+    {return false;}
+  nSteps++;
+  if (maximumSteps > 0 && nSteps > maximumSteps)
+    {truncated = true;}
+  else if (maximumCPUTime > 0 && nSteps % cpuTimeCheckInterval == 0 && CPUTimeThisEvent() > maximumCPUTime)
+    {
+      truncated       = true;
+      exceededCPUTime = true;
+    }
+  return truncated;
+}
+
+G4double BDSEventBudget::CPUTimeThisEvent() const
+{
+  return static_cast<G4double>(std::clock() - cpuStartTime) / CLOCKS_PER_SEC;
+}
+
+G4String BDSEventBudget::Reason() const
+{
+  std::ostringstream reason;
+  if (exceededCPUTime)
+    {reason << "CPU time exceeded " << maximumCPUTime << " s after " << nSteps << " steps";}
+  else if (truncated)
+    {reason << "number of steps exceeded " << maximumSteps;}
+  return G4String(reason.str());
+}
@@ -0,0 +1,174 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSAcceleratorModel.hh"
+#include "BDSBeamline.hh"
+#include "BDSBeamlineElement.hh"
+#include "BDSEventProfiler.hh"
+#include "BDSPhysicalVolumeInfo.hh"
+#include "BDSPhysicalVolumeInfoRegistry.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4String.hh"
+#include "G4Track.hh"
+#include "G4Types.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+BDSEventProfiler::BDSEventProfiler():
+  ionsBin(0),
+  otherParticlesBin(0),
+  pvInfoRegistry(BDSPhysicalVolumeInfoRegistry::Instance()),
+  lastVolume(nullptr),
+  lastElementBin(-1),
+  lastVolumeBin(-1),
+  lastParticle(nullptr),
+  lastParticleBin(-1),
+  stepsSinceSample(0),
+  sampling(false)
+{
+  if (const BDSBeamline* beamline = BDSAcceleratorModel::Instance()->BeamlineMain())
+    {
+      for (const auto element : *beamline)
+        {elementNames.push_back(element->GetName());}
+    }
+
+  for (const auto lv : *G4LogicalVolumeStore::GetInstance())
+    {
+      volumeBins[lv] = (G4int)volumeNames.size();
+      volumeNames.push_back(lv->GetName());
+    }
+
+  auto particleIterator = G4ParticleTable::GetParticleTable()->GetIterator();
+  particleIterator->reset();
+  while ((*particleIterator)())
+    {
+      const G4ParticleDefinition* particle = particleIterator->value();
+      particleBins[particle] = (G4int)particleNames.size();
+      particleNames.push_back(particle->GetParticleName());
+    }
+  ionsBin = (G4int)particleNames.size();
+  particleNames.emplace_back("ions");
+  otherParticlesBin = (G4int)particleNames.size();
+  particleNames.emplace_back("other");
+
+  perElement  = MakeTally(elementNames.size());
+  perVolume   = MakeTally(volumeNames.size());
+  perParticle = MakeTally(particleNames.size());
+}
+
+void BDSEventProfiler::BeginEvent()
+{
+  Reset(perElement);
+  Reset(perVolume);
+  Reset(perParticle);
+  stepsSinceSample = 0;
+  sampling = false;
+}
+
+void BDSEventProfiler::Step(const G4Step* step)
+{
+  // measure first so the time of the profiler itself is mostly excluded
+  G4double time = 0;
+  if (sampling)
+    {
+      std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - sampleStartTime;
+      time = elapsed.count() * timingSampleInterval;
+      sampling = false;
+    }
+
+  G4VPhysicalVolume* pv = step->GetPreStepPoint()->GetPhysicalVolume();
+  if (pv != lastVolume)
+    {UpdateVolume(pv);}
+  const G4ParticleDefinition* particle = step->GetTrack()->GetDefinition();
+  if (particle != lastParticle)
+    {UpdateParticle(particle);}
+
+  Add(perElement,  lastElementBin,  time);
+  Add(perVolume,   lastVolumeBin,   time);
+  Add(perParticle, lastParticleBin, time);
+
+  stepsSinceSample++;
+  if (stepsSinceSample >= timingSampleInterval)
+    {
+      stepsSinceSample = 0;
+      sampling = true;
+      sampleStartTime = std::chrono::steady_clock::now();
+    }
+}
+
+void BDSEventProfiler::UpdateVolume(G4VPhysicalVolume* pv)
+{
+  lastVolume     = pv;
+  lastElementBin = -1;
+  lastVolumeBin  = -1;
+  if (!pv)
+    {return;}
+
+  auto search = volumeBins.find(pv->GetLogicalVolume());
+  if (search != volumeBins.end())
+    {lastVolumeBin = search->second;}
+
+  if (const BDSPhysicalVolumeInfo* info = pvInfoRegistry->GetInfo(pv))
+    {
+      G4int index = info->GetBeamlineIndex();
+      if (index >= 0 && index < (G4int)elementNames.size())
+        {lastElementBin = index;}
+    }
+}
+
+void BDSEventProfiler::UpdateParticle(const G4ParticleDefinition* particle)
+{
+  lastParticle = particle;
+  auto search = particleBins.find(particle);
+  if (search != particleBins.end())
+    {lastParticleBin = search->second;}
+  else
+    {lastParticleBin = particle->IsGeneralIon() ? ionsBin : otherParticlesBin;}
+}
+
+void BDSEventProfiler::Add(Tally& tally, G4int bin, G4double time)
+{
+  if (bin < 0)
+    {return;}
+  tally.steps[bin] += 1;
+  tally.time[bin]  += time;
+}
+
+BDSEventProfiler::Tally BDSEventProfiler::MakeTally(std::size_t nBins)
+{
+  Tally tally;
+  tally.steps.resize(nBins, 0);
+  tally.time.resize(nBins, 0);
+  return tally;
+}
+
+void BDSEventProfiler::Reset(Tally& tally)
+{
+  std::fill(tally.steps.begin(), tally.steps.end(), 0);
+  std::fill(tally.time.begin(),  tally.time.end(),  0);
+}
@@ -0,0 +1,471 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSAcceleratorComponent.hh"
+#include "BDSBeamline.hh"
+#include "BDSBeamlineElement.hh"
+#include "BDSBeamPipeInfo.hh"
+#include "BDSFastTransport.hh"
+#include "BDSFieldInfo.hh"
+#include "BDSFieldType.hh"
+#include "BDSGlobalConstants.hh"
+#include "BDSIntegratorType.hh"
+#include "BDSMagnet.hh"
+#include "BDSMagnetStrength.hh"
+#include "BDSMaterials.hh"
+#include "BDSParticleCoords.hh"
+#include "BDSParticleCoordsFullGlobal.hh"
+#include "BDSParticleDefinition.hh"
+#include "BDSSamplerType.hh"
+#include "BDSTiltOffset.hh"
+#include "BDSUtilities.hh"
+
+#include "G4Material.hh"
+
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cmath>
+
+const G4double BDSFastTransport::maximumStepLength = 1*CLHEP::cm;
+const G4double BDSFastTransport::apertureMargin    = 1*CLHEP::um;
+
+BDSFastTransport::BDSFastTransport(const BDSBeamline* beamline):
+  length(0),
+  beamlineIndexEnd(0),
+  backupStepperMomLimit(BDSGlobalConstants::Instance()->BackupStepperMomLimit()),
+  minimumRadiusOfCurvature(10*CLHEP::cm) // as in BDSFieldFactory::CreateIntegratorMag
+{
+  if (!beamline || beamline->empty())
+    {return;}
+
+  for (const auto beamlineElement : *beamline)
+    {
+      Element element;
+      if (!Analytic(beamlineElement, element))
+        {break;}
+      elements.push_back(element);
+      length += element.chordLength;
+    }
+
+  std::size_t nElements = elements.size();
+  if (nElements < beamline->size())
+    {// hand back at the start of the first element that isn't analytic
+      const BDSBeamlineElement* next = beamline->at((G4int)nElements);
+      positionEnd      = next->GetReferencePositionStart();
+      rotationEnd      = *(next->GetReferenceRotationStart());
+      beamlineIndexEnd = next->GetIndex();
+    }
+  else
+    {// the whole beam line is analytic
+      const BDSBeamlineElement* last = beamline->GetLastItem();
+      positionEnd      = last->GetReferencePositionEnd();
+      rotationEnd      = *(last->GetReferenceRotationEnd());
+      beamlineIndexEnd = last->GetIndex();
+    }
+}
+
+G4bool BDSFastTransport::Analytic(const BDSBeamlineElement* beamlineElement,
+                                  Element&                  element) const
+{
+  if (beamlineElement->GetSamplerType() != BDSSamplerType::none)
+    {return false;} // the sampler would be skipped
+  if (BDS::IsFinite(beamlineElement->GetAngle()))
+    {return false;}
+  const BDSTiltOffset* tiltOffset = beamlineElement->GetTiltOffset();
+  if (tiltOffset && (tiltOffset->HasFiniteTilt() || tiltOffset->HasFiniteOffset()))
+    {return false;}
+
+  const BDSAcceleratorComponent* component = beamlineElement->GetAcceleratorComponent();
+  if (!component || !component->GetBiasVacuumList().empty())
+    {return false;}
+  G4double chordLength = component->GetChordLength();
+  if (!BDS::IsFinite(chordLength))
+    {return false;}
+
+  const BDSBeamPipeInfo* bpInfo = component->GetBeamPipeInfo();
+  if (!bpInfo)
+    {return false;}
+  const BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
+  G4Material* vacuum = BDSMaterials::Instance()->GetMaterial(globals->VacuumMaterial());
+  if (bpInfo->vacuumMaterial != vacuum)
+    {return false;}
+  switch (bpInfo->beamPipeType.underlying())
+    {
+    case BDSBeamPipeType::circular:
+    case BDSBeamPipeType::circularvacuum:
+    case BDSBeamPipeType::elliptical:
+    case BDSBeamPipeType::rectangular:
+    case BDSBeamPipeType::lhc:
+    case BDSBeamPipeType::rectellipse:
+      {break;}
+    default:
+      {return false;}
+    }
+
+  element.kind     = Kind::drift;
+  element.strength = 0;
+  if (component->GetType() == "drift")
+    {
+      if (component->HasAField())
+        {return false;}
+    }
+  else
+    {
+      const BDSMagnet* magnet = dynamic_cast<const BDSMagnet*>(component);
+      if (!magnet)
+        {return false;}
+      const BDSFieldInfo* info = magnet->VacuumFieldInfo();
+      if (!info || info->ModulatorInfo() || BDS::IsFinite(info->Tilt()) || !info->MagnetStrength())
+        {return false;}
+      const BDSMagnetStrength* st = info->MagnetStrength();
+      if (info->FieldType() == BDSFieldType::quadrupole && info->IntegratorType() == BDSIntegratorType::quadrupole)
+        {// as BDSIntegratorQuadrupole
+          element.kind     = Kind::quadrupole;
+          element.strength = std::abs(info->BRho()) * (*st)["k1"] / CLHEP::m2;
+        }
+      else if (info->FieldType() == BDSFieldType::solenoid && info->IntegratorType() == BDSIntegratorType::solenoid)
+        {// as BDSIntegratorSolenoid
+          element.kind     = Kind::solenoid;
+          element.strength = info->BRho() * (*st)["ks"];
+        }
+      else
+        {return false;}
+    }
+
+  element.beamlineIndex = beamlineElement->GetIndex();
+  element.chordLength   = chordLength;
+  // a drift is a straight line and all the apertures are convex so checking
+  // at the entrance and exit is enough
+  element.nSteps = element.kind == Kind::drift ? 1 : std::max(1, (G4int)std::ceil(chordLength / maximumStepLength));
+  element.apertureType  = bpInfo->beamPipeType;
+  element.aper1         = bpInfo->aper1 - apertureMargin;
+  element.aper2         = bpInfo->aper2 - apertureMargin;
+  element.aper3         = bpInfo->aper3 - apertureMargin;
+  element.aper4         = bpInfo->aper4 - apertureMargin;
+  element.aperOffsetX   = bpInfo->aperOffsetX;
+  element.aperOffsetY   = bpInfo->aperOffsetY;
+  element.positionStart = beamlineElement->GetReferencePositionStart();
+  element.rotationStart = *(beamlineElement->GetReferenceRotationStart());
+  return true;
+}
+
+void BDSFastTransport::State::Resize(std::size_t n)
+{
+  index.resize(n);
+  for (auto v : {&x, &y, &xp, &yp, &zp, &T, &fcofOverP, &inverseVelocity})
+    {v->resize(n);}
+  ok.resize(n);
+}
+
+void BDSFastTransport::State::Move(std::size_t i, std::size_t j)
+{
+  index[j] = index[i];
+  x[j]  = x[i];
+  y[j]  = y[i];
+  xp[j] = xp[i];
+  yp[j] = yp[i];
+  zp[j] = zp[i];
+  T[j]  = T[i];
+  fcofOverP[j]       = fcofOverP[i];
+  inverseVelocity[j] = inverseVelocity[i];
+}
+
+void BDSFastTransport::State::CopyCoordinates(const State& other)
+{
+  std::size_t n = other.x.size();
+  std::copy(other.index.begin(), other.index.begin() + n, index.begin());
+  std::copy(other.x.begin(),  other.x.begin()  + n, x.begin());
+  std::copy(other.y.begin(),  other.y.begin()  + n, y.begin());
+  std::copy(other.xp.begin(), other.xp.begin() + n, xp.begin());
+  std::copy(other.yp.begin(), other.yp.begin() + n, yp.begin());
+  std::copy(other.zp.begin(), other.zp.begin() + n, zp.begin());
+  std::copy(other.T.begin(),  other.T.begin()  + n, T.begin());
+}
+
+void BDSFastTransport::Transport(std::vector<BDSParticleCoordsFullGlobal>& particles,
+                                 const BDSParticleDefinition*              particleDefinition) const
+{
+  if (elements.empty() || particles.empty() || !particleDefinition)
+    {return;}
+
+  // as G4Mag_EqRhs::FCof() used by the integrators
+  const G4double fcof = particleDefinition->Charge() * CLHEP::eplus * CLHEP::c_light;
+  const G4double mass = particleDefinition->Mass();
+
+  State s;
+  s.Resize(particles.size());
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < particles.size(); i++)
+    {
+      const auto& local = particles[i].local;
+      // only particles at the start of the beam line are in the frame of the first element
+      if (BDS::IsFinite(local.s) || BDS::IsFinite(local.z) || local.zp <= 0)
+        {continue;}
+      G4double momentum = std::sqrt(local.totalEnergy*local.totalEnergy - mass*mass);
+      if (!BDS::IsFinite(momentum))
+        {continue;}
+      s.index[n] = i;
+      s.x[n]  = local.x;
+      s.y[n]  = local.y;
+      s.xp[n] = local.xp;
+      s.yp[n] = local.yp;
+      s.zp[n] = local.zp;
+      s.T[n]  = particles[i].global.T;
+      s.fcofOverP[n]       = fcof / momentum;
+      s.inverseVelocity[n] = local.totalEnergy / (momentum * CLHEP::c_light);
+      n++;
+    }
+  s.Resize(n);
+  State entry = s; // coordinates at the start of the current element
+
+  for (const auto& element : elements)
+    {
+      entry.CopyCoordinates(s);
+      std::fill(s.ok.begin(), s.ok.begin() + n, 1);
+      CheckAperture(s, n, element);
+      const G4double dz = element.chordLength / (G4double)element.nSteps;
+      for (G4int step = 0; step < element.nSteps; step++)
+        {
+          switch (element.kind)
+            {
+            case Kind::drift:
+              {AdvanceDrift(s, n, dz); break;}
+            case Kind::quadrupole:
+              {AdvanceQuadrupole(s, n, dz, element.strength); break;}
+            case Kind::solenoid:
+              {AdvanceSolenoid(s, n, dz, element.strength); break;}
+            }
+          CheckAperture(s, n, element);
+        }
+
+      // hand back any particle that failed at the start of this element and
+      // compact the remaining ones to the front of the arrays
+      std::size_t nKept = 0;
+      for (std::size_t i = 0; i < n; i++)
+        {
+          if (s.ok[i])
+            {
+              if (i != nKept)
+                {s.Move(i, nKept);}
+              nKept++;
+            }
+          else
+            {HandBack(entry, i, element.positionStart, element.rotationStart, element.beamlineIndex, particles);}
+        }
+      n = nKept;
+      if (n == 0)
+        {return;}
+      s.Resize(n);
+      entry.Resize(n);
+    }
+
+  for (std::size_t i = 0; i < n; i++)
+    {HandBack(s, i, positionEnd, rotationEnd, beamlineIndexEnd, particles);}
+}
+
+void BDSFastTransport::AdvanceDrift(State& s, std::size_t n, G4double dz) const
+{
+  for (std::size_t i = 0; i < n; i++)
+    {
+      G4double h = dz / s.zp[i];
+      s.x[i] += s.xp[i] * h;
+      s.y[i] += s.yp[i] * h;
+      s.T[i] += h * s.inverseVelocity[i];
+    }
+}
+
+void BDSFastTransport::AdvanceQuadrupole(State& s, std::size_t n, G4double dz, G4double bPrime) const
+{
+  for (std::size_t i = 0; i < n; i++)
+    {
+      const G4double x0  = s.x[i];
+      const G4double y0  = s.y[i];
+      const G4double xp0 = s.xp[i];
+      const G4double yp0 = s.yp[i];
+      const G4double zp0 = s.zp[i];
+      const G4double h   = dz / zp0;
+      s.T[i] += h * s.inverseVelocity[i];
+
+      const G4double kappa = s.fcofOverP[i] * bPrime;
+      if (std::abs(kappa) < 1e-20)
+        {// drift as in the integrator
+          s.x[i] += xp0 * h;
+          s.y[i] += yp0 * h;
+          continue;
+        }
+
+      // the integrator would use the backup stepper
+      G4bool paraxial = zp0 >= (1.0 - backupStepperMomLimit) && std::abs(xp0) <= backupStepperMomLimit
+                        && std::abs(yp0) <= backupStepperMomLimit;
+      G4double ax = -zp0*x0;
+      G4double ay =  zp0*y0;
+      G4double az =  x0*xp0 - y0*yp0;
+      G4double localAMag = std::abs(kappa) * std::sqrt(ax*ax + ay*ay + az*az);
+      G4bool tooCurved = localAMag * minimumRadiusOfCurvature > 1;
+      s.ok[i] = s.ok[i] && paraxial && !tooCurved;
+
+      G4double rootK  = std::sqrt(std::abs(kappa*zp0));
+      G4double rootKh = rootK*h*zp0;
+      G4double cosine = std::cos(rootKh);
+      G4double sine   = std::sin(rootKh)/rootK;
+      G4double coshK  = std::cosh(rootKh);
+      G4double sinhK  = std::sinh(rootKh)/rootK;
+      G4double absK   = std::abs(kappa);
+      G4bool   focus  = kappa >= 0; // focussing in x
+
+      G4double X11 = focus ? cosine     : coshK;
+      G4double X12 = focus ? sine       : sinhK;
+      G4double X21 = focus ? -absK*sine : absK*sinhK;
+      G4double Y11 = focus ? coshK      : cosine;
+      G4double Y12 = focus ? sinhK      : sine;
+      G4double Y21 = focus ? absK*sinhK : -absK*sine;
+
+      G4double xp1 = X21*x0 + X11*xp0;
+      G4double yp1 = Y21*y0 + Y11*yp0;
+      G4double zp1 = std::sqrt(1 - xp1*xp1 - yp1*yp1);
+      s.x[i]  = X11*x0 + X12*xp0;
+      s.y[i]  = Y11*y0 + Y12*yp0;
+      s.xp[i] = xp1;
+      s.yp[i] = yp1;
+      s.zp[i] = std::isnan(zp1) ? zp0 : zp1;
+    }
+}
+
+void BDSFastTransport::AdvanceSolenoid(State& s, std::size_t n, G4double dz, G4double bField) const
+{
+  for (std::size_t i = 0; i < n; i++)
+    {
+      const G4double x0  = s.x[i];
+      const G4double y0  = s.y[i];
+      const G4double xp0 = s.xp[i];
+      const G4double yp0 = s.yp[i];
+      const G4double zp0 = s.zp[i];
+      const G4double h   = dz / zp0;
+      s.T[i] += h * s.inverseVelocity[i];
+
+      // kappa as in BDSIntegratorSolenoid
+      const G4double kappa = 0.5*s.fcofOverP[i]*bField / CLHEP::m;
+      if (std::abs(kappa) < 1e-20)
+        {
+          s.x[i] += xp0 * h;
+          s.y[i] += yp0 * h;
+          continue;
+        }
+
+      G4bool paraxial = zp0 >= (1.0 - backupStepperMomLimit) && std::abs(xp0) <= backupStepperMomLimit
+                        && std::abs(yp0) <= backupStepperMomLimit;
+      s.ok[i] = s.ok[i] && paraxial;
+
+      G4double C      = std::cos(2 * kappa * h);
+      G4double S      = std::sin(2 * kappa * h);
+      G4double S2oK   = S / kappa;
+      G4double OmC2oK = (1.0 - C) / kappa;
+
+      G4double xp1 =  C*xp0 + S*yp0;
+      G4double yp1 = -S*xp0 + C*yp0;
+      G4double zp1 = std::sqrt(1 - xp1*xp1 - yp1*yp1);
+      s.x[i]  = x0 + 0.5*S2oK*xp0 + 0.5*OmC2oK*yp0;
+      s.y[i]  = y0 - 0.5*OmC2oK*xp0 + 0.5*S2oK*yp0;
+      s.xp[i] = xp1;
+      s.yp[i] = yp1;
+      s.zp[i] = std::isnan(zp1) ? zp0 : zp1;
+    }
+}
+
+void BDSFastTransport::CheckAperture(State& s, std::size_t n, const Element& e) const
+{
+  const G4double a1 = e.aper1;
+  const G4double a2 = e.aper2;
+  const G4double a3 = e.aper3;
+  const G4double a4 = e.aper4;
+  const G4double ox = e.aperOffsetX;
+  const G4double oy = e.aperOffsetY;
+  switch (e.apertureType.underlying())
+    {
+    case BDSBeamPipeType::circular:
+    case BDSBeamPipeType::circularvacuum:
+      {
+        for (std::size_t i = 0; i < n; i++)
+          {
+            G4double x = s.x[i] - ox;
+            G4double y = s.y[i] - oy;
+            s.ok[i] = s.ok[i] && (x*x + y*y < a1*a1);
+          }
+        break;
+      }
+    case BDSBeamPipeType::elliptical:
+      {
+        for (std::size_t i = 0; i < n; i++)
+          {
+            G4double x = (s.x[i] - ox) / a1;
+            G4double y = (s.y[i] - oy) / a2;
+            s.ok[i] = s.ok[i] && (x*x + y*y < 1);
+          }
+        break;
+      }
+    case BDSBeamPipeType::rectangular:
+      {
+        for (std::size_t i = 0; i < n; i++)
+          {s.ok[i] = s.ok[i] && std::abs(s.x[i] - ox) < a1 && std::abs(s.y[i] - oy) < a2;}
+        break;
+      }
+    case BDSBeamPipeType::lhc:
+      {
+        for (std::size_t i = 0; i < n; i++)
+          {
+            G4double x = s.x[i] - ox;
+            G4double y = s.y[i] - oy;
+            s.ok[i] = s.ok[i] && std::abs(x) < a1 && std::abs(y) < a2 && (x*x + y*y < a3*a3);
+          }
+        break;
+      }
+    case BDSBeamPipeType::rectellipse:
+      {
+        for (std::size_t i = 0; i < n; i++)
+          {
+            G4double x = s.x[i] - ox;
+            G4double y = s.y[i] - oy;
+            G4double xe = x / a3;
+            G4double ye = y / a4;
+            s.ok[i] = s.ok[i] && std::abs(x) < a1 && std::abs(y) < a2 && (xe*xe + ye*ye < 1);
+          }
+        break;
+      }
+    default:
+      {// not analytic - never reached as such elements aren't used
+        std::fill(s.ok.begin(), s.ok.begin() + n, 0);
+        break;
+      }
+    }
+}
+
+void BDSFastTransport::HandBack(const State&                              s,
+                                std::size_t                               i,
+                                const G4ThreeVector&                      position,
+                                const G4RotationMatrix&                   rotation,
+                                G4int                                     beamlineIndex,
+                                std::vector<BDSParticleCoordsFullGlobal>& particles) const
+{
+  G4ThreeVector globalPosition  = position + rotation * G4ThreeVector(s.x[i], s.y[i], 0);
+  G4ThreeVector globalDirection = (rotation * G4ThreeVector(s.xp[i], s.yp[i], s.zp[i])).unit();
+  BDSParticleCoordsFullGlobal& p = particles[s.index[i]];
+  p.global = BDSParticleCoords(globalPosition, globalDirection, s.T[i]);
+  p.beamlineIndex = beamlineIndex;
+}
@@ -41,10 +41,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <utility>
 
 BDSFieldEMMuonCooler::BDSFieldEMMuonCooler(const BDSFieldInfoExtraMuonCooler* info,
-                                           G4double /*brho*/):
+                                           G4double /*brho*/,
+                                           G4double specialFunctionToleranceIn):
   coilField(nullptr),
   dipoleField(nullptr),
-  rfField(nullptr)
+  rfField(nullptr),
+  specialFunctionTolerance(specialFunctionToleranceIn)
 {
   BuildMagnets(info);
   BuildDipoles(info);
@@ -68,7 +70,8 @@ void BDSFieldEMMuonCooler::BuildMagnets(const BDSFieldInfoExtraMuonCooler* info)
                                                           ci.radialThickness,
                                                           ci.fullLengthZ,
                                                           ci.onAxisTolerance,
-                                                          ci.nSheets));
+                                                          ci.nSheets,
+                                                          specialFunctionTolerance));
             fieldOffsets.emplace_back(0,0,ci.offsetZ);
           }
         coilField = new BDSFieldMagVectorSum(fields, fieldOffsets);
@@ -85,7 +88,8 @@ void BDSFieldEMMuonCooler::BuildMagnets(const BDSFieldInfoExtraMuonCooler* info)
                                                           true,
                                                           ci.innerRadius + 0.5*ci.radialThickness,
                                                           ci.fullLengthZ,
-                                                          ci.onAxisTolerance));
+                                                          ci.onAxisTolerance,
+                                                          specialFunctionTolerance));
             fieldOffsets.emplace_back(0,0,ci.offsetZ);
           }
         coilField = new BDSFieldMagVectorSum(fields, fieldOffsets);
@@ -174,7 +178,8 @@ void BDSFieldEMMuonCooler::BuildRF(const BDSFieldInfoExtraMuonCooler* info)
            ci.frequency,
            ci.phaseOffset,
            ci.cavityRadius,
-           0.0 // We provide a global tOffset instead
+           0.0, // We provide a global tOffset instead
+           specialFunctionTolerance
            );
       double lengthZ = ci.lengthZ;
       G4ThreeVector posOffset(0.0, 0.0, ci.offsetZ);
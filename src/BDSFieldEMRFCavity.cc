@@ -21,52 +21,61 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSException.hh"
 #include "BDSFieldEMRFCavity.hh"
 #include "BDSMagnetStrength.hh"
+#include "BDSSpecialFunctions.hh"
+#include "BDSSpecialFunctionTable.hh"
 #include "BDSUtilities.hh"
 
 #include "CLHEP/Units/PhysicalConstants.h"
 #include "globals.hh"
 #include "G4ThreeVector.hh"
 
-#include "TMath.h"
-
 #include <cmath>
 #include <utility>
 
-const G4double BDSFieldEMRFCavity::j0FirstZero = 2.404825557695772768622;
+const G4double BDSFieldEMRFCavity::j0FirstZero = BDS::besselJ0FirstZero;
 
 const G4double BDSFieldEMRFCavity::Z0 = CLHEP::mu0 * CLHEP::c_light;
 
-BDSFieldEMRFCavity::BDSFieldEMRFCavity(BDSMagnetStrength const* strength):
+BDSFieldEMRFCavity::BDSFieldEMRFCavity(BDSMagnetStrength const* strength,
+                                       G4double specialFunctionTolerance):
   BDSFieldEMRFCavity((*strength)["efield"],
                      (*strength)["frequency"],
                      (*strength)["phase"],
                      (*strength)["equatorradius"],
-                     (*strength)["synchronousT0"])
+                     (*strength)["synchronousT0"],
+                     specialFunctionTolerance)
 {;}
 
 BDSFieldEMRFCavity::BDSFieldEMRFCavity(G4double eFieldAmplitude,
                                        G4double frequencyIn,
                                        G4double phaseOffset,
                                        G4double cavityRadiusIn,
-                                       G4double synchronousTIn):
+                                       G4double synchronousTIn,
+                                       G4double specialFunctionTolerance):
   eFieldMax(eFieldAmplitude),
   phase(phaseOffset),
   cavityRadius(cavityRadiusIn),
   synchronousT(synchronousTIn),
   normalisedCavityRadius(j0FirstZero/cavityRadius),
-  angularFrequency(CLHEP::twopi * frequencyIn)
+  angularFrequency(CLHEP::twopi * frequencyIn),
+  besselJ0Table(nullptr),
+  besselJ1Table(nullptr)
 {
   // this would cause NANs to be propagated into tracking which is really bad
   if (!BDS::IsFinite(cavityRadiusIn) || std::isnan(normalisedCavityRadius) || std::isinf(normalisedCavityRadius))
     {throw BDSException(__METHOD_NAME__, "no cavity radius supplied - required for pill box model");}
+  if (specialFunctionTolerance > 0)
+    {
+      besselJ0Table = BDS::BesselJ0Table(specialFunctionTolerance);
+      besselJ1Table = BDS::BesselJ1Table(specialFunctionTolerance);
+    }
 }
 
 std::pair<G4ThreeVector, G4ThreeVector> BDSFieldEMRFCavity::GetField(const G4ThreeVector& position,
                                                                      const G4double       t) const
 {
   // Converting from Local Cartesian to Local Cylindrical
-  G4double phi = std::atan2(position.y(),position.x());
-  G4double r   = std::hypot(position.x(),position.y());
+  G4double r = std::hypot(position.x(),position.y());
 
   G4double rNormalised = normalisedCavityRadius * r;
 
@@ -74,8 +83,8 @@ std::pair<G4ThreeVector, G4ThreeVector> BDSFieldEMRFCavity::GetField(const G4Thr
   if (rNormalised > j0FirstZero)
     {rNormalised = j0FirstZero - 1e-6;}
 
-  G4double J0r = TMath::BesselJ0(rNormalised);
-  G4double J1r = TMath::BesselJ1(rNormalised);
+  G4double J0r = besselJ0Table ? (*besselJ0Table)(rNormalised) : BDS::BesselJ0(rNormalised);
+  G4double J1r = besselJ1Table ? (*besselJ1Table)(rNormalised) : BDS::BesselJ1(rNormalised);
 
   // Calculating free-space impedance and scale factor for Bphi:
   G4double hMax = -eFieldMax/Z0;
@@ -86,11 +95,15 @@ std::pair<G4ThreeVector, G4ThreeVector> BDSFieldEMRFCavity::GetField(const G4Thr
   G4double Ez   = eFieldMax * J0r * std::cos(arg);
   G4double Bphi = Bmax * J1r * std::sin(arg);
 
-  // Converting Bphi into cartesian coordinates:
-  G4TwoVector bxby(0,Bphi); // this is equivalent to a pi/2 rotation of (1,0)
-  bxby.rotate(phi);
-  G4double Bx = bxby.x();
-  G4double By = bxby.y();
+  // Converting Bphi into cartesian coordinates: unit phi = (-sin(phi), cos(phi)) = (-y, x) / r
+  // Bphi is 0 on axis as J1(0) = 0
+  G4double Bx = 0;
+  G4double By = 0;
+  if (r > 0)
+    {
+      Bx = -Bphi * position.y() / r;
+      By =  Bphi * position.x() / r;
+    }
   
   // Local B and E fields:
   G4ThreeVector LocalB = G4ThreeVector(Bx, By, 0);
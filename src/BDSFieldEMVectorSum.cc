@@ -24,6 +24,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
 
+#include <cmath>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -50,6 +52,7 @@ BDSFieldEMVectorSum::BDSFieldEMVectorSum(const std::vector<BDSFieldEM*>& fieldsI
     {
       *it /= 2.;
     }
+  BuildIndex();
 }
 
 BDSFieldEMVectorSum::~BDSFieldEMVectorSum()
@@ -66,24 +69,30 @@ void BDSFieldEMVectorSum::PushBackField(const G4ThreeVector& positionOffset,
   fieldOffsets.push_back(positionOffset);
   timeOffsets.push_back(timeOffset);
   zLengthsOver2.push_back(zLength/2);
+  BuildIndex();
+}
+
+void BDSFieldEMVectorSum::BuildIndex()
+{
+  std::vector<G4double> zCentres;
+  for (const auto& offset : fieldOffsets)
+    {zCentres.push_back(offset.z());}
+  zIndex.Build(zCentres, zLengthsOver2);
 }
 
 std::pair<G4ThreeVector,G4ThreeVector> BDSFieldEMVectorSum::GetField(const G4ThreeVector& position,
                                                                      const G4double       t) const
 {
   std::pair<G4ThreeVector, G4ThreeVector> result;
-  for (G4int i = 0; i < (G4int)fields.size(); i++)
-    {
-      G4ThreeVector dr = position - fieldOffsets[i];
-      if (fabs(dr.z()) > zLengthsOver2[i])
-        {
-          continue; // out of bounding box
-        }
-      G4double dt = t - timeOffsets[i];
-      auto deltaField = fields[i]->GetField(dr,dt);
-      result.first += deltaField.first;
-      result.second += deltaField.second;
-      
-    }
+  zIndex.ForEachCandidate(position.z(), [&](std::size_t i)
+  {
+    G4ThreeVector dr = position - fieldOffsets[i];
+    if (fabs(dr.z()) > zLengthsOver2[i])
+      {return;} // out of bounding box
+    G4double dt = t - timeOffsets[i];
+    auto deltaField = fields[i]->GetField(dr,dt);
+    result.first += deltaField.first;
+    result.second += deltaField.second;
+  });
   return result;
 }
\ No newline at end of file
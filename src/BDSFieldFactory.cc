@@ -167,7 +167,8 @@ BDSFieldFactory* BDSFieldFactory::Instance()
 }
 
 BDSFieldFactory::BDSFieldFactory():
-  useOldMultipoleOuterFields(false)
+  useOldMultipoleOuterFields(false),
+  specialFunctionTolerance(0)
 {
   G4double defaultRigidity = std::numeric_limits<double>::max();
   if (designParticle)
@@ -179,6 +180,7 @@ BDSFieldFactory::BDSFieldFactory():
       PrepareFieldDefinitions(BDSParser::Instance()->GetFields(), defaultRigidity);
     }
   useOldMultipoleOuterFields = BDSGlobalConstants::Instance()->UseOldMultipoleOuterFields();
+  specialFunctionTolerance   = BDSGlobalConstants::Instance()->SpecialFunctionTolerance();
 }
 
 BDSFieldFactory::~BDSFieldFactory()
@@ -617,11 +619,11 @@ BDSFieldMag* BDSFieldFactory::CreateFieldMagRaw(const BDSFieldInfo&      info,
     case BDSFieldType::dipole3d:
       {field = new BDSFieldMagDipole(strength); break;}
     case BDSFieldType::solenoidblock:
-      {field = new BDSFieldMagSolenoidBlock(strength, poleTipRadius); break;}
+      {field = new BDSFieldMagSolenoidBlock(strength, poleTipRadius, specialFunctionTolerance); break;}
     case BDSFieldType::solenoidloop:
       {field = new BDSFieldMagSolenoidLoop(strength, poleTipRadius); break;}
     case BDSFieldType::solenoidsheet:
-      {field = new BDSFieldMagSolenoidSheet(strength, poleTipRadius); break;}
+      {field = new BDSFieldMagSolenoidSheet(strength, poleTipRadius, 0.0, specialFunctionTolerance); break;}
     case BDSFieldType::quadrupole:
       {field = new BDSFieldMagQuadrupole(strength, brho); break;}
     case BDSFieldType::undulator:
@@ -876,7 +878,7 @@ BDSFieldObjects* BDSFieldFactory::CreateFieldEM(const BDSFieldInfo& info)
   switch (info.FieldType().underlying())
     {
     case BDSFieldType::rfpillbox:
-      {field = new BDSFieldEMRFCavity(info.MagnetStrength()); break;}
+      {field = new BDSFieldEMRFCavity(info.MagnetStrength(), specialFunctionTolerance); break;}
     case BDSFieldType::ebmap1d:
     case BDSFieldType::ebmap2d:
     case BDSFieldType::ebmap3d:
@@ -1300,7 +1302,7 @@ BDSFieldEM* BDSFieldFactory::CreateMuonCoolerField(const BDSFieldInfo& info,
   if (!mcExtraInfo) // shouldn't happen, but just for safety
     {throw BDSException(__METHOD_NAME__, "no muon cooler extra definitions for field definition: " + info.NameOfParserDefinition());}
   
-  BDSFieldEM* result = new BDSFieldEMMuonCooler(mcExtraInfo, brho);
+  BDSFieldEM* result = new BDSFieldEMMuonCooler(mcExtraInfo, brho, specialFunctionTolerance);
   return result;
 }
 BDSModulator* BDSFieldFactory::CreateModulator(const BDSModulatorInfo* modulatorRecipe,
@@ -22,6 +22,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSArray2DCoordsTransformed.hh"
 #include "BDSArray3DCoords.hh"
 #include "BDSArray3DCoordsTransformed.hh"
+#include "BDSArray4D.hh"
 #include "BDSArray4DCoords.hh"
 #include "BDSArray4DCoordsTransformed.hh"
 #include "BDSArray2DCoordsRDipole.hh"
@@ -39,7 +40,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSArrayOperatorValueReflectQuadrupoleXY.hh"
 #include "BDSArrayOperatorValueReflectSolenoidZ.hh"
 #include "BDSArrayOperatorValueV.hh"
+#include "BDSArrayLayoutType.hh"
 #include "BDSArrayReflectionType.hh"
+#include "BDSArrayStorageType.hh"
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSFieldEInterpolated.hh"
@@ -85,7 +88,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSInterpolator4DNearest.hh"
 #include "BDSInterpolatorType.hh"
 #include "BDSFieldMagGradient.hh"
+#include "BDSGlobalConstants.hh"
 #include "BDSMagnetStrength.hh"
+#include "BDSUtilities.hh"
 #include "BDSWarning.hh"
 
 #include "globals.hh" // geant4 types / globals
@@ -95,7 +100,13 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <array>
 #include <cmath>
 #include <fstream>
+#include <iomanip>
+#include <limits>
 #include <set>
+#include <sstream>
+#include <string>
+
+#include <sys/stat.h>
 
 #ifdef USE_GZSTREAM
 #include "src-external/gzstream/gzstream.h"
@@ -110,7 +121,8 @@ BDSFieldLoader* BDSFieldLoader::Instance()
   return instance;
 }
 
-BDSFieldLoader::BDSFieldLoader()
+BDSFieldLoader::BDSFieldLoader():
+  autoScaleCacheLoaded(false)
 {;}
 
 BDSFieldLoader::~BDSFieldLoader()
@@ -186,18 +198,10 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadMagField(const BDSFieldInfo&      i
       auto magIntType = BDS::InterpolatorTypeSpecificFromAuto(nDimFF, BDSInterpolatorType::cubicauto);
       temporaryRecipe.SetMagneticInterpolatorType(magIntType);
 
-      // build temporary field object
-      BDSFieldMagInterpolated* tempField = LoadMagField(temporaryRecipe);
-
-      // calculate field gradients and therefore associated strengths for a given rigidity
-      BDSFieldMagGradient calculator;
-      BDSMagnetStrength* calculatedStrengths = calculator.CalculateMultipoles(tempField,
-                                                                              5,/*up to 5th order*/
-                                                                              info.BRho());
-      
-      delete tempField; // clear up
+      // calculated field gradients and therefore associated strengths for a given rigidity
+      const BDSMagnetStrength& calculatedStrengths = AutoScaleStrengths(temporaryRecipe);
 
-      G4double calculatedNumber = (*calculatedStrengths)[scalingKey];
+      G4double calculatedNumber = calculatedStrengths[scalingKey];
       G4double ratio = (*scalingStrength)[scalingKey] / calculatedNumber;
       if (!std::isnormal(ratio))
         {
@@ -209,12 +213,136 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadMagField(const BDSFieldInfo&      i
       G4cout << "autoScale> Ratio of supplied strength to calculated map strength: " << ratio << G4endl;
       G4cout << "autoScale> New overall scaling factor: " << bScaling*ratio << G4endl;
       result->SetScaling(newScale);
-      delete calculatedStrengths;
     }
   
   return result;
 }
 
+const BDSMagnetStrength& BDSFieldLoader::AutoScaleStrengths(const BDSFieldInfo& recipe)
+{
+  LoadAutoScaleCache();
+  G4String key = AutoScaleCacheKey(recipe);
+  auto search = autoScaleCache.find(key);
+  if (search != autoScaleCache.end())
+    {
+      G4cout << "autoScale> Using previously calculated strengths for \"" << recipe.MagneticFile() << "\"" << G4endl;
+      return search->second;
+    }
+
+  // build temporary field object
+  BDSFieldMagInterpolated* tempField = LoadMagField(recipe);
+
+  // calculate field gradients and therefore associated strengths for a given rigidity
+  BDSFieldMagGradient calculator;
+  BDSMagnetStrength* calculatedStrengths = calculator.CalculateMultipoles(tempField,
+                                                                          5,/*up to 5th order*/
+                                                                          recipe.BRho());
+  delete tempField; // clear up
+
+  auto inserted = autoScaleCache.emplace(key, *calculatedStrengths);
+  delete calculatedStrengths;
+  SaveAutoScaleCacheEntry(key, inserted.first->second);
+  return inserted.first->second;
+}
+
+G4String BDSFieldLoader::AutoScaleCacheKey(const BDSFieldInfo& recipe) const
+{
+  // include the size and modification time of the file so a changed map isn't
+  // matched to strengths calculated from an older version in the cache file
+  G4String filePath = recipe.MagneticFile();
+  struct stat sb;
+  long long fileSize = 0;
+  long long fileTime = 0;
+  if (stat(filePath.c_str(), &sb) == 0)
+    {
+      fileSize = (long long)sb.st_size;
+      fileTime = (long long)sb.st_mtime;
+    }
+
+  const G4Transform3D& tr = recipe.Transform();
+  std::ostringstream key;
+  key << std::setprecision(std::numeric_limits<G4double>::max_digits10);
+  key << filePath << "|" << fileSize << "|" << fileTime << "|"
+      << recipe.MagneticFormat() << "|" << recipe.MagneticInterpolatorType() << "|";
+  for (const auto& reflection : recipe.MagneticArrayReflectionType())
+    {key << reflection << ",";}
+  key << "|" << recipe.BRho();
+  for (G4double v : {tr.xx(), tr.xy(), tr.xz(), tr.dx(),
+                     tr.yx(), tr.yy(), tr.yz(), tr.dy(),
+                     tr.zx(), tr.zy(), tr.zz(), tr.dz()})
+    {key << "|" << v;}
+  return G4String(key.str());
+}
+
+void BDSFieldLoader::LoadAutoScaleCache()
+{
+  if (autoScaleCacheLoaded)
+    {return;}
+  autoScaleCacheLoaded = true;
+
+  G4String fileName = BDSGlobalConstants::Instance()->FieldAutoScaleCacheFile();
+  if (fileName.empty())
+    {return;}
+  autoScaleCacheFile = BDS::GetFullPath(fileName, false, true); // relative to cwd like output
+
+  std::ifstream file(autoScaleCacheFile);
+  if (!file.is_open())
+    {return;} // fine - no cache yet and it will be written
+
+  // each line is the key then tab separated pairs of strength name and value
+  G4int nEntries = 0;
+  std::string line;
+  while (std::getline(file, line))
+    {
+      if (line.empty() || line[0] == '#')
+        {continue;}
+      std::istringstream ss(line);
+      std::string key;
+      std::getline(ss, key, '\t');
+      BDSMagnetStrength strengths;
+      std::string name;
+      G4double value;
+      G4bool problem = false;
+      while (std::getline(ss, name, '\t'))
+        {
+          if (!(ss >> value) || !BDSMagnetStrength::ValidKey(name))
+            {problem = true; break;}
+          strengths[name] = value;
+          ss.ignore(1); // the tab after the value
+        }
+      if (problem || key.empty())
+        {
+          BDS::Warning(__METHOD_NAME__, "ignoring invalid line in autoScale cache file \"" + autoScaleCacheFile + "\"");
+          continue;
+        }
+      autoScaleCache[G4String(key)] = strengths;
+      nEntries++;
+    }
+  G4cout << "autoScale> Loaded " << nEntries << " cached field map strengths from \"" << autoScaleCacheFile << "\"" << G4endl;
+}
+
+void BDSFieldLoader::SaveAutoScaleCacheEntry(const G4String& key,
+                                             const BDSMagnetStrength& strengths) const
+{
+  if (autoScaleCacheFile.empty())
+    {return;}
+
+  std::ofstream file(autoScaleCacheFile, std::ios::app);
+  if (!file.is_open())
+    {
+      BDS::Warning(__METHOD_NAME__, "unable to write to autoScale cache file \"" + autoScaleCacheFile + "\"");
+      return;
+    }
+  file << std::setprecision(std::numeric_limits<G4double>::max_digits10);
+  file << key;
+  for (const auto& kv : strengths)
+    {
+      if (std::isfinite(kv.second)) // unset keys are zero anyway
+        {file << "\t" << kv.first << "\t" << kv.second;}
+    }
+  file << "\n";
+}
+
 BDSFieldEInterpolated* BDSFieldLoader::LoadEField(const BDSFieldInfo& info)
 {
   EFilePathOK(info);
@@ -337,6 +465,43 @@ void BDSFieldLoader::EFilePathOK(const BDSFieldInfo& info)
     }
 }
 
+void BDSFieldLoader::ConvertArray(BDSArray4D* array,
+                                  const G4String& filePath) const
+{
+  if (!array)
+    {return;}
+  const BDSGlobalConstants* g = BDSGlobalConstants::Instance();
+
+  BDSArrayLayoutType layout = g->FieldMapLayout();
+  if (layout != BDSArrayLayoutType::linear)
+    {
+      array->SetLayout(layout);
+      G4cout << "BDSIM Field Format> Arranged \"" << filePath << "\" in " << layout << " layout ("
+             << array->PaddingMemoryUsage() / 1024 << " kB of padding)" << G4endl;
+    }
+
+  BDSArrayStorageType storageType = g->FieldMapStorageType();
+  if (storageType == BDSArrayStorageType::full)
+    {return;}
+
+  std::size_t memoryBefore = array->MemoryUsage();
+  G4double maxError = 0;
+  G4double rmsError = 0;
+  G4double maxValue = 0;
+  try
+    {array->SetStorageType(storageType, maxError, rmsError, maxValue);}
+  catch (BDSException& e)
+    {
+      e.AppendToMessage("\nfor field map \"" + filePath + "\" - try another fieldMapStorageType");
+      throw;
+    }
+  G4double relative = maxValue > 0 ? maxError / maxValue : 0;
+  G4cout << "BDSIM Field Format> Stored \"" << filePath << "\" as " << storageType
+         << ": " << memoryBefore / 1024 << " kB -> " << array->MemoryUsage() / 1024 << " kB" << G4endl;
+  G4cout << "BDSIM Field Format> Storage error (before scaling): maximum " << maxError
+         << " (" << relative << " of the maximum component), RMS " << rmsError << G4endl;
+}
+
 BDSArray1DCoords* BDSFieldLoader::Get1DCached(const G4String& filePath)
 {
   auto result = arrays1d.find(filePath);
@@ -394,6 +559,7 @@ BDSArray2DCoords* BDSFieldLoader::LoadPoissonMag2D(const G4String& filePath)
       BDSFieldLoaderPoisson<std::ifstream> loader;
       result = loader.LoadMag2D(filePath);
     }
+  ConvertArray(result, filePath);
   arrays2d[filePath] = result;
   return result;  
 }
@@ -421,6 +587,7 @@ BDSArray1DCoords* BDSFieldLoader::LoadBDSIM1D(const G4String& filePath)
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load1D(filePath);
     }
+  ConvertArray(result, filePath);
   arrays1d[filePath] = result;
   return result;
 }
@@ -446,6 +613,7 @@ BDSArray2DCoords* BDSFieldLoader::LoadBDSIM2D(const G4String& filePath)
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load2D(filePath);
     }
+  ConvertArray(result, filePath);
   arrays2d[filePath] = result;
   return result;
 }
@@ -471,6 +639,7 @@ BDSArray3DCoords* BDSFieldLoader::LoadBDSIM3D(const G4String& filePath)
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load3D(filePath);
 }
+  ConvertArray(result, filePath);
   arrays3d[filePath] = result;
   return result;
 }
@@ -496,6 +665,7 @@ BDSArray4DCoords* BDSFieldLoader::LoadBDSIM4D(const G4String& filePath)
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load4D(filePath);
     }
+  ConvertArray(result, filePath);
   arrays4d[filePath] = result;
   return result;
 }
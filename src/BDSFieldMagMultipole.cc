@@ -24,7 +24,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh"
 #include "G4ThreeVector.hh"
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <vector>
 
 BDSFieldMagMultipole::BDSFieldMagMultipole(BDSMagnetStrength const* strength,
@@ -62,56 +64,73 @@ BDSFieldMagMultipole::BDSFieldMagMultipole(BDSMagnetStrength const* strength,
   // class supports.
   if (std::abs(order) > (G4int)normalComponents.size())
     {order = (G4int)normalComponents.size();}
+
+  // Fold the factorial into the coefficients so it's not done per field query.
+  // I want to use the strange convention of dipole coeff. with opposite sign -
+  // then it is the same sign as angle.
+  // Both are made the same length so either can be summed up to the maximum order.
+  std::size_t nComponents = std::max(normalComponents.size(), skewComponents.size());
+  normalComponents.resize(nComponents, 0);
+  skewComponents.resize(nComponents, 0);
+  G4double ffact = -1;
+  for (std::size_t i = 0; i < nComponents; i++)
+    {
+      normalComponents[i] /= ffact;
+      skewComponents[i]   /= ffact;
+      ffact *= (G4double)i+2;
+    }
 }
 
 G4ThreeVector BDSFieldMagMultipole::GetField(const G4ThreeVector &position,
 					     const G4double       /*t*/) const
 {
-  // Translate cartesian to polar coordinates
-  G4double r   = std::hypot(position.x(),position.y());
-  G4double phi = 0;
-  if (BDS::IsFiniteStrength(std::abs(r)))
-    {phi = atan2(position.y(),position.x());}
-
-  // compute B field in cylindrical coordinates first then convert to cartesian
-  // Bx = Br * cos(phi) - Bphi * sin(phi)
-  // By = Br * sin(phi) + Bphi * cos(phi)
-  // where, if n=1 is for dipole:
+  // In polar coordinates, if n=1 is for dipole:
   // Br  (n) (normal) = +Bn/(n-1)! * r^(n-1) * sin(n*phi)
   // Bphi(n) (normal) = +Bn/(n-1)! * r^(n-1) * cos(n*phi)
   // Br  (n) (skewed) = +Bn/(n-1)! * r^(n-1) * cos(n*phi)
   // Bphi(n) (skewed) = -Bn/(n-1)! * r^(n-1) * sin(n*phi)
-  // cumulative variables for calculating the field
-
-  G4double br = 0;
-  G4double bphi = 0;
-  // I want to use the strange convention of dipole coeff. with opposite sign -
-  // then it is the same sign as angle.
-  G4double ffact = -1;
-  for (G4int i = 0; i < maximumNonZeroOrder; i++)
+  // Converting to Cartesian with Bx = Br cos(phi) - Bphi sin(phi) and
+  // By = Br sin(phi) + Bphi cos(phi), r^(n-1) * (cos((n-1)phi), sin((n-1)phi)) is
+  // just (x + iy)^(n-1), so no polar coordinates are needed.
+  G4double x  = position.x();
+  G4double y  = position.y();
+  G4double bx = 0;
+  G4double by = 0;
+  const G4double* an = normalComponents.data();
+  const G4double* bn = skewComponents.data();
+  switch (maximumNonZeroOrder)
     {
-      // Here we add to so order represents kn properly
-      G4double o = (G4double)i+2; // the current order
-      br   += normalComponents[i] * std::pow(r, o - 1) * std::sin(o * phi) / ffact; //normal
-      br   -= skewComponents[i]   * std::pow(r, o - 1) * std::cos(o * phi) / ffact; //skewed
-
-      bphi += normalComponents[i] * std::pow(r, o - 1) * std::cos(o * phi) / ffact; //normal
-      bphi += skewComponents[i]   * std::pow(r, o - 1) * std::sin(o * phi) / ffact; //skewed
-
-      // Ignore dipole component for now!
-      //if(o==1) // for the angle convention
-	  //{br *= -1; bphi *=-1; }
-
-      ffact *= o;
+    case 1:
+      {SumOrders<1>(an, bn, x, y, bx, by); break;}
+    case 2:
+      {SumOrders<2>(an, bn, x, y, bx, by); break;}
+    case 3:
+      {SumOrders<3>(an, bn, x, y, bx, by); break;}
+    case 4:
+      {SumOrders<4>(an, bn, x, y, bx, by); break;}
+    default:
+      {SumOrders(maximumNonZeroOrder, an, bn, x, y, bx, by); break;}
     }
 
-  G4ThreeVector cartesianField;
-  cartesianField[0] = (br * std::cos(phi) - bphi * std::sin(phi)); // B_x
-  cartesianField[1] = (br * std::sin(phi) + bphi * std::cos(phi)); // B_y
-  cartesianField[2] = 0;                                           // B_z
-
-  return cartesianField;
+  return G4ThreeVector(bx, by, 0);
 }
 
-
-
+void BDSFieldMagMultipole::SumOrders(G4int           n,
+                                     const G4double* an,
+                                     const G4double* bn,
+                                     G4double        x,
+                                     G4double        y,
+                                     G4double&       bx,
+                                     G4double&       by)
+{
+  G4double re = x; // z^1
+  G4double im = y;
+  for (G4int i = 0; i < n; i++)
+    {
+      bx += an[i]*im - bn[i]*re;
+      by += an[i]*re + bn[i]*im;
+      G4double reNext = re*x - im*y;
+      im = re*y + im*x;
+      re = reNext;
+    }
+}
@@ -28,6 +28,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "CLHEP/Units/PhysicalConstants.h"
 
 #include <cmath>
+#include <cstddef>
 #include <vector>
 
 BDSFieldMagMultipoleOuter::BDSFieldMagMultipoleOuter(G4int              orderIn,
@@ -39,6 +40,7 @@ BDSFieldMagMultipoleOuter::BDSFieldMagMultipoleOuter(G4int              orderIn,
   order(orderIn),
   phiOffset(0),
   spatialLimit(1),
+  spatialLimitSq(1),
   normalisation(1), // we have to get field first to calculate the normalisation which uses it, so start with 1
   positiveField(kPositive),
   poleNOffset(0),
@@ -79,6 +81,8 @@ BDSFieldMagMultipoleOuter::BDSFieldMagMultipoleOuter(G4int              orderIn,
       G4TwoVector c = firstCurrent; // copy it
       c.rotate(phiOffset + (G4double)i*CLHEP::twopi / nPoles); // rotate copy
       currents.push_back(c);
+      // alternating sign of each current, i.e. (-1)^(pole + poleNOffset) with pole from 1
+      currentSigns.push_back((i + 1 + poleNOffset) % 2 == 0 ? 1.0 : -1.0);
     }
 
   // work out a radial extent close to a current source where we artificially saturate
@@ -89,6 +93,7 @@ BDSFieldMagMultipoleOuter::BDSFieldMagMultipoleOuter(G4int              orderIn,
   G4double interPoleDistance = (pointB - pointA).mag();
   // arbitrary -> let's say 5% of the distance between poles for saturation
   spatialLimit = 0.05*interPoleDistance;
+  spatialLimitSq = spatialLimit*spatialLimit;
 
   // query inner field at pole tip radius
   // choose a point to query carefully though
@@ -136,35 +141,31 @@ G4ThreeVector BDSFieldMagMultipoleOuter::GetField(const G4ThreeVector& position,
   // temporary variables
   G4TwoVector result;
   G4TwoVector cToPos;
-  G4double cToPosMag  = 0;
-  G4double reciprocal = 0;
-  G4TwoVector cToPosPerp;
+  G4double cToPosMagSq = 0;
 
   // loop over linear sum from all infinite wire sources
-  G4int pole = 1; // counter
+  // each contributes sign * perpendicular unit vector / distance = sign * perpendicular / distance^2
+  // so no square root is required except close to a pole
   G4bool closeToPole = false;
-  for (const auto& c : currents)
+  const std::size_t nCurrents = currents.size();
+  for (std::size_t i = 0; i < nCurrents; i++)
     {
-      cToPos    = pos - c; // distance to this wire
-      cToPosMag = cToPos.mag();
-      if (cToPosMag < spatialLimit)
+      const G4TwoVector& c = currents[i];
+      cToPos      = pos - c; // distance to this wire
+      cToPosMagSq = cToPos.mag2();
+      if (cToPosMagSq < spatialLimitSq)
 	{// we're close to a pole
 	  // for the contribution from this pole, resample at spatial limit r
 	  // from the current point - will give same direction
 	  pos += cToPos.unit() * spatialLimit;
 	  cToPos      = pos - c;
-	  cToPosMag   = cToPos.mag();
+	  cToPosMagSq = cToPos.mag2();
 	  closeToPole = true;
 	}
       
-      reciprocal = 1/cToPosMag;
-      if (!std::isnormal(reciprocal))
-	{reciprocal = 1.0;} // protect against bad values
-      cToPosPerp = G4TwoVector(-cToPos.y(), cToPos.x());
-      G4TwoVector val = std::pow(-1, pole+poleNOffset)*cToPosPerp.unit() * reciprocal;
-      if (std::isfinite(val.x()) && std::isfinite(val.y())) // tolerate bad values
-	{result += val;}
-      pole++;
+      G4double factor = currentSigns[i] / cToPosMagSq;
+      if (std::isfinite(factor)) // tolerate bad values
+	{result += factor * G4TwoVector(-cToPos.y(), cToPos.x());}
     }
 
   // get sign right to match convention
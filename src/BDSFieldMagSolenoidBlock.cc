@@ -34,8 +34,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <memory>
 
 BDSFieldMagSolenoidBlock::BDSFieldMagSolenoidBlock(BDSMagnetStrength const* strength,
-                                                   G4double innerRadiusIn):
-  BDSFieldMagSolenoidBlock((*strength)["field"], false, innerRadiusIn, (*strength)["coilRadialThickness"], (*strength)["length"], 0, 1)
+                                                   G4double innerRadiusIn,
+                                                   G4double specialFunctionTolerance):
+  BDSFieldMagSolenoidBlock((*strength)["field"], false, innerRadiusIn, (*strength)["coilRadialThickness"], (*strength)["length"], 0, 1,
+                           specialFunctionTolerance)
 {;}
 
 
@@ -45,7 +47,8 @@ BDSFieldMagSolenoidBlock::BDSFieldMagSolenoidBlock(G4double strength,
                                                    G4double radialThicknessIn,
                                                    G4double fullLengthZIn,
                                                    G4double toleranceIn,
-                                                   G4int    nSheetsIn):
+                                                   G4int    nSheetsIn,
+                                                   G4double specialFunctionTolerance):
   a(innerRadiusIn),
   radialThickness(radialThicknessIn),
   fullLengthZ(fullLengthZIn),
@@ -70,6 +73,16 @@ BDSFieldMagSolenoidBlock::BDSFieldMagSolenoidBlock(G4double strength,
     }
   currentDensity = I*radialThickness*fullLengthZ/nSheetsBlock; // Current density in A/m^2 (TODO:Check)
 
+  G4double dr = radialThickness/nSheetsBlock;
+  for (G4int sheet = 0; sheet < nSheetsBlock; sheet++)
+    {
+      sheets.emplace_back(new BDSFieldMagSolenoidSheet(currentDensity,
+                                                       true,
+                                                       a+(sheet*dr) + dr/2,
+                                                       fullLengthZ,
+                                                       coilTolerance,
+                                                       specialFunctionTolerance));
+    }
 }
 
 G4ThreeVector BDSFieldMagSolenoidBlock::GetField(const G4ThreeVector& position,
@@ -78,17 +91,10 @@ G4ThreeVector BDSFieldMagSolenoidBlock::GetField(const G4ThreeVector& position,
   //G4double z = position.z();
   //G4double rho = position.perp();
   //G4double phi = position.phi(); // angle about z axis
-  std::unique_ptr<BDSFieldMag> field;
   G4ThreeVector blockField = G4ThreeVector(0,0,0);
   G4ThreeVector sheetField;
-  double dr = radialThickness/nSheetsBlock;
-  for (int sheet = 0; sheet < nSheetsBlock; sheet++)
+  for (const auto& field : sheets)
           { 
-            field = std::make_unique<BDSFieldMagSolenoidSheet>(currentDensity,
-                                                               true,
-                                                               a+(sheet*dr) + dr/2,
-                                                               fullLengthZ,
-                                                               coilTolerance);
             sheetField = field->GetField(position);
             if (sheetField == G4ThreeVector(0,0,0))
               {
@@ -102,3 +108,10 @@ G4ThreeVector BDSFieldMagSolenoidBlock::GetField(const G4ThreeVector& position,
           }
   return blockField;
 }
+
+G4double BDSFieldMagSolenoidBlock::LocalZHalfExtent() const
+{
+  if (sheets.empty())
+    {return 0;}
+  return sheets.front()->LocalZHalfExtent();
+}
@@ -20,6 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSFieldMagSolenoidSheet.hh"
 #include "BDSMagnetStrength.hh"
 #include "BDSSpecialFunctions.hh"
+#include "BDSSpecialFunctionTable.hh"
 #include "BDSUtilities.hh"
 
 #include "G4ThreeVector.hh"
@@ -30,17 +31,21 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 BDSFieldMagSolenoidSheet::BDSFieldMagSolenoidSheet(BDSMagnetStrength const* strength,
-                                                   G4double radiusIn, G4double toleranceIn):
-  BDSFieldMagSolenoidSheet((*strength)["field"], false, radiusIn, (*strength)["length"], toleranceIn)
+                                                   G4double radiusIn, G4double toleranceIn,
+                                                   G4double specialFunctionTolerance):
+  BDSFieldMagSolenoidSheet((*strength)["field"], false, radiusIn, (*strength)["length"], toleranceIn,
+                           specialFunctionTolerance)
 {;}
 
 BDSFieldMagSolenoidSheet::BDSFieldMagSolenoidSheet(G4double strength,
                                                    G4bool   strengthIsCurrent,
                                                    G4double sheetRadius,
                                                    G4double fullLength,
-                                                   G4double toleranceIn
+                                                   G4double toleranceIn,
+                                                   G4double specialFunctionTolerance
                                                    ):
   a(sheetRadius),
   halfLength(0.5*fullLength),
@@ -48,8 +53,12 @@ BDSFieldMagSolenoidSheet::BDSFieldMagSolenoidSheet(G4double strength,
   I(0.0),
   spatialLimit(std::min(1e-5*sheetRadius, 1e-5*fullLength)),
   normalisation(1.0) ,
-  coilTolerance(toleranceIn)
+  coilTolerance(toleranceIn),
+  celRadialTable(nullptr),
+  zHalfExtent(std::numeric_limits<G4double>::max())
 {
+  if (specialFunctionTolerance > 0)
+    {celRadialTable = BDS::CELRadialTable(specialFunctionTolerance);}
   finiteStrength = BDS::IsFinite(std::abs(strength));
   // apply relationship B0 = mu_0 I / 2 a for on-axis rho=0,z=0
   if (strengthIsCurrent)
@@ -68,6 +77,50 @@ BDSFieldMagSolenoidSheet::BDSFieldMagSolenoidSheet(G4double strength,
   // cylinder sheet. So we evaluate it here then normalise. ~<1% adjustment in magnitude.
   //G4double testBz = OnAxisBz(halfLength, -halfLength);
   //normalisation = B0 / testBz;
+
+  zHalfExtent = CalculateZHalfExtent();
+}
+
+G4double BDSFieldMagSolenoidSheet::CalculateZHalfExtent() const
+{
+  // GetField returns 0 wherever the on axis field is below coilTolerance
+  if (!(coilTolerance > 0))
+    {return std::numeric_limits<G4double>::max();}
+
+  // the on axis field is symmetric in z and falls monotonically from the centre
+  auto onAxis = [this](G4double z){return std::abs(OnAxisBz(z + halfLength, z - halfLength));};
+  if (onAxis(0) < coilTolerance)
+    {return 0;}
+
+  // bracket the point then bisect - zHigh is always beyond it
+  G4double zLow  = 0;
+  G4double zHigh = std::max(halfLength, a);
+  G4int nDoublings = 0;
+  while (onAxis(zHigh) >= coilTolerance)
+    {
+      zLow = zHigh;
+      zHigh *= 2;
+      nDoublings++;
+      if (nDoublings > 200)
+        {return std::numeric_limits<G4double>::max();}
+    }
+  for (G4int i = 0; i < 100; i++)
+    {
+      G4double zMid = 0.5*(zLow + zHigh);
+      if (onAxis(zMid) >= coilTolerance)
+        {zLow = zMid;}
+      else
+        {zHigh = zMid;}
+    }
+  return zHigh;
+}
+
+G4double BDSFieldMagSolenoidSheet::CELRadial(G4double kc) const
+{
+  if (celRadialTable && celRadialTable->InRange(kc))
+    {return (*celRadialTable)(kc);}
+  else
+    {return BDS::CEL(kc, 1, 1, -1);}
 }
 
 G4ThreeVector BDSFieldMagSolenoidSheet::GetField(const G4ThreeVector& position,
@@ -124,7 +177,7 @@ G4ThreeVector BDSFieldMagSolenoidSheet::GetField(const G4ThreeVector& position,
       G4double kp = std::sqrt(zpSq + aMinusRhoSq) / denominatorP;
       G4double km = std::sqrt(zmSq + aMinusRhoSq) / denominatorM;
       
-      Brho = B0 * (alphap * BDS::CEL(kp, 1, 1, -1) - alpham * BDS::CEL(km, 1, 1, -1));
+      Brho = B0 * (alphap * CELRadial(kp) - alpham * CELRadial(km));
       Bz = ((B0 * a) / (rhoPlusA)) * (betap * BDS::CEL(kp, gammaSq, 1, gamma) - betam * BDS::CEL(km, gammaSq, 1, gamma));
       // technically possible for integral to return nan, so protect against it and default to B0 along z
       if (std::isnan(Brho))
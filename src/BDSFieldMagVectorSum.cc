@@ -24,6 +24,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
 
+#include <cmath>
+#include <cstddef>
 #include <vector>
 
 BDSFieldMagVectorSum::BDSFieldMagVectorSum(const std::vector<BDSFieldMag*>& fieldsIn,
@@ -33,6 +35,14 @@ BDSFieldMagVectorSum::BDSFieldMagVectorSum(const std::vector<BDSFieldMag*>& fiel
 {
   if (fields.size() != fieldOffsets.size())
     {throw BDSException(__METHOD_NAME__, "number of fields and number of offsets do not match");}
+
+  std::vector<G4double> zCentres;
+  for (std::size_t i = 0; i < fields.size(); i++)
+    {
+      zCentres.push_back(fieldOffsets[i].z());
+      zHalfExtents.push_back(fields[i]->LocalZHalfExtent());
+    }
+  zIndex.Build(zCentres, zHalfExtents);
 }
 
 BDSFieldMagVectorSum::~BDSFieldMagVectorSum()
@@ -45,11 +55,13 @@ G4ThreeVector BDSFieldMagVectorSum::GetField(const G4ThreeVector& position,
                                              const G4double       t) const
 {
   G4ThreeVector result;
-  for (G4int i = 0; i < (G4int)fields.size(); i++)
-    {
-      G4ThreeVector p = position - fieldOffsets[i];
-      G4ThreeVector v = fields[i]->GetField(p,t);
-      result += v;
-    }
+  zIndex.ForEachCandidate(position.z(), [&](std::size_t i)
+  {
+    G4ThreeVector p = position - fieldOffsets[i];
+    if (std::abs(p.z()) > zHalfExtents[i])
+      {return;} // field is zero here
+    G4ThreeVector v = fields[i]->GetField(p,t);
+    result += v;
+  });
   return result;
 }
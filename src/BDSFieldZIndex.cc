@@ -0,0 +1,69 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSFieldZIndex.hh"
+
+#include "G4Types.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+BDSFieldZIndex::BDSFieldZIndex():
+  nFields(0),
+  maximumLength(0)
+{;}
+
+void BDSFieldZIndex::Build(const std::vector<G4double>& zCentres,
+                           const std::vector<G4double>& zHalfLengths)
+{
+  if (zCentres.size() != zHalfLengths.size())
+    {throw BDSException(__METHOD_NAME__, "number of centres and half lengths do not match");}
+
+  nFields = zCentres.size();
+  maximumLength = 0;
+  zLow.clear();
+  zHigh.clear();
+  fieldIndex.clear();
+  unbounded.clear();
+
+  std::vector<std::size_t> order;
+  for (std::size_t i = 0; i < nFields; i++)
+    {
+      G4double halfLength = std::abs(zHalfLengths[i]);
+      if (!std::isfinite(halfLength) || halfLength >= 0.5*std::numeric_limits<G4double>::max())
+        {unbounded.push_back(i);}
+      else
+        {order.push_back(i);}
+    }
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+            {return zCentres[a] - std::abs(zHalfLengths[a]) < zCentres[b] - std::abs(zHalfLengths[b]);});
+
+  for (auto i : order)
+    {
+      G4double halfLength = std::abs(zHalfLengths[i]);
+      zLow.push_back(zCentres[i] - halfLength);
+      zHigh.push_back(zCentres[i] + halfLength);
+      fieldIndex.push_back(i);
+      maximumLength = std::max(maximumLength, 2*halfLength);
+    }
+}
@@ -128,6 +128,8 @@ BDSGlobalConstants::BDSGlobalConstants(const GMAD::Options& opt):
   InitDefaultUserLimits();
 
   integratorSet = BDS::DetermineIntegratorSetType(options.integratorSet);
+  fieldMapStorageType = BDS::DetermineArrayStorageType(options.fieldMapStorageType);
+  fieldMapLayout      = BDS::DetermineArrayLayoutType(options.fieldMapLayout);
 
   InitialiseBeamlineTransform();
   
@@ -150,6 +152,13 @@ BDSGlobalConstants::BDSGlobalConstants(const GMAD::Options& opt):
   trajectoryFiltersSet[BDSTrajectoryFilter::maximumR]        = options.HasBeenSet("trajCutLTR");
   trajectoryFiltersSet[BDSTrajectoryFilter::secondary]       = options.HasBeenSet("storeTrajectorySecondaryParticles");
 
+  if (TrackPrimariesOnly())
+    {// secondaries are stopped and only primary hits and sampler data are stored
+      G4cout << "\nGlobal option> tracking primaries only\n" << G4endl;
+      options.stopSecondaries  = true;
+      options.storeMinimalData = true;
+    }
+
   if (StoreMinimalData())
     {
       G4cout << "\nGlobal option> storing minimal data\n" << G4endl;
@@ -25,6 +25,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <csignal>
 #include <cstdlib>
 #include <cstdio>
+#include <vector>
 
 #include "G4EventManager.hh" // Geant4 includes
 #include "G4GenericBiasingPhysics.hh"
@@ -40,6 +41,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include "TROOT.h"
+
 #include "BDSAcceleratorModel.hh"
 #include "BDSAperturePointsLoader.hh"
 #include "BDSBeamPipeFactory.hh"
@@ -51,6 +54,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSDetectorConstruction.hh"
 #include "BDSEventAction.hh"
+#include "BDSEventBudget.hh"
+#include "BDSEventProfiler.hh"
 #include "BDSException.hh"
 #include "BDSFieldFactory.hh"
 #include "BDSFieldLoader.hh"
@@ -61,23 +66,30 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSMaterials.hh"
 #include "BDSOutput.hh"
 #include "BDSOutputFactory.hh"
+#include "BDSParallelWorldImportance.hh"
 #include "BDSParallelWorldUtilities.hh"
 #include "BDSParser.hh" // Parser
+#include "BDSParticleCoordsFullGlobal.hh"
 #include "BDSParticleDefinition.hh"
+#include "BDSPhysicsTableCache.hh"
 #include "BDSPhysicsUtilities.hh"
 #include "BDSPrimaryGeneratorAction.hh"
 #include "BDSRandom.hh" // for random number generator from CLHEP
 #include "BDSRunAction.hh"
 #include "BDSRunManager.hh"
 #include "BDSSamplerRegistry.hh"
+#include "BDSScorerMeshInfo.hh"
 #include "BDSSDManager.hh"
 #include "BDSSteppingAction.hh"
 #include "BDSStackingAction.hh"
 #include "BDSTemporaryFiles.hh"
+#include "BDSTrackKillRules.hh"
 #include "BDSTrackingAction.hh"
+#include "BDSTrackingActionPrimaryOnly.hh"
 #include "BDSUtilities.hh"
 #include "BDSVisManager.hh"
 #include "BDSWarning.hh"
+#include "BDSWeightWindowMesh.hh"
 
 BDSIM::BDSIM():
   ignoreSIGINT(false),
@@ -92,7 +104,13 @@ BDSIM::BDSIM():
   runManager(nullptr),
   userComponentFactory(nullptr),
   userPhysicsList(nullptr),
-  realWorld(nullptr)
+  realWorld(nullptr),
+  physicsTableCache(nullptr),
+  importanceWorld(nullptr),
+  weightWindows(nullptr),
+  killRules(nullptr),
+  eventBudget(nullptr),
+  eventProfiler(nullptr)
 {;}
 
 BDSIM::BDSIM(int argc, char** argv, bool usualPrintOutIn):
@@ -108,7 +126,13 @@ BDSIM::BDSIM(int argc, char** argv, bool usualPrintOutIn):
   runManager(nullptr),
   userComponentFactory(nullptr),
   userPhysicsList(nullptr),
-  realWorld(nullptr)
+  realWorld(nullptr),
+  physicsTableCache(nullptr),
+  importanceWorld(nullptr),
+  weightWindows(nullptr),
+  killRules(nullptr),
+  eventBudget(nullptr),
+  eventProfiler(nullptr)
 {
   initialisationResult = Initialise();
 }
@@ -158,6 +182,11 @@ int BDSIM::Initialise()
   BDSRandom::CreateRandomNumberGenerator(globals->RandomEngine());
   BDSRandom::SetSeed(); // set the seed from options
 
+  /// Prefetching sampler events reads a ROOT file on a separate thread, so ROOT must
+  /// be made thread safe before any ROOT file is opened.
+  if (parser->GetBeam().eventGeneratorPrefetchNEvents > 0)
+    {ROOT::EnableThreadSafety();}
+
   /// Construct output
   bdsOutput = BDSOutputFactory::CreateOutput(globals->OutputFormat(),
                                              globals->OutputFileName());
@@ -247,6 +276,7 @@ int BDSIM::Initialise()
   
   // Muon splitting - optional - should be done *after* biasing to work with it - TBC it's before...
   BDS::BuildMuonBiasing(physList);
+  BDS::BuildProcessSplitting(physList, parser->GetProcessSplitting());
   
   BDS::RegisterSamplerPhysics(parallelWorldPhysics, physList);
   auto biasPhysics = BDS::BuildAndAttachBiasWrapper(parser->GetBiasing());
@@ -302,23 +332,43 @@ int BDSIM::Initialise()
   G4int verboseSteppingEventStart = globals->VerboseSteppingEventStart();
   G4int verboseSteppingEventStop  = BDS::VerboseEventStop(verboseSteppingEventStart,
                                                           globals->VerboseSteppingEventContinueFor());
-  if (globals->VerboseSteppingBDSIM())
+  G4bool useKillRules = !parser->GetKillRules().empty();
+  G4bool useEventBudget = globals->MaximumStepsPerEvent() > 0 || globals->MaximumCPUTimePerEvent() > 0;
+  BDSSteppingAction* steppingAction = nullptr;
+  if (globals->VerboseSteppingBDSIM() || globals->UseWeightWindows() || useKillRules || useEventBudget
+      || globals->StoreEventProfile())
     {
-      runManager->SetUserAction(new BDSSteppingAction(true,
-                                                      verboseSteppingEventStart,
-                                                      verboseSteppingEventStop));
+      steppingAction = new BDSSteppingAction(globals->VerboseSteppingBDSIM(),
+                                             verboseSteppingEventStart,
+                                             verboseSteppingEventStop);
+      runManager->SetUserAction(steppingAction);
     }
   
-  runManager->SetUserAction(new BDSTrackingAction(globals->Batch(),
-                                                  globals->StoreTrajectory(),
-                                                  globals->StoreTrajectoryOptions(),
-                                                  eventAction,
-                                                  verboseSteppingEventStart,
-                                                  verboseSteppingEventStop,
-                                                  globals->VerboseSteppingPrimaryOnly(),
-                                                  globals->VerboseSteppingLevel()));
-
-  runManager->SetUserAction(new BDSStackingAction(globals));
+  // Minimal tracking action when only primaries are tracked unless we need trajectories or verbosity
+  if (globals->TrackPrimariesOnly() && globals->Batch() && !globals->StoreTrajectory() && globals->VerboseSteppingLevel() == 0)
+    {runManager->SetUserAction(new BDSTrackingActionPrimaryOnly(globals->StoreTrajectoryOptions(), eventAction));}
+  else
+    {
+      runManager->SetUserAction(new BDSTrackingAction(globals->Batch(),
+                                                      globals->StoreTrajectory(),
+                                                      globals->StoreTrajectoryOptions(),
+                                                      eventAction,
+                                                      verboseSteppingEventStart,
+                                                      verboseSteppingEventStop,
+                                                      globals->VerboseSteppingPrimaryOnly(),
+                                                      globals->VerboseSteppingLevel()));
+    }
+
+  BDSStackingAction* stackingAction = new BDSStackingAction(globals);
+  runManager->SetUserAction(stackingAction);
+
+  if (useEventBudget)
+    {
+      eventBudget = new BDSEventBudget(globals->MaximumStepsPerEvent(), globals->MaximumCPUTimePerEvent());
+      steppingAction->SetEventBudget(eventBudget);
+      stackingAction->SetEventBudget(eventBudget);
+      eventAction->SetEventBudget(eventBudget);
+    }
   
   auto primaryGeneratorAction = new BDSPrimaryGeneratorAction(bdsBunch, parser->GetBeam(), globals->Batch());
   // possibly updated after the primary generator as loaded a beam file
@@ -331,11 +381,59 @@ int BDSIM::Initialise()
 
   /// Create importance store for parallel importance world
   if (globals->UseImportanceSampling())
-    {BDS::AddIStore(parallelWorldsRequiringPhysics);}
+    {
+      BDS::AddIStore(parallelWorldsRequiringPhysics);
+      importanceWorld = BDS::GetImportanceSamplingWorld(parallelWorldsRequiringPhysics);
+    }
+
+  /// Weight windows are placed w.r.t. the beam line so can only be built after it is constructed
+  if (globals->UseWeightWindows())
+    {
+      G4String meshName = globals->WeightWindowMesh();
+      const auto& meshes = parser->GetScorerMesh();
+      auto mesh = std::find_if(meshes.begin(), meshes.end(),
+                               [&meshName](const GMAD::ScorerMesh& m){return m.name == meshName;});
+      if (mesh == meshes.end())
+        {throw BDSException(__METHOD_NAME__, "weightWindowMesh \"" + meshName + "\" is not a defined scorermesh");}
+      G4Transform3D placement = BDSDetectorConstruction::CreatePlacementTransform(*mesh, BDSAcceleratorModel::Instance()->BeamlineMain());
+      weightWindows = new BDSWeightWindowMesh(BDSScorerMeshInfo(*mesh),
+                                              placement,
+                                              globals->WeightWindowFile(),
+                                              globals->WeightWindowUpperRatio(),
+                                              globals->WeightWindowSurvivalRatio(),
+                                              globals->WeightWindowMaximumSplit());
+      steppingAction->SetWeightWindows(weightWindows);
+      stackingAction->SetWeightWindows(weightWindows);
+    }
+
+  /// Kill rules refer to regions so are built after the geometry
+  if (useKillRules)
+    {
+      killRules = new BDSTrackKillRules(parser->GetKillRules());
+      steppingAction->SetKillRules(killRules);
+      stackingAction->SetKillRules(killRules);
+    }
+
+  /// The profiler makes bins for all logical volumes and particles so is built after initialisation
+  if (globals->StoreEventProfile())
+    {
+      eventProfiler = new BDSEventProfiler();
+      steppingAction->SetEventProfiler(eventProfiler);
+      eventAction->SetEventProfiler(eventProfiler);
+      bdsOutput->SetEventProfiler(eventProfiler);
+    }
 
   /// Implement bias operations on all volumes only after G4RunManager::Initialize()
   realWorld->BuildPhysicsBias();
 
+  /// Optionally retrieve the physics tables from a previous run with identical physics,
+  /// materials and cuts. They're built at the start of the first run so this must be before.
+  if (!globals->PhysicsTableCacheDir().empty())
+    {
+      physicsTableCache = new BDSPhysicsTableCache(globals->PhysicsTableCacheDir(), physList);
+      physicsTableCache->Prepare();
+    }
+
   if (usualPrintOut && globals->PhysicsVerbose())
     {
       BDS::PrintPrimaryParticleProcesses(bdsBunch->ParticleDefinition()->Name());
@@ -402,6 +500,12 @@ void BDSIM::BeamOn(int nGenerate)
             {runManager->BeamOn(BDSGlobalConstants::Instance()->NGenerate());}
           else
             {runManager->BeamOn(nGenerate);}
+          if (physicsTableCache) // tables are now built
+            {physicsTableCache->StoreIfRequired();}
+          if (importanceWorld) // only writes if this is a pilot run
+            {importanceWorld->WriteImportanceMap();}
+          if (killRules)
+            {killRules->PrintSummary();}
         }
     }
   catch (const BDSException& exception)
@@ -447,7 +551,12 @@ BDSIM::~BDSIM()
   catch (...)
     {;} // ignore any exception as this is a destructor
   
+  delete physicsTableCache;
   delete runManager;
+  delete weightWindows;
+  delete killRules;
+  delete eventBudget;
+  delete eventProfiler;
   delete bdsBunch;
   delete parser;
 
@@ -475,14 +584,33 @@ void BDSIM::GeneratePrimariesOnly(const BDSGlobalConstants* globals)
   const G4int printModulo = globals->PrintModuloEvents();
   bdsBunch->BeginOfRunAction(nToGenerate, globals->Batch());
   auto flagsCache(G4cout.flags());
-  for (G4int i = 0; i < nToGenerate; i++)
-    {
-      if (i%printModulo == 0)
-        {G4cout << "\r Primary> " << std::fixed << i << " of " << nToGenerate << G4endl;}
-      BDSParticleCoordsFullGlobal coords = bdsBunch->GetNextParticleValid();
-      // always pull particle definition in case it's updated
+  if (bdsBunch->CanGenerateInBatches())
+    {// generate and write in large chunks - gives identical coordinates
+      const G4int chunkSize = 100000;
+      std::vector<BDSParticleCoordsFullGlobal> chunk;
+      chunk.reserve((std::size_t)std::min(chunkSize, std::max(nToGenerate, 0)));
       const BDSParticleDefinition* pDef = bdsBunch->ParticleDefinition();
-      bdsOutput->FillEventPrimaryOnly(coords, pDef);
+      for (G4int i = 0; i < nToGenerate; i += chunkSize)
+        {
+          G4int nThisChunk = std::min(chunkSize, nToGenerate - i);
+          for (G4int j = i + (printModulo - i%printModulo)%printModulo; j < i + nThisChunk; j += printModulo)
+            {G4cout << "\r Primary> " << std::fixed << j << " of " << nToGenerate << G4endl;}
+          chunk.clear();
+          bdsBunch->GetNextParticlesValid(nThisChunk, chunk);
+          bdsOutput->FillEventsPrimaryOnly(chunk, pDef);
+        }
+    }
+  else
+    {
+      for (G4int i = 0; i < nToGenerate; i++)
+        {
+          if (i%printModulo == 0)
+            {G4cout << "\r Primary> " << std::fixed << i << " of " << nToGenerate << G4endl;}
+          BDSParticleCoordsFullGlobal coords = bdsBunch->GetNextParticleValid();
+          // always pull particle definition in case it's updated
+          const BDSParticleDefinition* pDef = bdsBunch->ParticleDefinition();
+          bdsOutput->FillEventPrimaryOnly(coords, pDef);
+        }
     }
   G4cout.flags(flagsCache); // restore cout flags
   // Write options now the file is open
@@ -69,6 +69,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSUtilities.hh"
 #include "BDSVisManager.hh"
 
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
 #include <map>
 #include <set>
 
@@ -86,6 +89,7 @@ BDSIMLink::BDSIMLink(BDSBunch* bunchIn):
   construction(nullptr),
   runAction(nullptr),
   currentElementIndex(0),
+  addingLinkElements(false),
   userPhysicsList(nullptr)
 {;}
 
@@ -103,6 +107,7 @@ BDSIMLink::BDSIMLink(int argc, char** argv, bool usualPrintOutIn):
   construction(nullptr),
   runAction(nullptr),
   currentElementIndex(0),
+  addingLinkElements(false),
   userPhysicsList(nullptr)
 {
   initialisationResult = Initialise();
@@ -354,6 +359,9 @@ void BDSIMLink::BeamOn(int nGenerate)
   if (initialisationResult > 1 || !initialised)
     {return;} // a mode where we don't do anything
 
+  if (addingLinkElements)
+    {EndLinkElements();}
+
   G4cout.precision(10);
   /// Catch aborts to close output stream/file. perhaps not all are needed.
   struct sigaction act;
@@ -503,6 +511,31 @@ void BDSIMLink::SelectLinkElement(int index, G4bool debug)
   currentElementIndex = index;
 }
 
+void BDSIMLink::BeginLinkElements()
+{
+  if (addingLinkElements)
+    {return;}
+  G4GeometryManager* gm = G4GeometryManager::GetInstance();
+  if (gm->IsGeometryClosed())
+    {gm->OpenGeometry();}
+  addingLinkElements = true;
+}
+
+void BDSIMLink::EndLinkElements()
+{
+  if (!addingLinkElements)
+    {return;}
+  addingLinkElements = false;
+  
+  if (bdsOutput)
+    {bdsOutput->UpdateSamplers();}
+
+  /// Close the geometry in preparation for running - everything is now fixed.
+  G4bool bCloseGeometry = G4GeometryManager::GetInstance()->CloseGeometry();
+  if (!bCloseGeometry)
+    {throw BDSException(__METHOD_NAME__, "error - geometry not closed.");}
+}
+
 int BDSIMLink::AddLinkCollimatorJaw(const std::string& collimatorName,
 				     const std::string& materialName,
 				     double length,
@@ -520,7 +553,7 @@ int BDSIMLink::AddLinkCollimatorJaw(const std::string& collimatorName,
 				     bool   sampleIn)
 {
   G4GeometryManager* gm = G4GeometryManager::GetInstance();
-  if (gm->IsGeometryClosed())
+  if (!addingLinkElements && gm->IsGeometryClosed())
     {gm->OpenGeometry();}
 
   G4int linkID = construction->AddLinkCollimatorJaw(collimatorName,
@@ -541,6 +574,9 @@ int BDSIMLink::AddLinkCollimatorJaw(const std::string& collimatorName,
   // update this class's nameToElementIndex map
   nameToElementIndex = construction->NameToElementIndex();
   linkIDToBeamlineIndex = construction->LinkIDToBeamlineIndex();
+
+  if (addingLinkElements)
+    {return (int)linkID;} // output and geometry are updated once in EndLinkElements
   
   if (bdsOutput)
     {bdsOutput->UpdateSamplers();}
@@ -557,6 +593,36 @@ BDSHitsCollectionSamplerLink* BDSIMLink::SamplerHits() const
   return runAction ? runAction->SamplerHits() : nullptr;
 }
 
+int BDSIMLink::FillParticleArrays(BDSLinkParticlesOut& out) const
+{
+  const BDSHitsCollectionSamplerLink* hits = SamplerHits();
+  if (!hits)
+    {return 0;}
+  const auto hitVector = hits->GetVector();
+  int nHits = (int)hitVector->size();
+  int nToWrite = std::min(nHits, std::max(out.capacity, 0));
+  for (int i = 0; i < nToWrite; i++)
+    {
+      const BDSHitSamplerLink* hit = (*hitVector)[i];
+      const BDSParticleCoordsFull& c = hit->coords;
+      if (out.x)           {out.x[i]           = c.x / CLHEP::m;}
+      if (out.y)           {out.y[i]           = c.y / CLHEP::m;}
+      if (out.xp)          {out.xp[i]          = c.xp;}
+      if (out.yp)          {out.yp[i]          = c.yp;}
+      if (out.totalEnergy) {out.totalEnergy[i] = c.totalEnergy / CLHEP::GeV;}
+      if (out.t)           {out.t[i]           = c.T / CLHEP::s;}
+      if (out.weight)      {out.weight[i]      = c.weight;}
+      if (out.mass)        {out.mass[i]        = hit->mass / CLHEP::GeV;}
+      if (out.pdgID)       {out.pdgID[i]       = (int32_t)hit->pdgID;}
+      if (out.Z)           {out.Z[i]           = (int16_t)hit->Z;}
+      if (out.A)           {out.A[i]           = (int16_t)hit->A;}
+      if (out.charge)      {out.charge[i]      = (int16_t)hit->charge;}
+      if (out.particleID)  {out.particleID[i]  = (int32_t)hit->externalParticleID;}
+      if (out.parentID)    {out.parentID[i]    = (int32_t)hit->externalParentID;}
+    }
+  return nHits;
+}
+
 int BDSIMLink::GetCurrentMaximumSixTrackParticleID() const
 {
   return runAction ? runAction->MaximumExternalParticleID() : 0;
@@ -0,0 +1,177 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSBunchSixTrackLink.hh"
+#include "BDSIMLink.hh"
+#include "BDSIMLinkCAPI.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+/// The bunch and link instance behind the opaque C handle.
+struct BDSIMLinkHandle
+{
+  BDSBunchSixTrackLink* bunch;
+  BDSIMLink*            link;
+};
+
+namespace
+{
+  /// Report an exception in the C interface as it can't be thrown to the caller.
+  void ReportError(const std::string& functionName, const std::exception& exception)
+  {std::cerr << functionName << "> " << exception.what() << std::endl;}
+}
+
+extern "C"
+BDSIMLinkHandle* bdsim_link_create(int    argc,
+                                   char** argv,
+                                   double minimumKineticEnergy,
+                                   int    protonsAndIonsOnly)
+{
+  BDSIMLinkHandle* handle = new BDSIMLinkHandle();
+  handle->bunch = new BDSBunchSixTrackLink();
+  handle->link  = new BDSIMLink(handle->bunch);
+  try
+    {
+      handle->link->Initialise(argc, argv, true, minimumKineticEnergy, protonsAndIonsOnly != 0);
+      if (handle->link->Initialised())
+        {return handle;}
+      std::cerr << "bdsim_link_create> initialisation failed" << std::endl;
+    }
+  catch (const std::exception& exception)
+    {ReportError("bdsim_link_create", exception);}
+  bdsim_link_destroy(handle);
+  return nullptr;
+}
+
+extern "C"
+void bdsim_link_destroy(BDSIMLinkHandle* handle)
+{
+  if (!handle)
+    {return;}
+  delete handle->link;
+  delete handle->bunch;
+  delete handle;
+}
+
+extern "C"
+int bdsim_link_begin_elements(BDSIMLinkHandle* handle)
+{
+  if (!handle)
+    {return -1;}
+  handle->link->BeginLinkElements();
+  return 0;
+}
+
+extern "C"
+int bdsim_link_end_elements(BDSIMLinkHandle* handle)
+{
+  if (!handle)
+    {return -1;}
+  try
+    {handle->link->EndLinkElements();}
+  catch (const std::exception& exception)
+    {ReportError("bdsim_link_end_elements", exception); return -1;}
+  return 0;
+}
+
+extern "C"
+int bdsim_link_add_collimator_jaw(BDSIMLinkHandle* handle,
+                                  const char*      collimatorName,
+                                  const char*      materialName,
+                                  double           length,
+                                  double           halfApertureLeft,
+                                  double           halfApertureRight,
+                                  double           rotation,
+                                  double           xOffset,
+                                  double           yOffset)
+{
+  if (!handle || !collimatorName || !materialName)
+    {return -1;}
+  try
+    {
+      return handle->link->AddLinkCollimatorJaw(std::string(collimatorName),
+                                                std::string(materialName),
+                                                length * CLHEP::m,
+                                                halfApertureLeft * CLHEP::m,
+                                                halfApertureRight * CLHEP::m,
+                                                rotation * CLHEP::rad,
+                                                xOffset * CLHEP::m,
+                                                yOffset * CLHEP::m);
+    }
+  catch (const std::exception& exception)
+    {ReportError("bdsim_link_add_collimator_jaw", exception); return -1;}
+}
+
+extern "C"
+int bdsim_link_select_element(BDSIMLinkHandle* handle, const char* elementName)
+{
+  if (!handle || !elementName)
+    {return -1;}
+  try
+    {handle->link->SelectLinkElement(std::string(elementName));}
+  catch (const std::exception& exception)
+    {ReportError("bdsim_link_select_element", exception); return -1;}
+  return 0;
+}
+
+extern "C"
+int bdsim_link_select_element_index(BDSIMLinkHandle* handle, int index)
+{
+  if (!handle)
+    {return -1;}
+  try
+    {handle->link->SelectLinkElement(index);}
+  catch (const std::exception& exception)
+    {ReportError("bdsim_link_select_element_index", exception); return -1;}
+  return 0;
+}
+
+extern "C"
+int bdsim_link_track(BDSIMLinkHandle*          handle,
+                     const BDSLinkParticlesIn* in,
+                     BDSLinkParticlesOut*      out)
+{
+  if (!handle || !in)
+    {return -1;}
+  try
+    {
+      handle->link->ClearSamplerHits();
+      handle->bunch->ClearParticles();
+      G4int nAdded = handle->bunch->AddParticles(*in);
+      if (nAdded > 0)
+        {handle->link->BeamOn(nAdded);}
+      if (!out)
+        {return handle->link->SamplerHits() ? (int)handle->link->SamplerHits()->entries() : 0;}
+      return handle->link->FillParticleArrays(*out);
+    }
+  catch (const std::exception& exception)
+    {ReportError("bdsim_link_track", exception); return -1;}
+}
+
+extern "C"
+int bdsim_link_collect(BDSIMLinkHandle* handle, BDSLinkParticlesOut* out)
+{
+  if (!handle || !out)
+    {return -1;}
+  return handle->link->FillParticleArrays(*out);
+}
@@ -22,6 +22,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSBLMRegistry.hh"
 #include "BDSDebug.hh"
 #include "BDSEventInfo.hh"
+#include "BDSEventProfiler.hh"
 #include "BDSException.hh"
 #include "BDSGlobalConstants.hh"
 #include "BDSHistBinMapper.hh"
@@ -113,7 +114,8 @@ BDSOutput::BDSOutput(const G4String& baseFileNameIn,
   energyImpactingApertureKinetic(0),
   energyWorldExit(0),
   energyWorldExitKinetic(0),
-  nCollimatorsInteracted(0)
+  nCollimatorsInteracted(0),
+  eventProfiler(nullptr)
 {
   const BDSGlobalConstants* g = BDSGlobalConstants::Instance();
   numberEventPerFile = g->NumberOfEventsPerNtuple();
@@ -295,6 +297,43 @@ void BDSOutput::FillEventPrimaryOnly(const BDSParticleCoordsFullGlobal& coords,
   ClearStructuresEventLevel();
 }
 
+void BDSOutput::FillEventsPrimaryOnly(const std::vector<BDSParticleCoordsFullGlobal>& coords,
+                                      const BDSParticleDefinition*                    particle)
+{
+  G4bool isIon = particle->IsAnIon();
+  G4int  ionA  = 0;
+  G4int  ionZ  = 0;
+  if (isIon)
+    {// fill primary ion info correctly when we have no particle table available
+      ionA = particle->IonDefinition()->A();
+      ionZ = particle->IonDefinition()->Z();
+    }
+  // the particle definition is the same for all of them
+  const G4double momentum   = particle->Momentum();
+  const G4double charge     = particle->Charge();
+  const G4int    pdgID      = particle->PDGID();
+  const auto     nElectrons = particle->NElectrons();
+  const G4double mass       = particle->Mass();
+  const G4double rigidity   = particle->BRho();
+  for (const auto& c : coords)
+    {
+      primary->Fill(c.local,
+          momentum,
+          charge,
+          pdgID,
+          0, 0,
+          nElectrons,
+          mass,
+          rigidity,
+          true,
+          &isIon, &ionA, &ionZ);
+      primaryGlobal->Fill(c.global);
+      WriteFileEventLevel();
+      primary->Flush();
+      primaryGlobal->Flush();
+    }
+}
+
 void BDSOutput::FillEvent(const BDSEventInfo*                            info,
                           const G4PrimaryVertex*                         vertex,
                           const std::vector<BDSHitsCollectionSampler*>&  samplerHitsPlane,
@@ -359,6 +398,8 @@ void BDSOutput::FillEvent(const BDSEventInfo*                            info,
   if (apertureImpacts)
     {FillApertureImpacts(apertureImpactHits);}
   FillScorerHits(scorerHits); // map always exists
+  if (eventProfiler)
+    {FillEventProfile();}
 
   // we do this after energy loss and collimator hits as the energy loss
   // is integrated for putting in event info and the number of collimators
@@ -557,6 +598,31 @@ void BDSOutput::CreateHistograms()
         }
     }
 
+  if (eventProfiler)
+    {
+      const std::vector<G4String>& elementNames  = eventProfiler->ElementNames();
+      const std::vector<G4String>& volumeNames   = eventProfiler->VolumeNames();
+      const std::vector<G4String>& particleNames = eventProfiler->ParticleNames();
+      histIndices1D["ProfileStepsPerElement"]  = CreateLabelledHistogram("ProfileStepsPerElement",
+                                                                         "Steps per Element",
+                                                                         elementNames);
+      histIndices1D["ProfileTimePerElement"]   = CreateLabelledHistogram("ProfileTimePerElement",
+                                                                         "Sampled Time per Element (s)",
+                                                                         elementNames);
+      histIndices1D["ProfileStepsPerVolume"]   = CreateLabelledHistogram("ProfileStepsPerVolume",
+                                                                         "Steps per Logical Volume",
+                                                                         volumeNames);
+      histIndices1D["ProfileTimePerVolume"]    = CreateLabelledHistogram("ProfileTimePerVolume",
+                                                                         "Sampled Time per Logical Volume (s)",
+                                                                         volumeNames);
+      histIndices1D["ProfileStepsPerParticle"] = CreateLabelledHistogram("ProfileStepsPerParticle",
+                                                                         "Steps per Particle",
+                                                                         particleNames);
+      histIndices1D["ProfileTimePerParticle"]  = CreateLabelledHistogram("ProfileTimePerParticle",
+                                                                         "Sampled Time per Particle (s)",
+                                                                         particleNames);
+    }
+
   // one unique 'scorer' - single 3d histogram 3d
   if (useScoringMap && storeELossHistograms)
     {
@@ -684,6 +750,44 @@ void BDSOutput::CreateHistograms()
     }
 }
 
+G4int BDSOutput::CreateLabelledHistogram(const G4String& name,
+                                         const G4String& title,
+                                         const std::vector<G4String>& labels)
+{
+  G4int nBins = std::max(1, (G4int)labels.size());
+  G4int histIndex = Create1DHistogram(name, title, nBins, 0, nBins);
+  // the run histogram has the same index
+  for (auto hist : {evtHistos->Get1DHistogram(histIndex), runHistos->Get1DHistogram(histIndex)})
+    {
+      for (G4int i = 0; i < (G4int)labels.size(); i++)
+        {hist->GetXaxis()->SetBinLabel(i+1, labels[i].c_str());}
+    }
+  return histIndex;
+}
+
+void BDSOutput::FillEventProfile()
+{
+  FillEventProfileHistogram("ProfileStepsPerElement",  eventProfiler->PerElement().steps);
+  FillEventProfileHistogram("ProfileTimePerElement",   eventProfiler->PerElement().time);
+  FillEventProfileHistogram("ProfileStepsPerVolume",   eventProfiler->PerVolume().steps);
+  FillEventProfileHistogram("ProfileTimePerVolume",    eventProfiler->PerVolume().time);
+  FillEventProfileHistogram("ProfileStepsPerParticle", eventProfiler->PerParticle().steps);
+  FillEventProfileHistogram("ProfileTimePerParticle",  eventProfiler->PerParticle().time);
+}
+
+void BDSOutput::FillEventProfileHistogram(const G4String& histogramName,
+                                          const std::vector<G4double>& values)
+{
+  G4int histIndex = histIndices1D[histogramName];
+  for (G4int i = 0; i < (G4int)values.size(); i++)
+    {
+      if (values[i] == 0)
+        {continue;}
+      evtHistos->Fill1DHistogram(histIndex, i, values[i]);
+      runHistos->Fill1DHistogram(histIndex, i, values[i]);
+    }
+}
+
 void BDSOutput::FillEventInfo(const BDSEventInfo* info)
 {
   if (info)
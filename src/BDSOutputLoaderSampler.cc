@@ -47,6 +47,15 @@ BDSOutputLoaderSampler::BDSOutputLoaderSampler(const G4String& filePath,
   if (!search)
     {throw BDSException(__METHOD_NAME__, "no such sampler name \"" + samplerName + "\"");}
   
+  // only read the sampler we need - by default GetEntry reads every branch
+  // of the event tree which can be many times more data than the one sampler
+  eventTree->SetBranchStatus("*", false);
+  eventTree->SetBranchStatus((samplerNameLocal + "*").c_str(), true);
+  // events are mostly read sequentially so use the tree cache for read ahead
+  eventTree->SetCacheSize(30*1024*1024);
+  eventTree->AddBranchToCache((samplerNameLocal + "*").c_str(), true);
+  eventTree->StopCacheLearningPhase();
+  
   localSamplerDouble = new BDSOutputROOTEventSampler<double>();
   localSamplerFloat = new BDSOutputROOTEventSampler<float>();
   doublePrecision = localOptions->outputDoublePrecision;
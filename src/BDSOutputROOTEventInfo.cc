@@ -29,6 +29,7 @@ BDSOutputROOTEventInfo::BDSOutputROOTEventInfo():
   durationCPU(0),
   index(-1),
   aborted(false),
+  truncated(false),
   primaryHitMachine(false),
   primaryAbsorbedInCollimator(false),
   memoryUsageMb(0),
@@ -60,6 +61,7 @@ void BDSOutputROOTEventInfo::Flush()
   seedStateAtStart  = "";
   index             = -1;
   aborted           = false;
+  truncated         = false;
   primaryHitMachine = false;
   primaryAbsorbedInCollimator = false;
   memoryUsageMb         = 0;
@@ -91,6 +93,7 @@ void BDSOutputROOTEventInfo::Fill(const BDSOutputROOTEventInfo* other)
   seedStateAtStart        = other->seedStateAtStart;
   index                   = other->index;
   aborted                 = other->aborted;
+  truncated               = other->truncated;
   primaryHitMachine       = other->primaryHitMachine;
   primaryAbsorbedInCollimator = other->primaryAbsorbedInCollimator;
   memoryUsageMb           = other->memoryUsageMb;
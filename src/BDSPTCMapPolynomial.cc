@@ -0,0 +1,167 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSPTCMapPolynomial.hh"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <string>
+
+const G4int       BDSPTCMapPolynomial::nVariables;
+const std::size_t BDSPTCMapPolynomial::blockSize;
+
+BDSPTCMapPolynomial::BDSPTCMapPolynomial():
+  parent({0}),
+  variable({0}),
+  monomials(1),
+  monomialsBlock(blockSize)
+{;}
+
+void BDSPTCMapPolynomial::AddTerm(G4int output, G4double coefficient, const Exponents& exponents)
+{
+  if (output < 0 || output >= nVariables)
+    {throw BDSException(__METHOD_NAME__, "invalid output index " + std::to_string(output));}
+  for (const auto& e : exponents)
+    {
+      if (e < 0)
+        {throw BDSException(__METHOD_NAME__, "negative exponent in map term");}
+    }
+  terms[output][exponents] += coefficient;
+}
+
+void BDSPTCMapPolynomial::Compile()
+{
+  // order monomials by total order so a monomial is always after the one it's built from
+  auto totalOrder = [](const Exponents& e){return std::accumulate(e.begin(), e.end(), 0);};
+  auto byOrder = [&totalOrder](const Exponents& a, const Exponents& b)
+    {
+      G4int oa = totalOrder(a);
+      G4int ob = totalOrder(b);
+      return oa != ob ? oa < ob : a < b;
+    };
+  std::set<Exponents, decltype(byOrder)> all(byOrder);
+  all.insert(Exponents{});
+  for (const auto& outputTerms : terms)
+    {
+      for (const auto& term : outputTerms)
+        {
+          // add the monomial and every monomial in the chain used to build it: the
+          // parent of a monomial is it with the power of its first variable reduced by one
+          Exponents e = term.first;
+          while (all.insert(e).second)
+            {
+              auto first = std::find_if(e.begin(), e.end(), [](G4int v){return v > 0;});
+              (*first)--;
+            }
+        }
+    }
+
+  std::map<Exponents, G4int> index;
+  parent.clear();
+  variable.clear();
+  for (const auto& e : all)
+    {
+      G4int i = (G4int)parent.size();
+      index[e] = i;
+      if (i == 0)
+        {// the constant 1
+          parent.push_back(0);
+          variable.push_back(0);
+          continue;
+        }
+      Exponents p = e;
+      auto first = std::find_if(p.begin(), p.end(), [](G4int v){return v > 0;});
+      variable.push_back((G4int)(first - p.begin()));
+      (*first)--;
+      parent.push_back(index.at(p));
+    }
+
+  for (G4int o = 0; o < nVariables; o++)
+    {
+      compiled[o].clear();
+      for (const auto& term : terms[o])
+        {compiled[o].push_back({index.at(term.first), term.second});}
+      std::sort(compiled[o].begin(), compiled[o].end(),
+                [](const Term& a, const Term& b){return a.monomial < b.monomial;});
+    }
+
+  monomials.resize(parent.size());
+  monomialsBlock.resize(parent.size() * blockSize);
+}
+
+std::size_t BDSPTCMapPolynomial::NTerms() const
+{
+  std::size_t result = 0;
+  for (const auto& c : compiled)
+    {result += c.size();}
+  return result;
+}
+
+void BDSPTCMapPolynomial::Evaluate(const G4double in[nVariables], G4double out[nVariables]) const
+{
+  const std::size_t nMonomials = parent.size();
+  G4double* m = monomials.data();
+  m[0] = 1;
+  for (std::size_t i = 1; i < nMonomials; i++)
+    {m[i] = m[parent[i]] * in[variable[i]];}
+
+  for (G4int o = 0; o < nVariables; o++)
+    {
+      G4double result = 0;
+      for (const auto& term : compiled[o])
+        {result += term.coefficient * m[term.monomial];}
+      out[o] = result;
+    }
+}
+
+void BDSPTCMapPolynomial::Evaluate(std::size_t           n,
+                                   const G4double* const in[nVariables],
+                                   G4double* const       out[nVariables]) const
+{
+  const std::size_t nMonomials = parent.size();
+  G4double* m = monomialsBlock.data();
+  for (std::size_t start = 0; start < n; start += blockSize)
+    {
+      const std::size_t nb = std::min(blockSize, n - start);
+      std::fill(m, m + nb, 1.0);
+      for (std::size_t i = 1; i < nMonomials; i++)
+        {
+          const G4double* p = m + (std::size_t)parent[i] * blockSize;
+          const G4double* v = in[variable[i]] + start;
+          G4double*       r = m + i * blockSize;
+          for (std::size_t k = 0; k < nb; k++)
+            {r[k] = p[k] * v[k];}
+        }
+
+      for (G4int o = 0; o < nVariables; o++)
+        {
+          G4double* r = out[o] + start;
+          std::fill(r, r + nb, 0.0);
+          for (const auto& term : compiled[o])
+            {
+              const G4double  c    = term.coefficient;
+              const G4double* mono = m + (std::size_t)term.monomial * blockSize;
+              for (std::size_t k = 0; k < nb; k++)
+                {r[k] += c * mono[k];}
+            }
+        }
+    }
+}
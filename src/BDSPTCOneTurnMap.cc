@@ -29,11 +29,13 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 BDSPTCOneTurnMap::BDSPTCOneTurnMap(const G4String& maptableFile,
 				   const BDSParticleDefinition* designParticle):
@@ -78,27 +80,14 @@ BDSPTCOneTurnMap::BDSPTCOneTurnMap(const G4String& maptableFile,
       stream >> name >> coefficient >> nVector >> dimensionality >> totalOrder >>
         nx >> npx >> ny >> npy >> ndeltaP >> nt;
 
-      PTCMapTerm term{coefficient, nx, npx, ny, npy, ndeltaP};
-
-      switch (nVector)
-	{
-	case 1:
-	  {xTerms.push_back(term); break;}
-	case 2:
-	  {pxTerms.push_back(term); break;}
-	case 3:
-	  {yTerms.push_back(term);  break;}
-	case 4:
-	  {pyTerms.push_back(term); break;}
-	case 5:
-	  {deltaPTerms.push_back(term); break;}
-	default:
-	  {
-	    throw BDSException(__METHOD_NAME__, "Unrecognised PTC term index - maptable file is perhaps malformed.");
-	    break;
-	  }
-	}
+      // nVector 1 to 5 is x, px, y, py, deltaP
+      if (nVector < 1 || nVector > BDSPTCMapPolynomial::nVariables)
+	{throw BDSException(__METHOD_NAME__, "Unrecognised PTC term index - maptable file is perhaps malformed.");}
+      map.AddTerm(nVector - 1, coefficient, {nx, npx, ny, npy, ndeltaP});
     }
+  map.Compile();
+  G4cout << __METHOD_NAME__ << "Compiled map with " << map.NTerms() << " terms using "
+         << map.NMonomials() << " monomials" << G4endl;
 #ifdef BDSDEBUG
       G4cout << __METHOD_NAME__ << "> Loaded Map:" << maptableFile << G4endl;
 #endif
@@ -160,26 +149,16 @@ void BDSPTCOneTurnMap::GetThisTurn(G4double& x,
 #endif
 
       lastTurnNumber = turnsTaken;
-      xOut = Evaluate(xTerms,
-		      xLastTurn, pxLastTurn,
-		      yLastTurn, pyLastTurn,
-		      deltaPLastTurn);
-      pxOut = Evaluate(pxTerms,
-		       xLastTurn, pxLastTurn,
-		       yLastTurn, pyLastTurn,
-		       deltaPLastTurn);
-      yOut = Evaluate(yTerms,
-		      xLastTurn, pxLastTurn,
-		      yLastTurn, pyLastTurn,
-		      deltaPLastTurn);
-      pyOut = Evaluate(pyTerms,
-		       xLastTurn, pxLastTurn,
-		       yLastTurn, pyLastTurn,
-		       deltaPLastTurn);
-      deltaPOut = Evaluate(deltaPTerms,
-			   xLastTurn, pxLastTurn,
-			   yLastTurn, pyLastTurn,
-			   deltaPLastTurn);
+      const G4double in[BDSPTCMapPolynomial::nVariables] = {xLastTurn, pxLastTurn,
+                                                            yLastTurn, pyLastTurn,
+                                                            deltaPLastTurn};
+      G4double out[BDSPTCMapPolynomial::nVariables];
+      map.Evaluate(in, out);
+      xOut      = out[0];
+      pxOut     = out[1];
+      yOut      = out[2];
+      pyOut     = out[3];
+      deltaPOut = out[4];
       // Cache results for next turn.  Do it here, before we convert to BDSIM coordinates.
       xLastTurn      = xOut;
       pxLastTurn     = pxOut;
@@ -244,24 +223,24 @@ void BDSPTCOneTurnMap::GetThisTurn(G4double& x,
 #endif
 }
 
-G4double BDSPTCOneTurnMap::Evaluate(std::vector<PTCMapTerm>& terms,
-				    G4double x,
-                                    G4double px,
-				    G4double y,
-				    G4double py,
-                                    G4double deltaP) const
+void BDSPTCOneTurnMap::Apply(std::size_t n,
+			     G4double*   x,
+			     G4double*   px,
+			     G4double*   y,
+			     G4double*   py,
+			     G4double*   deltaP) const
 {
-  G4double result = 0;
-  for (const auto& term : terms)
-    {
-      result += (term.coefficient
-		 * std::pow(x, term.nx)
-		 * std::pow(px, term.npx)
-		 * std::pow(y, term.ny)
-		 * std::pow(py, term.npy)
-		 * std::pow(deltaP, term.ndeltaP));
-    }
-  return result;
+  // the outputs must not overwrite the inputs while they're still in use
+  std::vector<G4double> result(BDSPTCMapPolynomial::nVariables * n);
+  G4double* const in[BDSPTCMapPolynomial::nVariables] = {x, px, y, py, deltaP};
+  G4double* const out[BDSPTCMapPolynomial::nVariables] = {result.data(),
+                                                          result.data() + n,
+                                                          result.data() + 2*n,
+                                                          result.data() + 3*n,
+                                                          result.data() + 4*n};
+  map.Evaluate(n, in, out);
+  for (G4int v = 0; v < BDSPTCMapPolynomial::nVariables; v++)
+    {std::copy(out[v], out[v] + n, in[v]);}
 }
 
 G4bool BDSPTCOneTurnMap::ShouldApplyToPrimary(G4double momentum,
@@ -18,6 +18,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSAcceleratorModel.hh"
 #include "BDSAuxiliaryNavigator.hh"
+#include "BDSBeamline.hh"
 #include "BDSDebug.hh"
 #include "BDSDetectorConstruction.hh"
 #include "BDSGlobalConstants.hh"
@@ -28,8 +29,6 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4VisAttributes.hh"
 #include "G4VPhysicalVolume.hh"
 
-class BDSBeamline;
-
 BDSParallelWorldCurvilinear::BDSParallelWorldCurvilinear(const G4String& name):
   G4VUserParallelWorld("CurvilinearWorld_" + name),
   suffix(name),
@@ -66,4 +65,11 @@ void BDSParallelWorldCurvilinear::Construct()
 
   BDSDetectorConstruction::PlaceBeamlineInWorld(blSet.curvilinearWorld, clWorld,
 						globals->CheckOverlaps(), false, true, true);
+
+  // tabulate the placed volumes so curvilinear transforms can be found without navigating
+  if (suffix == "main" && blSet.curvilinearWorld)
+    {
+      blSet.curvilinearWorld->BuildPlacementTable();
+      BDSAuxiliaryNavigator::RegisterCurvilinearBeamline(blSet.curvilinearWorld);
+    }
 }
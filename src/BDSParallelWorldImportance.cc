@@ -23,13 +23,17 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSGlobalConstants.hh"
 #include "BDSImportanceFileLoader.hh"
 #include "BDSParallelWorldImportance.hh"
+#include "BDSSDImportanceCell.hh"
 #include "BDSUtilities.hh"
+#include "BDSWarning.hh"
 
 #include "globals.hh"
 #include "G4GeometryCell.hh"
 #include "G4IStore.hh"
 #include "G4LogicalVolume.hh"
 #include "G4PVPlacement.hh"
+#include "G4SDManager.hh"
+#include "G4VSolid.hh"
 #include "G4VisAttributes.hh"
 #include "G4VPhysicalVolume.hh"
 
@@ -37,10 +41,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "src-external/gzstream/gzstream.h"
 #endif
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <map>
+#include <set>
 #include <string>
 #include <fstream>
+#include <utility>
+#include <vector>
 
 BDSParallelWorldImportance::BDSParallelWorldImportance(G4String name,
                                                        G4String importanceWorldGeometryFile,
@@ -49,8 +58,10 @@ BDSParallelWorldImportance::BDSParallelWorldImportance(G4String name,
   imWorldPV(nullptr),
   imGeomFile(importanceWorldGeometryFile),
   imVolMap(importanceValuesFile),
+  pilotSD(nullptr),
   componentName("importanceWorld")
 {
+  imVolMapOutput = BDSGlobalConstants::Instance()->ImportanceVolumeMapOutputFile();
   userLimits = BDSGlobalConstants::Instance()->DefaultUserLimits();
   visAttr    = BDSGlobalConstants::Instance()->VisibleDebugVisAttr();
   verbosity  = BDSGlobalConstants::Instance()->VerboseImportanceSampling();
@@ -61,6 +72,15 @@ BDSParallelWorldImportance::BDSParallelWorldImportance(G4String name,
 
 void BDSParallelWorldImportance::Construct()
 {
+  // a pilot run may start with no importance values - all cells then have importance 1
+  if (imVolMap.empty())
+    {
+      if (imVolMapOutput.empty())
+        {throw BDSException(__METHOD_NAME__, "no importanceVolumeMap specified");}
+      BuildWorld();
+      return;
+    }
+
   // load the cell importance values
   G4String importanceMapFile = BDS::GetFullPath(imVolMap);
   if (importanceMapFile.rfind("gz") != std::string::npos)
@@ -181,7 +201,7 @@ void BDSParallelWorldImportance::AddIStore()
     }
 }
 
-G4double BDSParallelWorldImportance::GetCellImportanceValue(const G4String& cellName)
+G4String BDSParallelWorldImportance::PureCellName(const G4String& cellName) const
 {
   // strip off the prepended componentName that we introduce in the geometry factory
   // this is controlled by the member variable of this class above
@@ -206,7 +226,15 @@ G4double BDSParallelWorldImportance::GetCellImportanceValue(const G4String& cell
       std::size_t found = pureCellName.find("_pv_pv");
       pureCellName.erase(found+3, found+6);
     }
+  return pureCellName;
+}
 
+G4double BDSParallelWorldImportance::GetCellImportanceValue(const G4String& cellName)
+{
+  if (imVolMap.empty()) // pilot run without an initial importance map
+    {return 1.0;}
+  
+  G4String pureCellName = PureCellName(cellName);
   auto result = imVolumesAndValues.find(pureCellName);
   if (result != imVolumesAndValues.end())
     {
@@ -235,18 +263,81 @@ G4double BDSParallelWorldImportance::GetCellImportanceValue(const G4String& cell
 
 void BDSParallelWorldImportance::ConstructSD()
 {
-  /*
-  G4SDManager* SDman = G4SDManager::GetSDMpointer();
+  if (imVolMapOutput.empty())
+    {return;}
 
-  // Sensitive Detector Name
-  G4String importanceSamplingSDname = "ImportanceSamplingSD";
+  // the same particle as the geometry sampler the importance is applied to
+  pilotSD = new BDSSDImportanceCell("importance_pilot", "neutron");
+  G4SDManager::GetSDMpointer()->AddNewDetector(pilotSD);
+  std::set<G4LogicalVolume*> cellLVs;
+  for (const auto& cell : imVolumeStore)
+    {cellLVs.insert(cell.GetPhysicalVolume().GetLogicalVolume());}
+  for (auto lv : cellLVs)
+    {SetSensitiveDetector(lv, pilotSD);}
+}
 
-  // Create multifunctional detector for parallel world
-  G4MultiFunctionalDetector* MFDet = new G4MultiFunctionalDetector(importanceSamplingSDname);
-  SDman->AddNewDetector(MFDet); // Register SD to SDManager
+void BDSParallelWorldImportance::WriteImportanceMap() const
+{
+  if (imVolMapOutput.empty() || !pilotSD)
+    {return;}
+
+  // The weighted track length per unit volume is an estimate of the flux that doesn't
+  // depend on the importance values used. The importance of each cell is inversely
+  // proportional to the flux and rounded to a power of 2, with the highest flux cell
+  // having an importance of 1.
+  std::vector<std::pair<G4String, G4double> > fluxes;
+  G4double maxFlux = 0;
+  for (const auto& cell : imVolumeStore)
+    {
+      const G4VPhysicalVolume* pv = &cell.GetPhysicalVolume();
+      G4double volume = pv->GetLogicalVolume()->GetSolid()->GetCubicVolume();
+      G4double flux = volume > 0 ? pilotSD->TrackLength(pv) / volume : 0;
+      fluxes.emplace_back(PureCellName(pv->GetName()), flux);
+      maxFlux = std::max(maxFlux, flux);
+    }
 
-  // Neutron filter
-  G4SDParticleFilter* neutronFilter = new G4SDParticleFilter("neutronFilter", "neutron");
-  MFDet->SetFilter(neutronFilter);
-  */
+  std::vector<std::pair<G4String, G4double> > importances;
+  G4double maxImportance = 1;
+  G4int nCellsNotReached = 0;
+  for (const auto& cellFlux : fluxes)
+    {
+      G4double importance = -1; // flag for not reached
+      if (cellFlux.second > 0)
+        {
+          importance = std::pow(2.0, std::max(0.0, std::round(std::log2(maxFlux / cellFlux.second))));
+          maxImportance = std::max(maxImportance, importance);
+        }
+      else
+        {nCellsNotReached++;}
+      importances.emplace_back(cellFlux.first, importance);
+    }
+
+  // cells that weren't reached get the highest importance found so another
+  // iteration with this map can reach them
+  if (nCellsNotReached > 0)
+    {
+      BDS::Warning(__METHOD_NAME__, std::to_string(nCellsNotReached) + " importance cells were not reached in the pilot run\n"
+                   + "and are given the highest importance found (" + std::to_string(maxImportance) + ")");
+    }
+
+  std::ofstream outFile(imVolMapOutput);
+  if (!outFile.is_open())
+    {throw BDSException(__METHOD_NAME__, "unable to open \"" + imVolMapOutput + "\" for writing");}
+  for (auto& cellImportance : importances)
+    {
+      if (cellImportance.second < 0)
+        {cellImportance.second = maxImportance;}
+      outFile << std::left << std::setw(25) << cellImportance.first << " " << cellImportance.second << "\n";
+    }
+  outFile.close();
+  G4cout << __METHOD_NAME__ << "importance values for " << importances.size()
+         << " cells written to \"" << imVolMapOutput << "\"" << G4endl;
+  if (verbosity > 0)
+    {
+      for (std::size_t i = 0; i < fluxes.size(); i++)
+        {
+          G4cout << std::left << std::setw(25) << fluxes[i].first << " flux " << std::setw(14) << fluxes[i].second
+                 << " importance " << importances[i].second << G4endl;
+        }
+    }
 }
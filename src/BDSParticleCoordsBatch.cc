@@ -0,0 +1,64 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSParticleCoordsBatch.hh"
+#include "BDSParticleCoordsFull.hh"
+
+#include <vector>
+
+std::vector<std::vector<G4double>*> BDSParticleCoordsBatch::Arrays()
+{
+  return {&x, &y, &z, &xp, &yp, &zp, &T, &s, &totalEnergy, &weight};
+}
+
+void BDSParticleCoordsBatch::Reserve(std::size_t n)
+{
+  for (auto* a : Arrays())
+    {a->reserve(n);}
+}
+
+void BDSParticleCoordsBatch::Resize(std::size_t n)
+{
+  for (auto* a : Arrays())
+    {a->resize(n, 0);}
+}
+
+void BDSParticleCoordsBatch::Clear()
+{
+  for (auto* a : Arrays())
+    {a->clear();}
+}
+
+void BDSParticleCoordsBatch::Append(const BDSParticleCoordsFull& coords)
+{
+  x.push_back(coords.x);
+  y.push_back(coords.y);
+  z.push_back(coords.z);
+  xp.push_back(coords.xp);
+  yp.push_back(coords.yp);
+  zp.push_back(coords.zp);
+  T.push_back(coords.T);
+  s.push_back(coords.s);
+  totalEnergy.push_back(coords.totalEnergy);
+  weight.push_back(coords.weight);
+}
+
+BDSParticleCoordsFull BDSParticleCoordsBatch::Get(std::size_t i) const
+{
+  return BDSParticleCoordsFull(x[i], y[i], z[i], xp[i], yp[i], zp[i], T[i], s[i], totalEnergy[i], weight[i]);
+}
@@ -0,0 +1,177 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSPhysicsProcessSplitting.hh"
+#include "BDSPhysicsVectorLinear.hh"
+#include "BDSUtilities.hh"
+#include "BDSWarning.hh"
+#include "BDSWrapperProcessSplitting.hh"
+
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4PhysicsListHelper.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4String.hh"
+#include "G4TrackFastVector.hh"
+#include "G4Types.hh"
+#include "G4Version.hh"
+
+#include "parser/processsplitting.h"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BDSPhysicsProcessSplitting::BDSPhysicsProcessSplitting(const std::vector<GMAD::ProcessSplitting>& definitionsIn):
+  G4VPhysicsConstructor("BDSPhysicsProcessSplitting")
+{
+  G4int maxSize = G4TrackFastVectorSize/2;
+  for (const auto& def : definitionsIn)
+    {
+      G4String name = G4String(def.name);
+      G4String msgSuffix = " in processsplitting \"" + name + "\"";
+      std::vector<G4String> particles = BDS::SplitOnWhiteSpace(G4String(def.particle));
+      std::vector<G4String> processes = BDS::SplitOnWhiteSpace(G4String(def.process));
+      if (particles.empty())
+        {throw BDSException(__METHOD_NAME__, "no particle specified" + msgSuffix);}
+      if (processes.empty())
+        {throw BDSException(__METHOD_NAME__, "no process specified" + msgSuffix);}
+      
+      std::set<G4int> pdgIDs;
+      for (const auto& word : BDS::SplitOnWhiteSpace(G4String(def.products)))
+        {
+          try
+            {pdgIDs.insert(std::stoi(word));}
+          catch (const std::logic_error&)
+            {throw BDSException(__METHOD_NAME__, "product ID \"" + word + "\"" + msgSuffix + " cannot be converted to an integer");}
+        }
+      
+      std::vector<G4double> factors(def.factor.begin(), def.factor.end());
+      std::vector<G4double> kineticEnergies;
+      for (auto eK : def.kineticEnergy)
+        {kineticEnergies.push_back(eK * CLHEP::GeV);}
+      if (factors.empty())
+        {throw BDSException(__METHOD_NAME__, "no factor specified" + msgSuffix);}
+      if (factors.size() == 1 && kineticEnergies.size() <= 1)
+        {// constant factor - the linear vector needs 2 points
+          kineticEnergies = {0, 1};
+          factors.push_back(factors[0]);
+        }
+      if (kineticEnergies.size() != factors.size())
+        {throw BDSException(__METHOD_NAME__, "kineticEnergy and factor must be the same length" + msgSuffix);}
+      for (G4int i = 0; i < (G4int)factors.size(); i++)
+        {
+          if (factors[i] < 1)
+            {throw BDSException(__METHOD_NAME__, "factor must be 1 or greater" + msgSuffix);}
+          if (factors[i] > maxSize)
+            {
+              G4String msg = "the maximum safe splitting factor is " + std::to_string(maxSize);
+              msg += " based on the G4TrackFastVectorSize in Geant4" + msgSuffix;
+              throw BDSException(__METHOD_NAME__, msg);
+            }
+          if (i > 0 && kineticEnergies[i] <= kineticEnergies[i-1])
+            {throw BDSException(__METHOD_NAME__, "kineticEnergy must be strictly increasing" + msgSuffix);}
+        }
+      
+      definitions.push_back({std::set<G4String>(particles.begin(), particles.end()),
+                             std::set<G4String>(processes.begin(), processes.end()),
+                             {name, pdgIDs, BDSPhysicsVectorLinear(kineticEnergies, factors)}});
+    }
+}
+
+void BDSPhysicsProcessSplitting::ConstructProcess()
+{
+  if (Activated())
+    {return;}
+  
+#if G4VERSION_NUMBER > 1029
+  auto aParticleIterator =  G4ParticleTable::GetParticleTable()->GetIterator();
+#endif
+  aParticleIterator->reset();
+  
+  G4PhysicsListHelper* ph = G4PhysicsListHelper::GetPhysicsListHelper();
+  
+  // keep track of what we've wrapped so we can warn about definitions that didn't match anything
+  std::vector<G4bool> used(definitions.size(), false);
+  
+  while( (*aParticleIterator)() )
+    {
+      G4ParticleDefinition* particle = aParticleIterator->value();
+      G4String particleName = particle->GetParticleName();
+      G4ProcessManager* pManager = particle->GetProcessManager();
+      if (!pManager)
+        {continue;}
+      
+      // copy the processes to wrap first as we modify the process manager as we go
+      std::vector<G4VProcess*> processesToWrap;
+      std::vector<std::vector<BDSWrapperProcessSplitting::ProductSplitting> > productsToWrap;
+      G4ProcessVector* processVector = pManager->GetProcessList();
+      for (G4int i=0; i < (G4int)processVector->entries(); ++i)
+        {
+          G4VProcess* process = (*processVector)[i];
+          G4String processName = process->GetProcessName();
+          std::vector<BDSWrapperProcessSplitting::ProductSplitting> products;
+          for (G4int j = 0; j < (G4int)definitions.size(); j++)
+            {
+              const Definition& def = definitions[j];
+              if (def.particles.count(particleName) > 0 && def.processes.count(processName) > 0)
+                {
+                  products.push_back(def.products);
+                  used[j] = true;
+                }
+            }
+          if (!products.empty())
+            {
+              processesToWrap.push_back(process);
+              productsToWrap.push_back(products);
+            }
+        }
+      
+      for (G4int i = 0; i < (G4int)processesToWrap.size(); i++)
+        {
+          G4VProcess* process = processesToWrap[i];
+          auto wrappedProcess = new BDSWrapperProcessSplitting(process, productsToWrap[i]);
+          pManager->RemoveProcess(process);
+          ph->RegisterProcess(wrappedProcess, particle);
+          for (const auto& product : productsToWrap[i])
+            {
+              G4cout << "Bias> process splitting> \"" << product.name << "\" wrapping \"" << process->GetProcessName()
+                     << "\" for particle \"" << particleName << "\" for products: ";
+              if (product.pdgIDs.empty())
+                {G4cout << "all";}
+              for (auto id : product.pdgIDs)
+                {G4cout << id << " ";}
+              G4cout << G4endl;
+            }
+        }
+    }
+  
+  for (G4int j = 0; j < (G4int)definitions.size(); j++)
+    {
+      if (!used[j])
+        {BDS::Warning(__METHOD_NAME__, "processsplitting \"" + definitions[j].products.name + "\" did not match any particle and process");}
+    }
+  
+  SetActivated();
+}
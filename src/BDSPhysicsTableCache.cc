@@ -0,0 +1,239 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSPhysicsTableCache.hh"
+#include "BDSUtilities.hh"
+#include "BDSWarning.hh"
+
+#include "globals.hh"
+#include "G4Element.hh"
+#include "G4IonisParamMat.hh"
+#include "G4Material.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4String.hh"
+#include "G4Types.hh"
+#include "G4Version.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4VPhysicsConstructor.hh"
+#if G4VERSION_NUMBER > 1039
+#include "G4EmParameters.hh"
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace
+{
+  /// 64 bit FNV-1a hash - stable between builds and platforms unlike std::hash.
+  uint64_t HashText(const std::string& text)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : text)
+      {
+        hash ^= (uint64_t)c;
+        hash *= 1099511628211ULL;
+      }
+    return hash;
+  }
+
+  /// Make a directory and any missing parents. Returns true if it exists afterwards.
+  G4bool MakeDirectories(const G4String& path)
+  {
+    for (std::size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1))
+      {mkdir(path.substr(0, pos).c_str(), 0755);}
+    mkdir(path.c_str(), 0755);
+    return BDS::DirectoryExists(path);
+  }
+
+  /// Remove the files in a directory (not recursive) then the directory itself.
+  void RemoveDirectory(const G4String& path)
+  {
+    DIR* dir = opendir(path.c_str());
+    if (!dir)
+      {return;}
+    while (struct dirent* entry = readdir(dir))
+      {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..")
+          {std::remove((path + "/" + name).c_str());}
+      }
+    closedir(dir);
+    rmdir(path.c_str());
+  }
+}
+
+BDSPhysicsTableCache::BDSPhysicsTableCache(const G4String&        cacheDirectoryIn,
+                                           G4VModularPhysicsList* physicsListIn):
+  cacheDirectory(cacheDirectoryIn),
+  physicsList(physicsListIn),
+  prepared(false),
+  retrieved(false),
+  stored(false)
+{
+  if (!physicsList)
+    {throw BDSException(__METHOD_NAME__, "no physics list");}
+  if (cacheDirectory.empty())
+    {throw BDSException(__METHOD_NAME__, "no cache directory given");}
+  if (cacheDirectory.back() == '/')
+    {cacheDirectory.pop_back();}
+}
+
+G4String BDSPhysicsTableCache::KeyText() const
+{
+  std::ostringstream key;
+  key << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+  key << "geant4 " << G4VERSION_NUMBER << " " << G4Version << "\n";
+  const std::vector<G4String> dataVariables = {"G4LEDATA", "G4LEVELGAMMADATA", "G4NEUTRONHPDATA",
+                                               "G4PARTICLEXSDATA", "G4PIIDATA", "G4SAIDXSDATA",
+                                               "G4ENSDFSTATEDATA", "G4INCLDATA", "G4ABLADATA",
+                                               "G4RADIOACTIVEDATA", "G4REALSURFACEDATA"};
+  for (const auto& variable : dataVariables)
+    {
+      const char* value = std::getenv(variable.c_str());
+      key << variable << " " << (value ? value : "") << "\n";
+    }
+
+  key << "physics";
+  for (G4int i = 0; const G4VPhysicsConstructor* constructor = physicsList->GetPhysics(i); i++)
+    {key << " " << constructor->GetPhysicsName();}
+  key << "\n" << "defaultCut " << physicsList->GetDefaultCutValue() << "\n";
+#if G4VERSION_NUMBER > 1039
+  key << *G4EmParameters::Instance() << "\n";
+#endif
+
+  const G4ProductionCutsTable* cutsTable = G4ProductionCutsTable::GetProductionCutsTable();
+  key << "cutsEnergyRange " << cutsTable->GetLowEdgeEnergy() << " " << cutsTable->GetHighEdgeEnergy() << "\n";
+  for (const G4Region* region : *G4RegionStore::GetInstance())
+    {
+      key << "region " << region->GetName();
+      if (const G4ProductionCuts* cuts = region->GetProductionCuts())
+        {
+          for (G4int i = 0; i < 4; i++) // gamma, e-, e+, proton
+            {key << " " << cuts->GetProductionCut(i);}
+        }
+      key << "\n";
+    }
+
+  for (const G4Material* material : *G4Material::GetMaterialTable())
+    {
+      key << "material " << material->GetName()
+          << " " << material->GetDensity()
+          << " " << (G4int)material->GetState()
+          << " " << material->GetTemperature()
+          << " " << material->GetPressure()
+          << " " << material->GetIonisation()->GetMeanExcitationEnergy();
+      const G4double* fractions = material->GetFractionVector();
+      for (G4int i = 0; i < (G4int)material->GetNumberOfElements(); i++)
+        {
+          const G4Element* element = material->GetElement(i);
+          key << " " << element->GetName() << " " << element->GetZ() << " " << element->GetN()
+              << " " << fractions[i];
+        }
+      key << "\n";
+    }
+  return G4String(key.str());
+}
+
+void BDSPhysicsTableCache::Prepare()
+{
+  if (prepared)
+    {return;}
+  prepared = true;
+
+  keyText = KeyText();
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << HashText(keyText);
+  entryDirectory = cacheDirectory + "/" + name.str();
+
+  if (!BDS::DirectoryExists(entryDirectory))
+    {
+      G4cout << __METHOD_NAME__ << "no cached physics tables - they will be stored in \""
+             << entryDirectory << "\"" << G4endl;
+      return;
+    }
+
+  // guard against a hash collision
+  std::ifstream keyFile(entryDirectory + "/key.txt");
+  std::stringstream storedKey;
+  storedKey << keyFile.rdbuf();
+  if (storedKey.str() != keyText)
+    {
+      BDS::Warning(__METHOD_NAME__, "physics table cache entry \"" + entryDirectory
+                   + "\" was made with different inputs - it will not be used");
+      stored = true; // don't overwrite it either
+      return;
+    }
+
+  G4cout << __METHOD_NAME__ << "retrieving physics tables from \"" << entryDirectory << "\"" << G4endl;
+  physicsList->SetPhysicsTableRetrieved(entryDirectory);
+  retrieved = true;
+}
+
+void BDSPhysicsTableCache::StoreIfRequired()
+{
+  if (!prepared || retrieved || stored)
+    {return;}
+  stored = true;
+
+  if (!MakeDirectories(cacheDirectory))
+    {
+      BDS::Warning(__METHOD_NAME__, "unable to create physics table cache directory \"" + cacheDirectory + "\"");
+      return;
+    }
+
+  // write to a directory unique to this process then rename it so other jobs using the
+  // same cache never see an incomplete entry
+  G4String temporaryDirectory = entryDirectory + ".tmp" + std::to_string((long)getpid());
+  if (!MakeDirectories(temporaryDirectory))
+    {
+      BDS::Warning(__METHOD_NAME__, "unable to create directory \"" + temporaryDirectory + "\"");
+      return;
+    }
+
+  G4bool success = physicsList->StorePhysicsTable(temporaryDirectory);
+  std::ofstream keyFile(temporaryDirectory + "/key.txt");
+  keyFile << keyText;
+  keyFile.close();
+  success = success && !keyFile.fail();
+
+  if (success && std::rename(temporaryDirectory.c_str(), entryDirectory.c_str()) == 0)
+    {G4cout << __METHOD_NAME__ << "stored physics tables in \"" << entryDirectory << "\"" << G4endl;}
+  else
+    {// failed or another job stored the same entry first
+      RemoveDirectory(temporaryDirectory);
+      if (!success)
+        {BDS::Warning(__METHOD_NAME__, "unable to store physics tables in \"" + cacheDirectory + "\"");}
+    }
+}
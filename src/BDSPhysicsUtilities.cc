@@ -30,6 +30,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSPhysicsCutsAndLimits.hh"
 #include "BDSPhysicsEMDissociation.hh"
 #include "BDSPhysicsMuonSplitting.hh"
+#include "BDSPhysicsProcessSplitting.hh"
 #include "BDSPhysicsUtilities.hh"
 #include "BDSUtilities.hh"
 #include "BDSWarning.hh"
@@ -92,6 +93,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "parser/beam.h"
 #include "parser/fastlist.h"
 #include "parser/physicsbiasing.h"
+#include "parser/processsplitting.h"
 
 #include <iomanip>
 #include <map>
@@ -528,6 +530,16 @@ void BDS::BuildMuonBiasing(G4VModularPhysicsList* physicsList)
     }
 }
 
+void BDS::BuildProcessSplitting(G4VModularPhysicsList* physicsList,
+                                const std::vector<GMAD::ProcessSplitting>& definitions)
+{
+  if (definitions.empty())
+    {return;}
+  G4cout << "BDSPhysicsProcessSplitting -> using process splitting wrapper for "
+         << definitions.size() << " definition(s)" << G4endl;
+  physicsList->RegisterPhysics(new BDSPhysicsProcessSplitting(definitions));
+}
+
 void BDS::PrintDefinedParticles()
 {
   G4cout << __METHOD_NAME__ << "Defined particles: " << G4endl;
@@ -44,7 +44,7 @@ BDSPhysicsVectorLinear::BDSPhysicsVectorLinear(const std::vector<G4double>& kine
 
 G4double BDSPhysicsVectorLinear::Value(G4double eK) const
 {
-  if (eK < eKMin)
+  if (eK <= eKMin)
     {return eKMinValue;}
   else if (eK > eKMax)
     {return eKMaxValue;}
@@ -16,11 +16,13 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSAcceleratorModel.hh"
 #include "BDSBunch.hh"
 #include "BDSDebug.hh"
 #include "BDSEventInfo.hh"
 #include "BDSException.hh"
 #include "BDSExtent.hh"
+#include "BDSFastTransport.hh"
 #include "BDSGlobalConstants.hh"
 #include "BDSIonDefinition.hh"
 #include "BDSOutputLoader.hh"
@@ -49,6 +51,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Run.hh"
 #include "G4RunManager.hh"
 
+#include <algorithm>
+#include <vector>
+
 BDSPrimaryGeneratorAction::BDSPrimaryGeneratorAction(BDSBunch*         bunchIn,
                                                      const GMAD::Beam& beam,
                                                      G4bool            batchMode):
@@ -59,7 +64,11 @@ BDSPrimaryGeneratorAction::BDSPrimaryGeneratorAction(BDSBunch*         bunchIn,
   distrFileMatchLength(beam.distrFileMatchLength),
   ionCached(false),
   oneTurnMap(nullptr),
-  generatorFromFile(nullptr)
+  generatorFromFile(nullptr),
+  useFastTransport(false),
+  fastTransportBatchSize(1),
+  fastTransport(nullptr),
+  fastTransportBufferIndex(0)
 {
   if (!bunchIn)
     {throw BDSException(__METHOD_NAME__, "valid BDSBunch required");}
@@ -83,6 +92,27 @@ BDSPrimaryGeneratorAction::BDSPrimaryGeneratorAction(BDSBunch*         bunchIn,
   particleGun->SetParticleTime(0);
   
   generatorFromFile = BDSPrimaryGeneratorFile::ConstructGenerator(beam, bunch, recreate, eventOffset, batchMode);
+
+  const BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
+  if (globals->FastTransportPrimaries())
+    {
+      if (generatorFromFile)
+        {BDS::Warning(__METHOD_NAME__, "fastTransportPrimaries is not used with an event generator or sampler file");}
+      else if (globals->Circular())
+        {BDS::Warning(__METHOD_NAME__, "fastTransportPrimaries is not used for a circular machine");}
+      else
+        {
+          useFastTransport = true;
+          fastTransportBatchSize = std::max(1, globals->FastTransportBatchSize());
+          // A batch is generated in one event, so the seed state of the other events in it doesn't
+          // reproduce their primary and the events can't be recreated individually.
+          if (recreate && fastTransportBatchSize > 1)
+            {throw BDSException(__METHOD_NAME__, "fastTransportBatchSize > 1 cannot be used with recreate as the primaries of a batch are all generated in its first event");}
+          // they would also all have the bunch index of the first event
+          if (bunch->UseBunchTiming() || !bunch->CanGenerateInBatches())
+            {fastTransportBatchSize = 1;}
+        }
+    }
 }
 
 BDSPrimaryGeneratorAction::~BDSPrimaryGeneratorAction()
@@ -90,6 +120,7 @@ BDSPrimaryGeneratorAction::~BDSPrimaryGeneratorAction()
   delete particleGun;
   delete recreateFile;
   delete generatorFromFile;
+  delete fastTransport;
 }
 
 void BDSPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
@@ -146,7 +177,7 @@ void BDSPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
   // the particles they load so the number of events to generate can be predicted exactly and
   // there is no need to check on whether an event has been successfully generated here.
   try
-    {coords = bunch->GetNextParticleValid();}
+    {coords = useFastTransport ? GetNextFastTransportedParticle(thisEventID) : bunch->GetNextParticleValid();}
   catch (const BDSException& exception)
     {// we couldn't safely generate a particle -> abort
       // could be because of user input file
@@ -260,3 +291,26 @@ void BDSPrimaryGeneratorAction::GeneratePrimariesFromFile(G4Event* anEvent)
       G4EventManager::GetEventManager()->AbortCurrentEvent();
     }
 }
+
+BDSParticleCoordsFullGlobal BDSPrimaryGeneratorAction::GetNextFastTransportedParticle(G4int eventIndex)
+{
+  if (!fastTransport) // the beam line is only built after this class is constructed
+    {fastTransport = new BDSFastTransport(BDSAcceleratorModel::Instance()->BeamlineMain());}
+
+  if (fastTransportBufferIndex >= fastTransportBuffer.size())
+    {
+      G4int nToGenerate = 1;
+      if (fastTransportBatchSize > 1)
+        {// don't generate more than will be used in this run
+          G4int nRemaining = BDSGlobalConstants::Instance()->NGenerate() - eventIndex;
+          nToGenerate = std::max(1, std::min(fastTransportBatchSize, nRemaining));
+        }
+      fastTransportBuffer.clear();
+      fastTransportBufferIndex = 0;
+      std::vector<BDSParticleCoordsFullGlobal> batch;
+      bunch->GetNextParticlesValid(nToGenerate, batch); // may throw, leaving the buffer empty
+      fastTransport->Transport(batch, bunch->ParticleDefinition());
+      fastTransportBuffer.swap(batch);
+    }
+  return fastTransportBuffer[fastTransportBufferIndex++];
+}
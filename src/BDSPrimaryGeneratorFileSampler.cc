@@ -20,6 +20,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSOutputLoaderSampler.hh"
+#include "BDSOutputROOTEventSampler.hh"
 #include "BDSPrimaryGeneratorFileSampler.hh"
 #include "BDSParticleCoords.hh"
 #include "BDSParticleCoordsFull.hh"
@@ -27,6 +28,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSPhysicalConstants.hh"
 #include "BDSPrimaryVertexInformation.hh"
 #include "BDSPrimaryVertexInformationV.hh"
+#include "BDSSamplerEventPrefetcher.hh"
 #include "BDSUtilities.hh"
 #include "BDSWarning.hh"
 
@@ -40,6 +42,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "globals.hh"
 
+#include <cstddef>
 #include <utility>
 
 BDSPrimaryGeneratorFileSampler::BDSPrimaryGeneratorFileSampler(const G4String& distrType,
@@ -50,6 +53,7 @@ BDSPrimaryGeneratorFileSampler::BDSPrimaryGeneratorFileSampler(const G4String& d
                                                                G4bool warnAboutSkippedParticlesIn):
   BDSPrimaryGeneratorFile(loopFileIn, bunchIn),
   reader(nullptr),
+  prefetcher(nullptr),
   fileName(fileNameIn),
   removeUnstableWithoutDecay(removeUnstableWithoutDecayIn),
   warnAboutSkippedParticles(warnAboutSkippedParticlesIn)
@@ -66,10 +70,25 @@ BDSPrimaryGeneratorFileSampler::BDSPrimaryGeneratorFileSampler(const G4String& d
   if (!bunch)
     {throw BDSException(__METHOD_NAME__, "must be constructed with a valid BDSBunchEventGenerator instance");}
   SkipEvents(bunch->eventGeneratorNEventsSkip);
+  centralCoords = bunch->GetNextParticleLocal();
+
+  if (bunch->eventGeneratorPrefetchNEvents > 0 && nEventsInFile > 0)
+    {
+      G4cout << __METHOD_NAME__ << "prefetching up to " << bunch->eventGeneratorPrefetchNEvents
+             << " events on a separate thread" << G4endl;
+      // the reader is only used by the prefetcher thread from now on - ROOT thread
+      // safety is enabled at start up in BDSIM::Initialise() before any file is opened
+      bunch->PrepareParticleFilter(); // uses the particle table so must be done here
+      prefetcher = new BDSSamplerEventPrefetcher([this](G4long i, BDSSamplerEvent& ev){LoadEvent(i, ev, true);},
+                                                 nEventsInFile,
+                                                 (std::size_t)bunch->eventGeneratorPrefetchNEvents,
+                                                 currentFileEventIndex);
+    }
 }
 
 BDSPrimaryGeneratorFileSampler::~BDSPrimaryGeneratorFileSampler()
 {
+  delete prefetcher; // stops the thread that uses the reader
   delete reader;
 }
 
@@ -117,12 +136,14 @@ void BDSPrimaryGeneratorFileSampler::RecreateAdvanceToEvent(G4int eventOffset)
   SkipEvents(eventOffset);
 }
 
-void BDSPrimaryGeneratorFileSampler::ReadPrimaryParticlesFloat(G4long index)
+template <typename T>
+void BDSPrimaryGeneratorFileSampler::LoadParticles(const BDSOutputROOTEventSampler<T>* sampler,
+                                                   G4double momentumUnit,
+                                                   BDSSamplerEvent& event,
+                                                   G4bool applyFilters) const
 {
-  vertices.clear();
-  const auto sampler = reader->SamplerDataFloat(index);
-  
   int n = sampler->n;
+  event.particles.reserve((std::size_t)n);
   for (int i = 0; i < n; i++)
     {
       G4int pdgID = (G4int)sampler->partID[i];
@@ -130,51 +151,70 @@ void BDSPrimaryGeneratorFileSampler::ReadPrimaryParticlesFloat(G4long index)
       G4double yp = (G4double)sampler->yp[i];
       G4double zp = (G4double)sampler->zp[i];
       G4double p  = (G4double)sampler->p[i];
-      G4ThreeVector momentum = G4ThreeVector(xp,yp,zp) * p * CLHEP::GeV;
+      G4ThreeVector momentum = G4ThreeVector(xp,yp,zp) * p * momentumUnit;
       G4double x = (G4double)sampler->x[i] * CLHEP::m;
       G4double y = (G4double)sampler->y[i] * CLHEP::m;
       G4double T = (G4double)sampler->T[i] * CLHEP::s;
       G4ThreeVector localPosition(x,y,0);
       G4double weight = (G4double)sampler->weight[i];
-      auto g4prim = new G4PrimaryParticle(pdgID, momentum.x(), momentum.y(), momentum.z());
-      g4prim->SetWeight(weight);
-      vertices.emplace_back(DisplacedVertex{localPosition, T, g4prim});
+
+      if (applyFilters)
+        {// same coordinates as in ReadSingleEvent but without the kinetic energy cut
+          G4ThreeVector unitMomentum = momentum.unit();
+          unitMomentum.transform(referenceBeamMomentumOffset);
+          G4double rp = unitMomentum.perp();
+          BDSParticleCoordsFull local = centralCoords;
+          local.AddOffset(localPosition, T);
+          local.xp = unitMomentum.x();
+          local.yp = unitMomentum.y();
+          local.zp = unitMomentum.z();
+          if (!bunch->AcceptParticleCoordinates(local, rp, pdgID))
+            {
+              event.nParticlesFiltered++;
+              continue;
+            }
+        }
+      event.particles.emplace_back(BDSSamplerParticle{pdgID, momentum, localPosition, T, weight});
     }
 }
 
-void BDSPrimaryGeneratorFileSampler::ReadPrimaryParticlesDouble(G4long index)
+void BDSPrimaryGeneratorFileSampler::LoadEvent(G4long index,
+                                               BDSSamplerEvent& event,
+                                               G4bool applyFilters)
+{
+  event.index = index;
+  event.nParticlesFiltered = 0;
+  event.particles.clear();
+  // the data in double precision output is already in Geant4 units (MeV) whereas float is in GeV
+  if (reader->DoublePrecision())
+    {LoadParticles(reader->SamplerDataDouble(index), 1.0, event, applyFilters);}
+  else
+    {LoadParticles(reader->SamplerDataFloat(index), CLHEP::GeV, event, applyFilters);}
+}
+
+void BDSPrimaryGeneratorFileSampler::ReadPrimaryParticles(const BDSSamplerEvent& event)
 {
   vertices.clear();
-  const auto sampler = reader->SamplerDataDouble(index);
-  
-  int n = sampler->n;
-  for (int i = 0; i < n; i++)
+  vertices.reserve(event.particles.size());
+  for (const auto& particle : event.particles)
     {
-      G4int pdgID = (G4int)sampler->partID[i];
-      G4double xp = (G4double)sampler->xp[i];
-      G4double yp = (G4double)sampler->yp[i];
-      G4double zp = (G4double)sampler->zp[i];
-      G4double p  = (G4double)sampler->p[i];
-      G4ThreeVector momentum = G4ThreeVector(xp,yp,zp) * p;
-      G4double x = (G4double)sampler->x[i] * CLHEP::m;
-      G4double y = (G4double)sampler->y[i] * CLHEP::m;
-      G4double T = (G4double)sampler->T[i] * CLHEP::s;
-      G4ThreeVector localPosition(x,y,0);
-      G4double weight = (G4double)sampler->weight[i];
-      auto g4prim = new G4PrimaryParticle(pdgID, momentum.x(), momentum.y(), momentum.z());
-      g4prim->SetWeight(weight);
-      vertices.emplace_back(DisplacedVertex{localPosition, T, g4prim});
+      const G4ThreeVector& momentum = particle.momentum;
+      auto g4prim = new G4PrimaryParticle(particle.pdgID, momentum.x(), momentum.y(), momentum.z());
+      g4prim->SetWeight(particle.weight);
+      vertices.emplace_back(DisplacedVertex{particle.localPosition, particle.T, g4prim});
     }
 }
 
 void BDSPrimaryGeneratorFileSampler::ReadSingleEvent(G4long index, G4Event* anEvent)
 {
-  if (reader->DoublePrecision())
-    {ReadPrimaryParticlesDouble(index);}
+  BDSSamplerEvent event;
+  if (prefetcher)
+    {prefetcher->Get(index, event);}
   else
-    {ReadPrimaryParticlesFloat(index);}
+    {LoadEvent(index, event, false);}
+  ReadPrimaryParticles(event);
   
-  G4int nParticlesSkipped = 0;
+  G4int nParticlesSkipped = event.nParticlesFiltered;
   for (const auto& xyzVertex : vertices)
     {
       const auto vertex = xyzVertex.vertex;
@@ -301,6 +341,6 @@ void BDSPrimaryGeneratorFileSampler::SkipEvents(G4long nEventsToSkip)
       msg += ") in this file.";
       throw BDSException("BDSBunchUserFile::RecreateAdvanceToEvent>", msg);
     }
-  G4long nToSkipSinglePass = nAvailable % nEventsToSkip;
+  G4long nToSkipSinglePass = nEventsToSkip % nEventsInFile;
   currentFileEventIndex = nToSkipSinglePass;
 }
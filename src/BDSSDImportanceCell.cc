@@ -0,0 +1,67 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSSDImportanceCell.hh"
+
+#include "globals.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include <map>
+
+BDSSDImportanceCell::BDSSDImportanceCell(const G4String& name,
+                                         const G4String& particleNameIn):
+  G4VSensitiveDetector("importance_cell/" + name),
+  particleName(particleNameIn),
+  particle(nullptr)
+{;}
+
+G4bool BDSSDImportanceCell::ProcessHits(G4Step* step,
+                                        G4TouchableHistory* /*th*/)
+{
+  if (!particle)
+    {particle = G4ParticleTable::GetParticleTable()->FindParticle(particleName);}
+
+  const G4Track* track = step->GetTrack();
+  if (track->GetDefinition() != particle)
+    {return false;}
+
+  // in a parallel world the step is the one in this world so the pre step point
+  // volume is the importance cell
+  const G4VPhysicalVolume* cell = step->GetPreStepPoint()->GetPhysicalVolume();
+  CellFlux& flux = cells[cell];
+  flux.trackLength += track->GetWeight() * step->GetStepLength();
+  flux.nSteps++;
+  return false; // no hit stored
+}
+
+G4double BDSSDImportanceCell::TrackLength(const G4VPhysicalVolume* cell) const
+{
+  auto search = cells.find(cell);
+  return search != cells.end() ? search->second.trackLength : 0;
+}
+
+G4long BDSSDImportanceCell::NSteps(const G4VPhysicalVolume* cell) const
+{
+  auto search = cells.find(cell);
+  return search != cells.end() ? search->second.nSteps : 0;
+}
@@ -0,0 +1,131 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSSamplerEventPrefetcher.hh"
+
+#include <utility>
+
+BDSSamplerEventPrefetcher::BDSSamplerEventPrefetcher(Loader      loaderIn,
+                                                     G4long      nEventsInFileIn,
+                                                     std::size_t capacityIn,
+                                                     G4long      firstIndex):
+  loader(std::move(loaderIn)),
+  nEventsInFile(nEventsInFileIn),
+  capacity(capacityIn),
+  stopRequested(false),
+  nextIndexToLoad(0),
+  nextIndexExpected(0)
+{
+  if (nEventsInFile <= 0)
+    {throw BDSException(__METHOD_NAME__, "no events in file to prefetch");}
+  if (capacity == 0)
+    {capacity = 1;}
+  Start(firstIndex);
+}
+
+BDSSamplerEventPrefetcher::~BDSSamplerEventPrefetcher()
+{
+  Stop();
+}
+
+void BDSSamplerEventPrefetcher::Start(G4long firstIndex)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  stopRequested     = false;
+  workerError       = nullptr;
+  nextIndexToLoad   = firstIndex % nEventsInFile;
+  nextIndexExpected = nextIndexToLoad;
+  worker = std::thread(&BDSSamplerEventPrefetcher::Run, this);
+}
+
+void BDSSamplerEventPrefetcher::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopRequested = true;
+  }
+  notFull.notify_all();
+  if (worker.joinable())
+    {worker.join();}
+  std::lock_guard<std::mutex> lock(mutex);
+  buffer.clear();
+}
+
+void BDSSamplerEventPrefetcher::Run()
+{
+  while (true)
+    {
+      G4long index = 0;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this]{return stopRequested || buffer.size() < capacity;});
+        if (stopRequested)
+          {return;}
+        index = nextIndexToLoad;
+      }
+
+      // load outside the lock so the event loop can take events in the meantime
+      BDSSamplerEvent event;
+      event.index = index;
+      try
+        {loader(index, event);}
+      catch (...)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          workerError = std::current_exception();
+          notEmpty.notify_all();
+          return;
+        }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopRequested)
+          {return;}
+        buffer.push_back(std::move(event));
+        nextIndexToLoad = (index + 1) % nEventsInFile;
+      }
+      notEmpty.notify_one();
+    }
+}
+
+void BDSSamplerEventPrefetcher::Get(G4long index, BDSSamplerEvent& event)
+{
+  index = index % nEventsInFile;
+  G4bool restart = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    restart = index != nextIndexExpected;
+  }
+  if (restart)
+    {// a jump in the file - throw away what we have and start again from there
+      Stop();
+      Start(index);
+    }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  notEmpty.wait(lock, [this]{return !buffer.empty() || workerError;});
+  if (buffer.empty() && workerError)
+    {std::rethrow_exception(workerError);}
+  event = std::move(buffer.front());
+  buffer.pop_front();
+  nextIndexExpected = (index + 1) % nEventsInFile;
+  lock.unlock();
+  notFull.notify_one();
+}
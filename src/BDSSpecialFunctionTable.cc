@@ -0,0 +1,90 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSSpecialFunctionTable.hh"
+
+#include "G4Types.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+BDSSpecialFunctionTable::BDSSpecialFunctionTable(const Function& function,
+                                                 G4double        xMinIn,
+                                                 G4double        xMaxIn,
+                                                 G4double        tolerance,
+                                                 G4int           nPointsInitial,
+                                                 G4int           nPointsMaximum):
+  xMin(xMinIn),
+  xMax(xMaxIn),
+  nPoints(0),
+  step(1),
+  stepInverse(1),
+  maximumError(0)
+{
+  if (xMax <= xMin)
+    {throw BDSException(__METHOD_NAME__, "invalid range for table: xMax must be greater than xMin");}
+  if (tolerance <= 0)
+    {throw BDSException(__METHOD_NAME__, "tolerance must be greater than 0");}
+
+  G4int n = std::max(nPointsInitial, 4); // need at least 4 points for a cubic
+  Build(function, n);
+  while (maximumError > tolerance && 2*(n-1)+1 <= nPointsMaximum)
+    {
+      n = 2*(n-1) + 1; // keep the existing points and add one in between each
+      Build(function, n);
+    }
+  if (maximumError > tolerance)
+    {
+      std::ostringstream msg;
+      msg << "maximum interpolation error " << maximumError << " with " << nPoints
+          << " points is greater than the tolerance " << tolerance << " for the range ["
+          << xMin << ", " << xMax << "]";
+      throw BDSException(__METHOD_NAME__, msg.str());
+    }
+}
+
+void BDSSpecialFunctionTable::Build(const Function& function,
+                                    G4int           nPointsIn)
+{
+  nPoints     = nPointsIn;
+  step        = (xMax - xMin) / (G4double)(nPoints - 1);
+  stepInverse = 1.0 / step;
+  values.resize((std::size_t)nPoints);
+  for (G4int i = 0; i < nPoints; i++)
+    {values[(std::size_t)i] = function(xMin + (G4double)i*step);}
+
+  // check in between every pair of points - the error of the cubic is largest in the middle
+  // of an interval inside the table and at (3 -+ sqrt(5))/2 of the first and last intervals
+  maximumError = 0;
+  for (G4int i = 0; i < nPoints - 1; i++)
+    {
+      for (G4double f : {0.25, 0.381966, 0.5, 0.618034, 0.75})
+        {
+          G4double x = xMin + ((G4double)i + f)*step;
+          G4double error = std::abs((*this)(x) - function(x));
+          if (!std::isfinite(error))
+            {throw BDSException(__METHOD_NAME__, "function is not finite at x = " + std::to_string(x));}
+          maximumError = std::max(maximumError, error);
+        }
+    }
+}
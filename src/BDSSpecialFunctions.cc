@@ -16,6 +16,7 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSSpecialFunctionTable.hh"
 #include "BDSSpecialFunctions.hh"
 #include "BDSUtilities.hh"
 
@@ -23,7 +24,33 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include "TMath.h"
+
 #include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+  /// Get a table for a given tolerance from a cache or build it. The tables are only
+  /// read after construction so may be shared between threads.
+  const BDSSpecialFunctionTable* CachedTable(std::map<G4double, std::unique_ptr<BDSSpecialFunctionTable> >& cache,
+                                             const BDSSpecialFunctionTable::Function& function,
+                                             G4double xMin,
+                                             G4double xMax,
+                                             G4double tolerance)
+  {
+    static std::mutex tableMutex;
+    std::lock_guard<std::mutex> lock(tableMutex);
+    auto search = cache.find(tolerance);
+    if (search != cache.end())
+      {return search->second.get();}
+    auto table = new BDSSpecialFunctionTable(function, xMin, xMax, tolerance);
+    cache[tolerance] = std::unique_ptr<BDSSpecialFunctionTable>(table);
+    return table;
+  }
+}
 
 G4double BDS::CEL(G4double kc,
                   G4double p,
@@ -82,3 +109,32 @@ G4double BDS::CEL(G4double kc,
   G4double result = CLHEP::halfpi*(ss + cc*em)/( em*(em + pp) );
   return result;
 }
+
+G4double BDS::BesselJ0(G4double x)
+{
+  return TMath::BesselJ0(x);
+}
+
+G4double BDS::BesselJ1(G4double x)
+{
+  return TMath::BesselJ1(x);
+}
+
+const BDSSpecialFunctionTable* BDS::BesselJ0Table(G4double tolerance)
+{
+  static std::map<G4double, std::unique_ptr<BDSSpecialFunctionTable> > cache;
+  return CachedTable(cache, BDS::BesselJ0, 0, BDS::besselJ0FirstZero, tolerance);
+}
+
+const BDSSpecialFunctionTable* BDS::BesselJ1Table(G4double tolerance)
+{
+  static std::map<G4double, std::unique_ptr<BDSSpecialFunctionTable> > cache;
+  return CachedTable(cache, BDS::BesselJ1, 0, BDS::besselJ0FirstZero, tolerance);
+}
+
+const BDSSpecialFunctionTable* BDS::CELRadialTable(G4double tolerance)
+{
+  static std::map<G4double, std::unique_ptr<BDSSpecialFunctionTable> > cache;
+  auto cel = [](G4double kc){return BDS::CEL(kc, 1, 1, -1);};
+  return CachedTable(cache, cel, BDS::CELRadialTableKcMinimum, 1.0, tolerance);
+}
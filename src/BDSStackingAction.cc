@@ -17,23 +17,29 @@ You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSDebug.hh"
+#include "BDSEventBudget.hh"
 #include "BDSGlobalConstants.hh"
 #include "BDSMultiSensitiveDetectorOrdered.hh"
 #include "BDSRunManager.hh"
 #include "BDSSDEnergyDeposition.hh"
 #include "BDSSDEnergyDepositionGlobal.hh"
 #include "BDSStackingAction.hh"
+#include "BDSTrackKillRules.hh"
+#include "BDSWeightWindowMesh.hh"
 
 #include "globals.hh" // geant4 globals / types
 #include "G4Run.hh"
 #include "G4Event.hh"
+#include "G4LogicalVolume.hh"
 #include "G4ThreeVector.hh"
 #include "G4Track.hh"
 #include "G4TrackStatus.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4ParticleTypes.hh"
+#include "G4VPhysicalVolume.hh"
 #include "G4VSensitiveDetector.hh"
 #include "G4Version.hh"
+#include "Randomize.hh"
 
 #if G4VERSION_NUMBER > 1029
 #include "G4MultiSensitiveDetector.hh"
@@ -41,7 +47,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 G4double BDSStackingAction::energyKilled = 0;
 
-BDSStackingAction::BDSStackingAction(const BDSGlobalConstants* globals)
+BDSStackingAction::BDSStackingAction(const BDSGlobalConstants* globals):
+  weightWindows(nullptr),
+  killRules(nullptr),
+  eventBudget(nullptr)
 {
   killNeutrinos     = globals->KillNeutrinos();
   stopSecondaries   = globals->StopSecondaries();
@@ -90,63 +99,99 @@ G4ClassificationOfNewTrack BDSStackingAction::ClassifyNewTrack(const G4Track * a
   if (stopSecondaries && (aTrack->GetParentID() > 0))
     {classification = fKill;}
 
+  // Kill everything once the event has exceeded its budget
+  if (eventBudget && eventBudget->Truncated())
+    {classification = fKill;}
+
+  // Optionally kill according to user defined rules
+  if (killRules && classification != fKill)
+    {
+      G4int rule = killRules->Match(aTrack, aTrack->GetVolume());
+      if (rule >= 0)
+        {
+          classification = fKill;
+          killRules->RecordKill(rule, aTrack);
+        }
+    }
+
+  // Russian roulette for new tracks below their weight window. The weight of the survivors
+  // conserves the energy on average so the killed ones aren't recorded below. Splitting
+  // happens on the first step in the stepping action.
+  if (weightWindows && classification != fKill)
+    {
+      G4double lowerBound = weightWindows->LowerBound(aTrack->GetPosition(), aTrack->GetKineticEnergy());
+      G4double weight = aTrack->GetWeight();
+      if (weight < lowerBound)
+        {
+          G4double survivalWeight = weightWindows->SurvivalWeight(lowerBound);
+          if (G4UniformRand() * survivalWeight < weight)
+            {const_cast<G4Track*>(aTrack)->SetWeight(survivalWeight);} // not yet stacked so safe to modify
+          else
+            {return fKill;}
+        }
+    }
+
   // Here we must take care of energy conservation. If we artificially kill the track
-  // we should record its loss as energy deposition. Find if the volume is sensitive
-  // and if so record the track there. Note a track is not a step and is a snap shot at
-  // one particular point. Therefore, it has a different method in BDSSDEnergyDeposition.
+  // we should record its loss as energy deposition.
   if (classification == fKill)
+    {RecordKilledTrackEnergy(aTrack, aTrack->GetVolume());}
+  
+  return classification;
+}
+
+void BDSStackingAction::RecordKilledTrackEnergy(const G4Track* track,
+                                                G4VPhysicalVolume* pv)
+{
+  // Find if the volume is sensitive and if so record the track there. Note a track is not
+  // a step and is a snap shot at one particular point. Therefore, it has a different method
+  // in BDSSDEnergyDeposition.
+  if (pv)
     {
-      G4VPhysicalVolume* pv = aTrack->GetVolume();
-      if (pv)
+      G4VSensitiveDetector* sd = pv->GetLogicalVolume()->GetSensitiveDetector();
+      if (sd) // SD optional attachment to logical volume
 	{
-	  G4VSensitiveDetector* sd = pv->GetLogicalVolume()->GetSensitiveDetector();
-	  if (sd) // SD optional attachment to logical volume
-	    {
-	      if (auto ecSD = dynamic_cast<BDSSDEnergyDeposition*>(sd))
-		{ecSD->ProcessHitsTrack(aTrack, nullptr);}
+	  if (auto ecSD = dynamic_cast<BDSSDEnergyDeposition*>(sd))
+	    {ecSD->ProcessHitsTrack(track, nullptr);}
 #if G4VERSION_NUMBER > 1029
-	      else if (auto mSD = dynamic_cast<G4MultiSensitiveDetector*>(sd))
+	  else if (auto mSD = dynamic_cast<G4MultiSensitiveDetector*>(sd))
+	    {
+	      for (G4int i=0; i < (G4int)mSD->GetSize(); ++i)
 		{
-		  for (G4int i=0; i < (G4int)mSD->GetSize(); ++i)
+		  if (auto ecSD2 = dynamic_cast<BDSSDEnergyDeposition*>(mSD->GetSD(i)))
+		    {ecSD2->ProcessHitsTrack(track, nullptr);}
+		  if (auto egSD = dynamic_cast<BDSSDEnergyDepositionGlobal*>(mSD->GetSD(i)))
+		    {egSD->ProcessHitsTrack(track, nullptr);}
+		  else if (auto mSDO = dynamic_cast<BDSMultiSensitiveDetectorOrdered*>(sd))
 		    {
-		      if (auto ecSD2 = dynamic_cast<BDSSDEnergyDeposition*>(mSD->GetSD(i)))
-			{ecSD2->ProcessHitsTrack(aTrack, nullptr);}
-		      if (auto egSD = dynamic_cast<BDSSDEnergyDepositionGlobal*>(mSD->GetSD(i)))
-			{egSD->ProcessHitsTrack(aTrack, nullptr);}
-		      else if (auto mSDO = dynamic_cast<BDSMultiSensitiveDetectorOrdered*>(sd))
+		      for (G4int j=0; j < (G4int)mSDO->GetSize(); ++j)
 			{
-			  for (G4int j=0; j < (G4int)mSDO->GetSize(); ++j)
-			    {
-			      if (auto ecSD3 = dynamic_cast<BDSSDEnergyDeposition*>(mSDO->GetSD(j)))
-				{ecSD3->ProcessHitsTrack(aTrack, nullptr);}
-			      // else another SD -> don't use -> based on which SDs are constructed with BDSMultiSensitiveDetectorOrdered
-			      // in BDSSDManager. e.g. we dont' need BDSSDEnergyDepositionGlobal here
-			    }
-			  // else another SD -> don't use
+			  if (auto ecSD3 = dynamic_cast<BDSSDEnergyDeposition*>(mSDO->GetSD(j)))
+			    {ecSD3->ProcessHitsTrack(track, nullptr);}
+			  // else another SD -> don't use -> based on which SDs are constructed with BDSMultiSensitiveDetectorOrdered
+			  // in BDSSDManager. e.g. we dont' need BDSSDEnergyDepositionGlobal here
 			}
+		      // else another SD -> don't use
 		    }
 		}
+	    }
 #endif
-	      else if (auto mSDO = dynamic_cast<BDSMultiSensitiveDetectorOrdered*>(sd))
+	  else if (auto mSDO = dynamic_cast<BDSMultiSensitiveDetectorOrdered*>(sd))
+	    {
+	      for (G4int i=0; i < (G4int)mSDO->GetSize(); ++i)
 		{
-		  for (G4int i=0; i < (G4int)mSDO->GetSize(); ++i)
-		    {
-		      if (auto ecSD2 = dynamic_cast<BDSSDEnergyDeposition*>(mSDO->GetSD(i)))
-			{ecSD2->ProcessHitsTrack(aTrack, nullptr);}
-		      // else another SD -> don't use
-		    }
+		  if (auto ecSD2 = dynamic_cast<BDSSDEnergyDeposition*>(mSDO->GetSD(i)))
+		    {ecSD2->ProcessHitsTrack(track, nullptr);}
+		  // else another SD -> don't use
 		}
-	      else
-		{energyKilled += aTrack->GetTotalEnergy();} // no suitable SD, but add up anyway
 	    }
 	  else
-	    {energyKilled += aTrack->GetTotalEnergy();} // no SD, but add up anyway
+	    {energyKilled += track->GetTotalEnergy();} // no suitable SD, but add up anyway
 	}
       else
-	{energyKilled += aTrack->GetTotalEnergy();} // no PV - unusual but possible - add up anyway
+	{energyKilled += track->GetTotalEnergy();} // no SD, but add up anyway
     }
-  
-  return classification;
+  else
+    {energyKilled += track->GetTotalEnergy();} // no PV - unusual but possible - add up anyway
 }
 
 void BDSStackingAction::NewStage()
@@ -16,23 +16,40 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSEventBudget.hh"
+#include "BDSEventProfiler.hh"
+#include "BDSStackingAction.hh"
 #include "BDSSteppingAction.hh"
+#include "BDSTrackKillRules.hh"
 #include "BDSUtilities.hh"
+#include "BDSWeightWindowMesh.hh"
 
 #include "globals.hh"
+#include "G4DynamicParticle.hh"
 #include "G4Event.hh"
 #include "G4EventManager.hh"
 #include "G4LogicalVolume.hh"
+#include "G4StackManager.hh"
+#include "G4StepPoint.hh"
+#include "G4StepStatus.hh"
+#include "G4SteppingManager.hh"
 #include "G4ThreeVector.hh"
 #include "G4Track.hh"
+#include "G4TrackStatus.hh"
+#include "G4TrackVector.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4VProcess.hh"
+#include "Randomize.hh"
 
 
 BDSSteppingAction::BDSSteppingAction():
   verboseStep(false),
   verboseEventStart(false),
-  verboseEventStop(false)
+  verboseEventStop(false),
+  weightWindows(nullptr),
+  killRules(nullptr),
+  eventBudget(nullptr),
+  eventProfiler(nullptr)
 {;}
 
 BDSSteppingAction::BDSSteppingAction(G4bool verboseStepIn,
@@ -40,7 +57,11 @@ BDSSteppingAction::BDSSteppingAction(G4bool verboseStepIn,
 				     G4int  verboseEventStopIn):
   verboseStep(verboseStepIn),
   verboseEventStart(verboseEventStartIn),
-  verboseEventStop(verboseEventStopIn)
+  verboseEventStop(verboseEventStopIn),
+  weightWindows(nullptr),
+  killRules(nullptr),
+  eventBudget(nullptr),
+  eventProfiler(nullptr)
 {;}
 
 BDSSteppingAction::~BDSSteppingAction()
@@ -48,6 +69,17 @@ BDSSteppingAction::~BDSSteppingAction()
 
 void BDSSteppingAction::UserSteppingAction(const G4Step* step)
 {
+  if (eventProfiler)
+    {eventProfiler->Step(step);}
+  if (eventBudget && eventBudget->Step())
+    {
+      TruncateEvent(step);
+      return;
+    }
+  if (killRules)
+    {ApplyKillRules(step);}
+  if (weightWindows)
+    {ApplyWeightWindow(step);}
   if (!verboseStep)
     {return;}
   G4int eventID = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
@@ -88,3 +120,81 @@ void BDSSteppingAction::VerboseSteppingAction(const G4Step* step)
   // set precision back
   G4cout.precision(G4precision);
 }
+
+void BDSSteppingAction::ApplyWeightWindow(const G4Step* step)
+{
+  G4Track* track = step->GetTrack();
+  if (track->GetTrackStatus() != fAlive)
+    {return;}
+  
+  G4double lowerBound = weightWindows->LowerBound(track->GetPosition(), track->GetKineticEnergy());
+  if (lowerBound <= 0)
+    {return;} // outside mesh or no window
+  
+  G4double weight = track->GetWeight();
+  if (weight < lowerBound)
+    {// Russian roulette - the energy is conserved on average by the weight of the survivors
+      G4double survivalWeight = weightWindows->SurvivalWeight(lowerBound);
+      if (G4UniformRand() * survivalWeight < weight)
+        {track->SetWeight(survivalWeight);}
+      else
+        {track->SetTrackStatus(fStopAndKill);}
+      return;
+    }
+
+  G4int nSplit = weightWindows->NSplit(weight, lowerBound);
+  if (nSplit < 2)
+    {return;}
+
+  // split into identical copies at this point that are given to the stack as secondaries
+  G4double newWeight = weight / (G4double)nSplit;
+  track->SetWeight(newWeight);
+  G4TrackVector* secondaries = fpSteppingManager->GetfSecondary();
+  for (G4int i = 1; i < nSplit; i++)
+    {
+      G4Track* copy = new G4Track(new G4DynamicParticle(*track->GetDynamicParticle()),
+                                  track->GetGlobalTime(),
+                                  track->GetPosition());
+      copy->SetWeight(newWeight);
+      copy->SetParentID(track->GetTrackID());
+      copy->SetTouchableHandle(track->GetTouchableHandle());
+      copy->SetCreatorProcess(track->GetCreatorProcess());
+      secondaries->push_back(copy);
+    }
+}
+
+void BDSSteppingAction::ApplyKillRules(const G4Step* step)
+{
+  const G4StepPoint* postStepPoint = step->GetPostStepPoint();
+  if (postStepPoint->GetStepStatus() != fGeomBoundary)
+    {return;}
+  G4Track* track = step->GetTrack();
+  if (track->GetTrackStatus() != fAlive)
+    {return;}
+
+  G4VPhysicalVolume* pv = postStepPoint->GetPhysicalVolume();
+  G4int rule = killRules->Match(track, pv);
+  if (rule < 0)
+    {return;}
+  track->SetTrackStatus(fStopAndKill);
+  killRules->RecordKill(rule, track);
+  BDSStackingAction::RecordKilledTrackEnergy(track, pv);
+}
+
+void BDSSteppingAction::TruncateEvent(const G4Step* step)
+{
+  G4Track* track = step->GetTrack();
+  G4TrackStatus status = track->GetTrackStatus();
+  if (status == fAlive || status == fStopButAlive)
+    {
+      track->SetTrackStatus(fStopAndKill);
+      BDSStackingAction::RecordKilledTrackEnergy(track, step->GetPostStepPoint()->GetPhysicalVolume());
+    }
+
+  // Reclassify all tracks waiting to be tracked. As the event is now truncated, the stacking
+  // action kills them and records their energy. Secondaries from this step are killed as they
+  // are stacked.
+  G4StackManager* stackManager = G4EventManager::GetEventManager()->GetStackManager();
+  stackManager->TransferStackedTracks(fUrgent, fWaiting);
+  stackManager->ReClassify();
+}
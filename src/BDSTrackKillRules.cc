@@ -0,0 +1,162 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSAuxiliaryNavigator.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSPhysicalVolumeInfo.hh"
+#include "BDSPhysicalVolumeInfoRegistry.hh"
+#include "BDSStep.hh"
+#include "BDSTrackKillRules.hh"
+#include "BDSUtilities.hh"
+
+#include "globals.hh"
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4String.hh"
+#include "G4ThreeVector.hh"
+#include "G4Track.hh"
+#include "G4Types.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include "parser/killrule.h"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <iomanip>
+#include <stdexcept>
+#include <vector>
+
+BDSTrackKillRules::BDSTrackKillRules(const std::vector<GMAD::KillRule>& parserRules):
+  auxNavigator(new BDSAuxiliaryNavigator())
+{
+  for (const auto& pr : parserRules)
+    {
+      Rule rule;
+      rule.name = G4String(pr.name);
+      for (const auto& word : BDS::SplitOnWhiteSpace(G4String(pr.particles)))
+        {
+          try
+            {rule.pdgIDs.insert(std::stoi(word));}
+          catch (const std::logic_error&)
+            {throw BDSException(__METHOD_NAME__, "particle ID \"" + word + "\" in killrule \"" + rule.name + "\" cannot be converted to an integer");}
+        }
+      rule.kineticEnergy = pr.kineticEnergy * CLHEP::GeV;
+      if (rule.kineticEnergy < 0)
+        {throw BDSException(__METHOD_NAME__, "kineticEnergy must be >= 0 in killrule \"" + rule.name + "\"");}
+      rule.useS   = pr.sEnd > pr.sBegin;
+      rule.sBegin = pr.sBegin * CLHEP::m;
+      rule.sEnd   = pr.sEnd * CLHEP::m;
+      for (const auto& word : BDS::SplitOnWhiteSpace(G4String(pr.elements)))
+        {rule.elements.insert(word);}
+      rule.region = nullptr;
+      if (!pr.region.empty())
+        {
+          rule.region = G4RegionStore::GetInstance()->GetRegion(G4String(pr.region), false);
+          if (!rule.region)
+            {throw BDSException(__METHOD_NAME__, "region \"" + pr.region + "\" in killrule \"" + rule.name + "\" not found");}
+        }
+      rule.secondariesOnly = pr.secondariesOnly;
+      rule.nKilled      = 0;
+      rule.energyKilled = 0;
+      rules.push_back(rule);
+    }
+}
+
+BDSTrackKillRules::~BDSTrackKillRules()
+{
+  delete auxNavigator;
+}
+
+G4int BDSTrackKillRules::Match(const G4Track* track, G4VPhysicalVolume* pv) const
+{
+  G4int    pdgID  = track->GetDefinition()->GetPDGEncoding();
+  G4double ek     = track->GetKineticEnergy();
+  G4bool   isPrimary = track->GetParentID() == 0;
+
+  // only look up the position in the beam line once and if required
+  G4bool   located = false;
+  G4bool   inBeamLine = false;
+  G4double s = 0;
+  G4String element;
+  
+  for (G4int i = 0; i < (G4int)rules.size(); i++)
+    {
+      const Rule& rule = rules[i];
+      if (rule.secondariesOnly && isPrimary)
+        {continue;}
+      if (!rule.pdgIDs.empty() && rule.pdgIDs.count(pdgID) == 0)
+        {continue;}
+      if (rule.kineticEnergy > 0 && ek >= rule.kineticEnergy)
+        {continue;}
+      if (rule.region)
+        {
+          if (!pv || pv->GetLogicalVolume()->GetRegion() != rule.region)
+            {continue;}
+        }
+      if (rule.useS || !rule.elements.empty())
+        {
+          if (!located)
+            {
+              inBeamLine = Locate(track, s, element);
+              located = true;
+            }
+          if (!inBeamLine)
+            {continue;}
+          if (rule.useS && (s < rule.sBegin || s > rule.sEnd))
+            {continue;}
+          if (!rule.elements.empty() && rule.elements.count(element) == 0)
+            {continue;}
+        }
+      return i;
+    }
+  return -1;
+}
+
+G4bool BDSTrackKillRules::Locate(const G4Track* track, G4double& s, G4String& element) const
+{
+  // as BDSSDEnergyDeposition::ProcessHitsTrack
+  BDSStep stepLocal = auxNavigator->ConvertToLocal(track->GetPosition(), track->GetMomentumDirection(),
+                                                   1*CLHEP::mm, true, 1*CLHEP::mm);
+  BDSPhysicalVolumeInfo* info = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(stepLocal.VolumeForTransform());
+  if (!info)
+    {return false;}
+  s = info->GetSPos() + stepLocal.PreStepPoint().z();
+  element = info->GetName();
+  return true;
+}
+
+void BDSTrackKillRules::RecordKill(G4int ruleIndex, const G4Track* track)
+{
+  Rule& rule = rules[ruleIndex];
+  rule.nKilled++;
+  rule.energyKilled += track->GetTotalEnergy() * track->GetWeight();
+}
+
+void BDSTrackKillRules::PrintSummary() const
+{
+  G4cout << __METHOD_NAME__ << "tracks killed by each killrule:" << G4endl;
+  for (const auto& rule : rules)
+    {
+      G4cout << __METHOD_NAME__ << std::setw(20) << std::left << rule.name << std::right
+             << std::setw(12) << rule.nKilled << " tracks "
+             << std::setw(12) << rule.energyKilled / CLHEP::GeV << " GeV" << G4endl;
+    }
+}
@@ -0,0 +1,63 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSAcceleratorModel.hh"
+#include "BDSEventAction.hh"
+#include "BDSIntegratorMag.hh"
+#include "BDSTrackingActionPrimaryOnly.hh"
+#include "BDSTrajectoryPrimary.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4TrackingManager.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include <set>
+
+BDSTrackingActionPrimaryOnly::BDSTrackingActionPrimaryOnly(const BDS::TrajectoryOptions& storeTrajectoryOptionsIn,
+                                                           BDSEventAction* eventActionIn):
+  storeTrajectoryOptions(storeTrajectoryOptionsIn),
+  eventAction(eventActionIn)
+{
+  collimators = BDSAcceleratorModel::Instance()->VolumeSet("collimators");
+}
+
+void BDSTrackingActionPrimaryOnly::PreUserTrackingAction(const G4Track* track)
+{
+  eventAction->IncrementNTracks();
+  G4bool primaryParticle = track->GetParentID() == 0;
+  BDSIntegratorMag::currentTrackIsPrimary = primaryParticle;
+  if (primaryParticle)
+    {// no trajectory points - only the first hit and last point
+      auto traj = new BDSTrajectoryPrimary(track, false, storeTrajectoryOptions, false);
+      eventAction->RegisterPrimaryTrajectory(traj);
+      fpTrackingManager->SetStoreTrajectory(1);
+      fpTrackingManager->SetTrajectory(traj);
+    }
+  else
+    {fpTrackingManager->SetStoreTrajectory(0);}
+}
+
+void BDSTrackingActionPrimaryOnly::PostUserTrackingAction(const G4Track* track)
+{
+  if (track->GetParentID() == 0)
+    {
+      if (collimators->count(track->GetVolume()->GetLogicalVolume()) > 0)
+	{eventAction->SetPrimaryAbsorbedInCollimator(true);}
+    }
+}
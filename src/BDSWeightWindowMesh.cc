@@ -0,0 +1,218 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSScorerMeshInfo.hh"
+#include "BDSUtilities.hh"
+#include "BDSWeightWindowMesh.hh"
+
+#include "globals.hh"
+#include "G4Point3D.hh"
+#include "G4String.hh"
+#include "G4ThreeVector.hh"
+#include "G4Transform3D.hh"
+#include "G4Types.hh"
+
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+BDSWeightWindowMesh::BDSWeightWindowMesh(const BDSScorerMeshInfo& recipe,
+                                         const G4Transform3D&     placement,
+                                         const G4String&          windowFileName,
+                                         G4double                 upperRatioIn,
+                                         G4double                 survivalRatioIn,
+                                         G4int                    maximumSplitIn):
+  name(recipe.name),
+  cylindrical(recipe.geometryType == "cylindrical"),
+  globalToLocal(placement.inverse()),
+  nGroups(1),
+  upperRatio(upperRatioIn),
+  survivalRatio(survivalRatioIn),
+  maximumSplit(maximumSplitIn)
+{
+  if (upperRatio <= 1)
+    {throw BDSException(__METHOD_NAME__, "weightWindowUpperRatio must be > 1");}
+  if (survivalRatio < 1 || survivalRatio > upperRatio)
+    {throw BDSException(__METHOD_NAME__, "weightWindowSurvivalRatio must be between 1 and weightWindowUpperRatio");}
+  if (maximumSplit < 1)
+    {throw BDSException(__METHOD_NAME__, "weightWindowMaximumSplit must be >= 1");}
+  
+  if (cylindrical)
+    {
+      nI   = recipe.nBinsR;
+      nJ   = recipe.nBinsPhi;
+      lowI = recipe.rLow;
+      lowJ = 0;
+      invWidthI = nI / (recipe.rHigh - recipe.rLow);
+      invWidthJ = nJ / CLHEP::twopi;
+    }
+  else
+    {
+      nI   = recipe.nBinsX;
+      nJ   = recipe.nBinsY;
+      lowI = recipe.xLow;
+      lowJ = recipe.yLow;
+      invWidthI = nI / (recipe.xHigh - recipe.xLow);
+      invWidthJ = nJ / (recipe.yHigh - recipe.yLow);
+    }
+  nK   = recipe.nBinsZ;
+  lowK = recipe.zLow;
+  invWidthK = nK / (recipe.zHigh - recipe.zLow);
+
+  // energy groups are the energy bins of the mesh
+  if (recipe.nBinsE > 1)
+    {
+      nGroups = recipe.nBinsE;
+      if (recipe.eScale == "user")
+        {
+          for (auto edge : recipe.eBinsEdges)
+            {energyEdges.push_back(edge * CLHEP::GeV);}
+        }
+      else if (recipe.eScale == "log")
+        {
+          if (recipe.eLow <= 0)
+            {throw BDSException(__METHOD_NAME__, "eLow must be > 0 for a log energy scale in mesh \"" + name + "\"");}
+          for (G4int i = 0; i <= nGroups; i++)
+            {energyEdges.push_back(recipe.eLow * std::pow(recipe.eHigh / recipe.eLow, (G4double)i / nGroups));}
+        }
+      else
+        {
+          for (G4int i = 0; i <= nGroups; i++)
+            {energyEdges.push_back(recipe.eLow + i * (recipe.eHigh - recipe.eLow) / nGroups);}
+        }
+    }
+
+  lowerBounds.resize((std::size_t)nI * nJ * nK * nGroups, 0);
+  Load(windowFileName);
+}
+
+void BDSWeightWindowMesh::Load(const G4String& fileName)
+{
+  if (fileName.empty())
+    {throw BDSException(__METHOD_NAME__, "weightWindowFile must be specified with weightWindowMesh");}
+  G4String fullPath = BDS::GetFullPath(fileName);
+  std::ifstream file(fullPath);
+  if (!file.is_open())
+    {throw BDSException(__METHOD_NAME__, "Cannot open file \"" + fullPath + "\"");}
+  G4cout << __METHOD_NAME__ << "loading \"" << fullPath << "\"" << G4endl;
+
+  std::string line;
+  G4int lineNum = 0;
+  G4int nCells  = 0;
+  while (std::getline(file, line))
+    {
+      lineNum++;
+      if (std::all_of(line.begin(), line.end(), isspace))
+        {continue;}
+      std::istringstream liness(line);
+      std::string first;
+      liness >> first;
+      if (first[0] == '#')
+        {continue;}
+
+      G4String lineError = " in line " + std::to_string(lineNum) + " of weightWindowFile \"" + fileName + "\"";
+      G4int i = 0;
+      G4int j = 0;
+      G4int k = 0;
+      try
+        {i = std::stoi(first);}
+      catch (...)
+        {throw BDSException(__METHOD_NAME__, "invalid cell index \"" + first + "\"" + lineError);}
+      if (!(liness >> j >> k))
+        {throw BDSException(__METHOD_NAME__, "invalid cell indices" + lineError);}
+      if (i < 0 || i >= nI || j < 0 || j >= nJ || k < 0 || k >= nK)
+        {throw BDSException(__METHOD_NAME__, "cell index outside mesh \"" + name + "\"" + lineError);}
+
+      std::size_t offset = (((std::size_t)k * nJ + j) * nI + i) * nGroups;
+      for (G4int g = 0; g < nGroups; g++)
+        {
+          G4double value = 0;
+          if (!(liness >> value))
+            {throw BDSException(__METHOD_NAME__, std::to_string(nGroups) + " lower bounds expected" + lineError);}
+          if (value < 0)
+            {throw BDSException(__METHOD_NAME__, "lower bound must be >= 0" + lineError);}
+          lowerBounds[offset + g] = value;
+        }
+      std::string remainder;
+      if (liness >> remainder)
+        {throw BDSException(__METHOD_NAME__, "unknown value \"" + remainder + "\"" + lineError);}
+      nCells++;
+    }
+
+  G4cout << __METHOD_NAME__ << "loaded weight windows for " << nCells << " of "
+         << nI * nJ * nK << " cells with " << nGroups << " energy group(s)" << G4endl;
+}
+
+G4int BDSWeightWindowMesh::CellIndex(const G4ThreeVector& localPosition) const
+{
+  G4double u;
+  G4double v;
+  if (cylindrical)
+    {
+      u = localPosition.perp();
+      v = localPosition.phi();
+      if (v < 0)
+        {v += CLHEP::twopi;}
+    }
+  else
+    {
+      u = localPosition.x();
+      v = localPosition.y();
+    }
+  G4int i = (G4int)std::floor((u - lowI) * invWidthI);
+  G4int j = (G4int)std::floor((v - lowJ) * invWidthJ);
+  G4int k = (G4int)std::floor((localPosition.z() - lowK) * invWidthK);
+  if (i < 0 || i >= nI || j < 0 || j >= nJ || k < 0 || k >= nK)
+    {return -1;}
+  return (k * nJ + j) * nI + i;
+}
+
+G4int BDSWeightWindowMesh::EnergyGroup(G4double kineticEnergy) const
+{
+  if (energyEdges.empty())
+    {return 0;}
+  G4int group = (G4int)(std::upper_bound(energyEdges.begin(), energyEdges.end(), kineticEnergy) - energyEdges.begin()) - 1;
+  return std::min(std::max(group, 0), nGroups - 1);
+}
+
+G4double BDSWeightWindowMesh::LowerBound(const G4ThreeVector& globalPosition,
+                                         G4double             kineticEnergy) const
+{
+  G4Point3D local = globalToLocal * G4Point3D(globalPosition);
+  G4int cell = CellIndex(G4ThreeVector(local.x(), local.y(), local.z()));
+  if (cell < 0)
+    {return 0;}
+  return lowerBounds[(std::size_t)cell * nGroups + EnergyGroup(kineticEnergy)];
+}
+
+G4int BDSWeightWindowMesh::NSplit(G4double weight, G4double lowerBound) const
+{
+  G4double upperBound = UpperBound(lowerBound);
+  if (weight <= upperBound)
+    {return 1;}
+  return (G4int)std::min((G4double)maximumSplit, std::ceil(weight / upperBound));
+}
@@ -0,0 +1,124 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSWrapperProcessSplitting.hh"
+
+#include "G4ParticleDefinition.hh"
+#include "G4Track.hh"
+#include "G4Types.hh"
+#include "G4VParticleChange.hh"
+#include "G4VProcess.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+BDSWrapperProcessSplitting::BDSWrapperProcessSplitting(G4VProcess* originalProcess,
+                                                       const std::vector<ProductSplitting>& productsIn):
+  BDSWrapperProcess("ProcessSplittingWrapper"),
+  products(productsIn),
+  nSplit(productsIn.size(), 1),
+  nSplitInteractions(0)
+{
+  RegisterProcess(originalProcess);
+  theProcessSubType = originalProcess->GetProcessSubType();
+  theProcessName = "ProcessSplittingWrapper("+originalProcess->GetProcessName()+")";
+}
+
+G4int BDSWrapperProcessSplitting::Group(G4int pdgID) const
+{
+  for (G4int i = 0; i < (G4int)products.size(); i++)
+    {
+      if (products[i].pdgIDs.empty() || products[i].pdgIDs.count(pdgID) > 0)
+        {return i;}
+    }
+  return -1;
+}
+
+G4VParticleChange* BDSWrapperProcessSplitting::PostStepDoIt(const G4Track& track,
+                                                            const G4Step& step)
+{
+  // the factors only depend on the parent so are known before sampling the process
+  G4double parentEk = track.GetKineticEnergy();
+  G4int nSplitMax = 1;
+  for (G4int g = 0; g < (G4int)products.size(); g++)
+    {
+      nSplit[g] = std::max(1, static_cast<G4int>(std::round(products[g].factor.Value(parentEk))));
+      nSplitMax = std::max(nSplitMax, nSplit[g]);
+    }
+  if (nSplitMax == 1)
+    {return pRegProcess->PostStepDoIt(track, step);}
+  
+  // Resample the process and keep the products of each group for its first n-1 resamples.
+  // This is done whatever the original interaction produces (even nothing) so the splitting
+  // is unbiased. The resamples are done before the original interaction as the process
+  // (usually) reuses a single particle change object, so the parent final state returned
+  // is that of the original interaction. The tracks kept are managed here.
+  std::vector<G4Track*> resampledSecondaries;
+  std::vector<G4int> resampledGroups;
+  for (G4int iResample = 1; iResample < nSplitMax; iResample++)
+    {
+      G4VParticleChange* resample = pRegProcess->PostStepDoIt(track, step);
+      for (G4int i = 0; i < resample->GetNumberOfSecondaries(); i++)
+        {
+          G4Track* secondary = resample->GetSecondary(i);
+          G4int group = Group(secondary->GetDefinition()->GetPDGEncoding());
+          if (group >= 0 && iResample < nSplit[group])
+            {
+              resampledSecondaries.push_back(secondary);
+              resampledGroups.push_back(group);
+            }
+          else
+            {delete secondary;}
+        }
+      resample->Clear(); // doesn't delete the secondaries
+    }
+  
+  // the original interaction - its secondaries are always kept and those in a group are reweighted below
+  G4VParticleChange* particleChange = pRegProcess->PostStepDoIt(track, step);
+  std::vector<G4Track*> keptSecondaries;
+  std::vector<G4int> keptGroups;
+  for (G4int i = 0; i < particleChange->GetNumberOfSecondaries(); i++)
+    {
+      G4Track* secondary = particleChange->GetSecondary(i);
+      keptSecondaries.push_back(secondary);
+      keptGroups.push_back(Group(secondary->GetDefinition()->GetPDGEncoding()));
+    }
+  particleChange->Clear(); // doesn't delete the secondaries
+  keptSecondaries.insert(keptSecondaries.end(), resampledSecondaries.begin(), resampledSecondaries.end());
+  keptGroups.insert(keptGroups.end(), resampledGroups.begin(), resampledGroups.end());
+  
+  particleChange->SetNumberOfSecondaries(static_cast<G4int>(keptSecondaries.size()));
+  // cache this flag so we can reset it back afterwards
+  G4bool originalSetSecondaryWeightByProcess = particleChange->IsSecondaryWeightSetByProcess();
+  particleChange->SetSecondaryWeightByProcess(true);
+  for (G4int i = 0; i < (G4int)keptSecondaries.size(); i++)
+    {
+      G4Track* secondary = keptSecondaries[i];
+      G4int group = keptGroups[i];
+      if (group >= 0 && nSplit[group] > 1)
+        {secondary->SetWeight(secondary->GetWeight() / static_cast<G4double>(nSplit[group]));}
+      particleChange->AddSecondary(secondary);
+    }
+  // IMPORTANT - we must reset this back to its default value as the process owns
+  // (usually) a single particle change object that it reuses. See BDSWrapperMuonSplitting.
+  particleChange->SetSecondaryWeightByProcess(originalSetSecondaryWeightByProcess);
+  
+  nSplitInteractions++;
+  return particleChange;
+}
@@ -18,7 +18,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSArray2DCoords.hh"
 #include "BDSArray2DCoordsRQuad.hh"
+#include "BDSArray3DCoords.hh"
 #include "BDSArray4D.hh"
+#include "BDSArrayLayoutType.hh"
 #include "BDSException.hh"
 #include "BDSFieldFormat.hh"
 #include "BDSFieldInfo.hh"
@@ -29,6 +31,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSFieldValue.hh"
 #include "BDSIntegratorType.hh"
 #include "BDSInterpolator2D.hh"
+#include "BDSInterpolator3DCubic.hh"
 #include "BDSInterpolatorType.hh"
 
 #include "G4ThreeVector.hh"
@@ -36,12 +39,16 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <chrono>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <ostream>
+#include <random>
 #include <string>
 #include <stdexcept>
 #include <typeinfo>
+#include <vector>
 
 #include "BDSFieldLoaderBDSIM.hh"
 #include "BDSArray2DCoordsTransformed.hh"
@@ -95,6 +102,79 @@ void Query(BDSFieldMag* field,
   ofile2.close();
 }
 
+/// Time cubic interpolation of a large 3D array with each memory layout for random points
+/// and for points along straight tracks as in tracking. Returns false if the layouts don't
+/// give identical results.
+G4bool BenchmarkLayouts()
+{
+  const G4int    n       = 200;   // points per dimension - 96 MB per array in single precision
+  const G4double halfLen = 1*CLHEP::m;
+  const G4int    nQuery  = 200000;
+
+  // points to query - random and along straight tracks with small steps
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<G4double> position(-0.95*halfLen, 0.95*halfLen);
+  std::uniform_real_distribution<G4double> angle(-0.02, 0.02);
+  std::vector<G4ThreeVector> randomPoints;
+  std::vector<G4ThreeVector> trackPoints;
+  for (G4int i = 0; i < nQuery; i++)
+    {randomPoints.emplace_back(position(rng), position(rng), position(rng));}
+  G4ThreeVector point(position(rng), position(rng), -0.95*halfLen);
+  G4ThreeVector direction(angle(rng), angle(rng), 1);
+  for (G4int i = 0; i < nQuery; i++)
+    {
+      point += 1*CLHEP::mm * direction.unit();
+      if (std::abs(point.x()) > 0.95*halfLen || std::abs(point.y()) > 0.95*halfLen || point.z() > 0.95*halfLen)
+        {// start a new track
+          point     = G4ThreeVector(position(rng), position(rng), -0.95*halfLen);
+          direction = G4ThreeVector(angle(rng), angle(rng), 1);
+        }
+      trackPoints.push_back(point);
+    }
+
+  std::vector<std::vector<G4ThreeVector> > results;
+  for (const auto& layout : {BDSArrayLayoutType::linear, BDSArrayLayoutType::brick})
+    {
+      BDSArray3DCoords array(n, n, n, -halfLen, halfLen, -halfLen, halfLen, -halfLen, halfLen);
+      for (G4int z = 0; z < n; z++)
+        {
+          for (G4int y = 0; y < n; y++)
+            {
+              for (G4int x = 0; x < n; x++)
+                {
+                  G4double xs = array.XFromArrayCoords(x) / halfLen;
+                  G4double ys = array.YFromArrayCoords(y) / halfLen;
+                  G4double zs = array.ZFromArrayCoords(z) / halfLen;
+                  array(x,y,z) = BDSFieldValue((FIELDTYPET)(ys*std::cos(3*zs)),
+                                               (FIELDTYPET)(xs*std::cos(3*zs)),
+                                               (FIELDTYPET)(xs*ys*std::sin(3*zs)));
+                }
+            }
+        }
+      array.SetLayout(BDSArrayLayoutType(layout));
+      BDSInterpolator3DCubic interpolator(&array);
+
+      results.emplace_back();
+      auto& result = results.back();
+      result.reserve(2*nQuery);
+      for (const auto* points : {&randomPoints, &trackPoints})
+        {
+          auto start = std::chrono::steady_clock::now();
+          for (const auto& p : *points)
+            {result.push_back(interpolator.GetInterpolatedValue(p.x(), p.y(), p.z()));}
+          std::chrono::duration<G4double> duration = std::chrono::steady_clock::now() - start;
+          G4cout << "Cubic 3D " << n << "^3 " << std::setw(6) << BDSArrayLayoutType(layout)
+                 << (points == &randomPoints ? " random: " : " track:  ")
+                 << std::setw(8) << (G4double)nQuery / duration.count() / 1e6 << " M lookups / s" << G4endl;
+        }
+    }
+
+  G4bool identical = results[0] == results[1];
+  if (!identical)
+    {G4cout << "Layouts give different interpolated values" << G4endl;}
+  return identical;
+}
+
 int main(int /*argc*/, char** /*argv*/)
 {
   const std::string exampleFile2D = "../examples/features/fields/maps_bdsim/2dexample.dat";
@@ -216,5 +296,8 @@ int main(int /*argc*/, char** /*argv*/)
   //BDSArrayCoordOperatorFlip* transform = new BDSArrayCoordOperatorFlip(true, false, false, false);
   //auto transformed = new BDSArray2DCoordsTransformed(result, transform);
 
+  if (!BenchmarkLayouts())
+    {return 1;}
+
   return 0;
 }
@@ -0,0 +1,159 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSPTCMapPolynomial.hh"
+#include "BDSTesterUtilities.hh"
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/// A map term as in the PTC maptable file.
+struct Term
+{
+  G4double coefficient;
+  BDSPTCMapPolynomial::Exponents exponents;
+};
+
+/// Evaluate one output of the map term by term as the map was evaluated before
+/// it was compiled.
+G4double EvaluateWithPow(const std::vector<Term>& terms, const G4double in[5])
+{
+  G4double result = 0;
+  for (const auto& t : terms)
+    {
+      result += t.coefficient
+        * std::pow(in[0], t.exponents[0])
+        * std::pow(in[1], t.exponents[1])
+        * std::pow(in[2], t.exponents[2])
+        * std::pow(in[3], t.exponents[3])
+        * std::pow(in[4], t.exponents[4]);
+    }
+  return result;
+}
+
+/// Build a map with every monomial up to maximumOrder in every output and compare the
+/// compiled evaluation for single and many particles against term by term evaluation.
+G4bool Compare(G4int maximumOrder, G4int nParticles)
+{
+  std::mt19937_64 engine(12345);
+  std::uniform_real_distribution<G4double> coefficient(-1, 1);
+  std::uniform_real_distribution<G4double> coordinate(-1e-3, 1e-3);
+
+  std::array<std::vector<Term>, 5> terms; // for each output
+  BDSPTCMapPolynomial map;
+  BDSPTCMapPolynomial::Exponents e{};
+  for (e[0] = 0; e[0] <= maximumOrder; e[0]++)
+    for (e[1] = 0; e[0]+e[1] <= maximumOrder; e[1]++)
+      for (e[2] = 0; e[0]+e[1]+e[2] <= maximumOrder; e[2]++)
+        for (e[3] = 0; e[0]+e[1]+e[2]+e[3] <= maximumOrder; e[3]++)
+          for (e[4] = 0; e[0]+e[1]+e[2]+e[3]+e[4] <= maximumOrder; e[4]++)
+            {
+              for (G4int o = 0; o < BDSPTCMapPolynomial::nVariables; o++)
+                {
+                  // coefficients of higher order terms are larger as in a real map in metres
+                  G4int order = e[0]+e[1]+e[2]+e[3]+e[4];
+                  Term t{coefficient(engine) * std::pow(10.0, order), e};
+                  terms[o].push_back(t);
+                  map.AddTerm(o, t.coefficient, t.exponents);
+                }
+            }
+  map.Compile();
+
+  const std::size_t n = (std::size_t)nParticles;
+  std::array<std::vector<G4double>, 5> in;
+  for (auto& v : in)
+    {
+      v.resize(n);
+      for (auto& value : v)
+        {value = coordinate(engine);}
+    }
+
+  std::array<std::vector<G4double>, 5> outPow, outSingle, outMany;
+  for (G4int o = 0; o < 5; o++)
+    {
+      outPow[o].resize(n);
+      outSingle[o].resize(n);
+      outMany[o].resize(n);
+    }
+
+  G4double tPow = BDSTester::NanosecondsPerItem([&]
+    {
+      for (std::size_t i = 0; i < n; i++)
+        {
+          G4double point[5] = {in[0][i], in[1][i], in[2][i], in[3][i], in[4][i]};
+          for (G4int o = 0; o < 5; o++)
+            {outPow[o][i] = EvaluateWithPow(terms[o], point);}
+        }
+    }, (G4double)n);
+  G4double tSingle = BDSTester::NanosecondsPerItem([&]
+    {
+      for (std::size_t i = 0; i < n; i++)
+        {
+          G4double point[5] = {in[0][i], in[1][i], in[2][i], in[3][i], in[4][i]};
+          G4double result[5];
+          map.Evaluate(point, result);
+          for (G4int o = 0; o < 5; o++)
+            {outSingle[o][i] = result[o];}
+        }
+    }, (G4double)n);
+  const G4double* const inP[5]  = {in[0].data(), in[1].data(), in[2].data(), in[3].data(), in[4].data()};
+  G4double* const       outP[5] = {outMany[0].data(), outMany[1].data(), outMany[2].data(),
+                                   outMany[3].data(), outMany[4].data()};
+  G4double tMany = BDSTester::NanosecondsPerItem([&]{map.Evaluate(n, inP, outP);}, (G4double)n);
+
+  // compare relative to the sum of the magnitudes of the terms
+  G4double maximumError = 0;
+  for (G4int o = 0; o < 5; o++)
+    {
+      for (std::size_t i = 0; i < n; i++)
+        {
+          G4double scale = std::max(1.0, std::abs(outPow[o][i]));
+          maximumError = std::max(maximumError, std::abs(outSingle[o][i] - outPow[o][i]) / scale);
+          maximumError = std::max(maximumError, std::abs(outMany[o][i]   - outPow[o][i]) / scale);
+        }
+    }
+
+  G4bool ok = maximumError < 1e-12;
+  G4cout << "order: "       << std::setw(2) << maximumOrder
+         << " terms: "      << std::setw(6) << map.NTerms()
+         << " monomials: "  << std::setw(5) << map.NMonomials()
+         << " max error: "  << std::setw(12) << maximumError
+         << " pow: "        << std::setw(10) << tPow << " ns"
+         << " compiled: "   << std::setw(8) << tSingle << " ns"
+         << " many: "       << std::setw(8) << tMany << " ns per particle"
+         << BDSTester::Result(ok) << G4endl;
+  return ok;
+}
+
+int main(int /*argc*/, char** /*argv*/)
+{
+  return BDSTester::Run([]
+    {
+      G4bool allOK = true;
+      for (G4int order : {1, 3, 6, 9})
+        {allOK = Compare(order, 2000) && allOK;}
+      return allOK;
+    });
+}
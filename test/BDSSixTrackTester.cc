@@ -60,6 +60,7 @@ void ParticleClassTests();
 void BunchTests();
 void AddParticle(BDSBunchSixTrackLink* stp);
 void Summarise(BDSIMLink* bds);
+void BatchTests(BDSIMLink* bds, BDSBunchSixTrackLink* stp, const std::string& elementName);
 
 int main(int /*argc2*/, char** /*argv2*/)
 {
@@ -83,6 +84,7 @@ int main(int /*argc2*/, char** /*argv2*/)
       std::vector<Collimator> collimators;
       collimators = ReadFile("somecollimators.dat");
       
+      bds->BeginLinkElements();
       for (const auto& c : collimators)
 	{
 	  bds->AddLinkCollimatorJaw(c.name,
@@ -94,6 +96,7 @@ int main(int /*argc2*/, char** /*argv2*/)
 				    c.xOffset,
 				    c.yOffset);
 	}
+      bds->EndLinkElements();
       
       for (const auto& collimator : collimators)
 	{
@@ -106,6 +109,9 @@ int main(int /*argc2*/, char** /*argv2*/)
 	  bds->BeamOn((G4int) stp->Size());
 	  Summarise(bds);
 	}
+
+      if (!collimators.empty())
+	{BatchTests(bds, stp, collimators[0].name);}
       
       // test accessing information after construction
       std::cout << "Length of element #6 " << bds->GetChordLengthOfLinkElement(5) << " mm " << std::endl;
@@ -242,3 +248,55 @@ void Summarise(BDSIMLink* bds)
       G4cout << hit->coords << G4endl;
     }
 }
+
+void BatchTests(BDSIMLink* bds, BDSBunchSixTrackLink* stp, const std::string& elementName)
+{
+  const int n = 100;
+  std::vector<double>  x(n), y(n), xp(n, 0), yp(n, 0), energy(n, 123);
+  std::vector<int32_t> pdgID(n, 2212), particleID(n);
+  for (int i = 0; i < n; i++)
+    {
+      x[i] = 1e-3 * (i - n/2) / (double)n;
+      y[i] = -x[i];
+      particleID[i] = 1000 + i;
+    }
+  BDSLinkParticlesIn in = {};
+  in.n = n;
+  in.x = x.data();
+  in.y = y.data();
+  in.xp = xp.data();
+  in.yp = yp.data();
+  in.totalEnergy = energy.data();
+  in.pdgID = pdgID.data();
+  in.particleID = particleID.data();
+
+  bds->ClearSamplerHits();
+  stp->ClearParticles();
+  if (stp->AddParticles(in) != n || (int)stp->Size() != n)
+    {throw std::runtime_error("wrong number of particles added to bunch");}
+  bds->SelectLinkElement(elementName);
+  bds->BeamOn((G4int)stp->Size());
+
+  // deliberately too small to check the capacity is respected
+  const int capacity = 10;
+  std::vector<double>  xOut(capacity), energyOut(capacity);
+  std::vector<int32_t> particleIDOut(capacity, -1);
+  BDSLinkParticlesOut out = {};
+  out.capacity = capacity;
+  out.x = xOut.data();
+  out.totalEnergy = energyOut.data();
+  out.particleID = particleIDOut.data();
+  int nReturned = bds->FillParticleArrays(out);
+
+  const BDSHitsCollectionSamplerLink* hits = bds->SamplerHits();
+  int nHits = hits ? (int)hits->entries() : 0;
+  if (nReturned != nHits)
+    {throw std::runtime_error("batch return count doesn't match sampler hits");}
+  for (int i = 0; i < std::min(nReturned, capacity); i++)
+    {
+      const BDSHitSamplerLink* hit = (*hits)[i];
+      if (particleIDOut[i] != hit->externalParticleID || std::abs(xOut[i] - hit->coords.x / CLHEP::m) > 1e-12)
+	{throw std::runtime_error("batch returned particle doesn't match sampler hit");}
+    }
+  std::cout << "Batch: " << n << " in, " << nReturned << " returned" << std::endl;
+}
@@ -0,0 +1,86 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSSpecialFunctions.hh"
+#include "BDSSpecialFunctionTable.hh"
+#include "BDSTesterUtilities.hh"
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+/// Compare the speed and accuracy of a tabulated special function against the exact
+/// implementation at random points in the range of the table. Returns whether the
+/// measured error is within the requested tolerance.
+G4bool Compare(const G4String& name,
+               const std::function<G4double(G4double)>& exact,
+               const BDSSpecialFunctionTable* table,
+               G4double tolerance,
+               G4int nPoints)
+{
+  std::mt19937_64 engine(12345);
+  std::uniform_real_distribution<G4double> distribution(table->XMin(), table->XMax());
+  std::vector<G4double> x((std::size_t)nPoints);
+  for (auto& v : x)
+    {v = distribution(engine);}
+
+  // accumulate a sum so the compiler can't remove the loops
+  G4double sumExact = 0;
+  G4double tExact = BDSTester::NanosecondsPerItem([&]{for (const auto& v : x) {sumExact += exact(v);}}, nPoints);
+  G4double sumTable = 0;
+  G4double tTable = BDSTester::NanosecondsPerItem([&]{for (const auto& v : x) {sumTable += (*table)(v);}}, nPoints);
+
+  G4double maximumError = 0;
+  for (const auto& v : x)
+    {maximumError = std::max(maximumError, std::abs((*table)(v) - exact(v)));}
+
+  G4bool ok = maximumError <= tolerance;
+  G4cout << std::setw(10) << name
+         << " tolerance: "  << std::setw(8) << tolerance
+         << " points: "     << std::setw(8) << table->NPoints()
+         << " max error: "  << std::setw(12) << maximumError
+         << " exact: "      << std::setw(8) << tExact << " ns"
+         << " table: "      << std::setw(8) << tTable << " ns"
+         << " speed up: "   << std::setw(6) << tExact / tTable
+         << " (sums " << sumExact << ", " << sumTable << ")"
+         << BDSTester::Result(ok) << G4endl;
+  return ok;
+}
+
+int main(int /*argc*/, char** /*argv*/)
+{
+  const G4int nPoints = 1000000;
+  return BDSTester::Run([nPoints]
+    {
+      G4bool allOK = true;
+      auto celRadial = [](G4double kc){return BDS::CEL(kc, 1, 1, -1);};
+      for (G4double tolerance : {1e-6, 1e-9})
+        {
+          allOK = Compare("J0",  BDS::BesselJ0, BDS::BesselJ0Table(tolerance),  tolerance, nPoints) && allOK;
+          allOK = Compare("J1",  BDS::BesselJ1, BDS::BesselJ1Table(tolerance),  tolerance, nPoints) && allOK;
+          allOK = Compare("CELr", celRadial,    BDS::CELRadialTable(tolerance), tolerance, nPoints) && allOK;
+        }
+      return allOK;
+    });
+}
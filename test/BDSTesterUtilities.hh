@@ -0,0 +1,67 @@
+/*
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway,
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSTESTERUTILITIES_H
+#define BDSTESTERUTILITIES_H
+
+#include "BDSException.hh"
+
+#include "globals.hh"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Common parts of the testers that compare a faster implementation against a
+ * reference one for speed and accuracy.
+ *
+ * @author Laurie Nevay
+ */
+
+namespace BDSTester
+{
+  /// Time a function that processes nItems items and return the time per item in ns.
+  inline G4double NanosecondsPerItem(const std::function<void()>& function,
+                                     G4double nItems)
+  {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<G4double, std::nano>(end - start).count() / nItems;
+  }
+
+  /// Suffix for a line of results.
+  inline std::string Result(G4bool ok) {return ok ? "" : " <- FAILED";}
+
+  /// Run all the comparisons and return the exit code for the tester. A BDSException
+  /// is printed and counts as a failure.
+  inline int Run(const std::function<G4bool()>& comparisons)
+  {
+    try
+      {return comparisons() ? 0 : 1;}
+    catch (const BDSException& e)
+      {
+        std::cerr << e.what() << std::endl;
+        return 1;
+      }
+  }
+}
+
+#endif